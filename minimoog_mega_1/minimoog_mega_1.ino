@@ -91,8 +91,8 @@
 // includes
 #include "MIDI.h"			// https://github.com/FortySevenEffects/arduino_midi_library
 #include "PushButton.h"		// https://github.com/troisiemetype/PushButton
-#include "ExpFilter.h"		// https://github.com/troisiemetype/expfilter
 #include "defs.h"
+#include "adc_scan.h"
 
 // Constants
 const uint8_t NUM_KEYS = 30;
@@ -101,8 +101,34 @@ const uint8_t NUM_KEYS = 30;
 const uint8_t NUM_SWITCHES = 15;
 const uint8_t NUM_POTS = 16;
 const uint8_t NUM_SELECTORS = 6;
-
-const uint8_t POT_FILTER_COEF = 20;
+const uint8_t NUM_MIX = 5;
+
+// Inputs that are not plain control changes, in the pots and switches tables below.
+const uint8_t POT_PITCH_BEND = 3;
+const uint8_t POT_MOD_WHEEL = 4;
+const uint8_t POT_FIRST_SELECTOR = 5;
+const uint8_t POT_FIRST_MIX = 11;
+const uint8_t SWITCH_FIRST_MIX = 6;
+const uint8_t SWITCH_TRANSPOSE_UP = 13;
+const uint8_t SWITCH_TRANSPOSE_DOWN = 14;
+// Pitch bend is not a control change.
+const uint8_t CC_NONE = 0xFF;
+
+// A pot is sent again only when it moves more than this, or when it reaches one end.
+const uint8_t POT_HYSTERESIS = 2;
+// Pot state that is never read, for sending a pot anyway.
+const uint16_t POT_UNKNOWN = 0xFFFF;
+const uint8_t SELECTOR_UNKNOWN = 0xFF;
+// Selectors have six positions on the ADC range.
+const uint16_t SELECTOR_STEP = ADC_MAX / 6 + 1;
+// Pitch bend wheel is sent as neutral around its rest position, as it doesn't come back exactly to it.
+const int16_t PITCH_BEND_DEAD_ZONE = 64;
+// The wheels use a standard 270° potentiometer, but their course is around 90°. This is their course on the ADC
+// range (12 bits), used until they are calibrated.
+const uint16_t PITCH_BEND_LOWER = 1372;
+const uint16_t PITCH_BEND_UPPER = 2604;
+const uint16_t MOD_WHEEL_LOWER = 1440;
+const uint16_t MOD_WHEEL_UPPER = 2640;
 
 // Digital pin definition
 const uint8_t KEYS[NUM_KEYS] = {
@@ -161,7 +187,21 @@ const uint8_t APIN_MIX_EXT = A15;
 
 // Every pin is defined through tables grouped by category. Pots, switches, keys (above).
 // The main and setup loop can thus iterate the table to update every reanding easily.
-const uint8_t APIN[NUM_POTS] = {A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15};
+// Pots are read by the ADC scan, in the order of analog inputs, from A0 to A15.
+
+// Control changes sent by each pot and switch, in the order of their inputs.
+// Readings, state dump and mixer all use them, so they can't drift apart.
+const uint8_t POT_CC[NUM_POTS] = {
+	CC_LFO_RATE, CC_MODULATION_MIX, CC_PORTAMENTO_TIME, CC_NONE, CC_MOD_WHEEL,
+	CC_OSC1_RANGE, CC_OSC2_RANGE, CC_OSC3_RANGE,
+	CC_OSC1_WAVEFORM, CC_OSC2_WAVEFORM, CC_OSC3_WAVEFORM,
+	CC_OSC1_MIX, CC_OSC2_MIX, CC_OSC3_MIX, CC_NOISE_MIX, CC_FEEDBACK_MIX
+};
+const uint8_t SWITCH_CC[NUM_SWITCHES] = {
+	CC_MOD_MIX_1, CC_MOD_MIX_2, CC_OSC_MOD, CC_PORTAMENTO_ON_OFF, CC_LFO_SHAPE, CC_OSC3_CTRL,
+	CC_OSC1_MIX, CC_OSC2_MIX, CC_OSC3_MIX, CC_NOISE_MIX, CC_FEEDBACK_MIX,
+	CC_NOISE_COLOR, CC_FUNCTION, CC_TRANSPOSE, CC_TRANSPOSE
+};
 
 // Vars
 // storing the last reading
@@ -172,8 +212,6 @@ const uint8_t PIN[NUM_SWITCHES] = {3, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 17, 14, 1
 
 // Deboucing is handled by the push button library, as well as key initialisation and reading.
 PushButton switches[NUM_SWITCHES];
-// ExpFilter "debounces" ADC readings, filter noise. The readings only change when the users efectively moves a pot.
-ExpFilter pots[NUM_POTS];
 // 
 uint8_t selectors[NUM_SELECTORS];
 
@@ -181,11 +219,10 @@ uint8_t selectors[NUM_SELECTORS];
 bool keyState[NUM_KEYS];
 
 // Mixer
-// Mixer stores the values from potentiometers and switches, because switch turn channel on / off.
+// Mixer stores the values from potentiometers, because switches turn channels on / off.
 // Depending of the switch position, the value from the potentiometer is to be sent or not,
 // and when turned on the potentiometer value has to be sent again.
-uint16_t mix[5];
-bool mixSw[5];
+uint16_t mix[NUM_MIX];
 
 // Misc
 uint8_t defaultVelocity = 64;
@@ -193,11 +230,24 @@ uint8_t defaultVelocity = 64;
 // update flag for data request from Teensy.
 bool update = 0;
 
+// Pots are not sent until they have all been read once : the Teensy asks for the panel state when it starts.
+// They are all read about 25 times per second, the wheels about 350 times.
+bool potsReady = 0;
+uint8_t potsRead = 0;
+// Pitch bend wheel reading at rest, not calibrated. The wheel springs back to it, so it's taken from its first reading.
+uint16_t pitchBendRest = POT_UNKNOWN;
+
+// Panel state known by the Teensy, from its last request, and flag for answering it.
+uint8_t teensyState[128];
+bool dumpRequested = 0;
+
 // Internal communication between the three boards ca be faster then MIDI standard. They handle it well.
 // They could probably handle a baudrate of 250000 or 500000.
 struct midiSettings : public midi::DefaultSettings{
 //	static const bool UseRunningStatus = true;
 	static const long BaudRate = 115200;
+	// The panel state frames are a bit longer than the default.
+	static const unsigned SysExMaxSize = 300;
 };
 
 // The one we use on synth
@@ -223,40 +273,23 @@ void setup(){
 	}
 
 	// potentiometers initialisation
+	// The ADC scan oversamples the readings, the hysteresis in updateControls() filters what is left of noise.
 	for (uint8_t i = 0; i < NUM_POTS; ++i){
-		pots[i].begin(analogRead(APIN[i]));
-		pots[i].setCoef(POT_FILTER_COEF);
+		potState[i] = POT_UNKNOWN;
 	}
-/*
-	// Run init sequence to debounce switches and filter pots, so it's running on stable values.
-	uint32_t initEnd = millis() + 500;
-
-	while(initEnd > millis()){
-
-		for(uint8_t i = 0; i < NUM_KEYS; ++i){
-			keys[i].update();
-		}
-
-		for(uint8_t i = 0; i < NUM_SWITCHES; ++i){
-			switches[i].update();
-		}
-
-// This causes the most inexplicable bug I've ever seen.
-// When the switches (above) are depressed in the main loop, the board reboots.
-// Probably something like a segmentation error, I suspect the board is partially HS.
-// For now it will stay the same...
-/*
-		uint16_t value = 0;
-		for(uint8_t i = 0; i < NUM_POTS; ++i){
-			uint16_t temp = 0;
-			value = analogRead(APIN[i]);
-			temp = pots[i].filter(value);
-			potState[i] = temp;
-		}
-
+	for (uint8_t i = 0; i < NUM_SELECTORS; ++i){
+		selectors[i] = SELECTOR_UNKNOWN;
 	}
-*/
+	adcScanBegin();
+	adcDefaultRange(POT_PITCH_BEND, PITCH_BEND_LOWER, PITCH_BEND_UPPER);
+	adcDefaultRange(POT_MOD_WHEEL, MOD_WHEEL_LOWER, MOD_WHEEL_UPPER);
+	// The wheels are played : they are read more often, so the bend doesn't step.
+	adcFastChannels(_BV(POT_PITCH_BEND) | _BV(POT_MOD_WHEEL));
+
+	// There is no init sequence : pots are scanned in the background, and the Teensy asks for what it needs
+	// with a state request, answered when every pot has been read.
 	midi1.setHandleControlChange(handleControlChange);
+	midi1.setHandleSystemExclusive(handleSysEx);
 	midi1.begin(1);
 	midi1.turnThruOff();
 }
@@ -268,6 +301,7 @@ void loop(){
 	updateSwitches();
 	updateControls();
 	update = 0;
+	if(dumpRequested && potsReady) sendStateDump();
 /*
 	Serial.println("keys");
 	for(uint8_t i = 22; i < (22 + NUM_KEYS); ++i){
@@ -277,7 +311,7 @@ void loop(){
 	Serial.println();
 	Serial.println("pots");
 	for(uint8_t i = 0; i < NUM_POTS; ++i){
-		Serial.print(analogRead(APIN[i]));
+		Serial.print(potState[i]);
 		Serial.print('\t');
 	}
 	Serial.println();
@@ -324,14 +358,42 @@ void sendLongControlChange(uint8_t controlChange, uint16_t value, uint8_t channe
  * When potentiometer is moved but switch is OFF, current value is localy stored but not sent.
  */
 void updateMix(uint8_t ch, bool fromSw = 0){
+	if(!potsReady) return;
 	uint16_t value = 0;
-	if(mixSw[ch]){
+	if(mixOn(ch)){
 		value = mix[ch];
 	}
-	if(value || fromSw) sendLongControlChange(CC_OSC1_MIX + ch, value, 1);
+	if(value || fromSw) sendLongControlChange(POT_CC[POT_FIRST_MIX + ch], value, 1);
 
 }
 
+// Mixer switches are read from their debounced state, there is no copy to keep up to date.
+bool mixOn(uint8_t ch){
+	return switches[SWITCH_FIRST_MIX + ch].isPressed();
+}
+
+bool isMixSwitch(uint8_t i){
+	return (i >= SWITCH_FIRST_MIX) && (i < (SWITCH_FIRST_MIX + NUM_MIX));
+}
+
+bool isSelector(uint8_t i){
+	return (i >= POT_FIRST_SELECTOR) && (i < (POT_FIRST_SELECTOR + NUM_SELECTORS));
+}
+
+bool isMixPot(uint8_t i){
+	return (i >= POT_FIRST_MIX) && (i < (POT_FIRST_MIX + NUM_MIX));
+}
+
+// Rotary selectors : value must be divided by SELECTOR_STEP.
+// Selectors use resistor array, as explained at the begining of this file.
+// the divisions "re-maps" the 12-bits range of the ADC to the 0-6 range we need.
+// Range selectors (the first three) are wired the other way round.
+uint8_t selectorPosition(uint8_t selector, uint16_t value){
+	value /= SELECTOR_STEP;
+	if(selector < 3) value = 5 - value;
+	return value;
+}
+
 void updateKeys(){
 	// reading keys
 	for(uint8_t i = 0; i < NUM_KEYS; ++i){
@@ -366,214 +428,94 @@ void updateSwitches(){
 			continue;
 		}
 
-		int8_t controlChange = -1;
-
-		switch(i){
-			case 0:
-			// pin 2
-				controlChange = CC_MOD_MIX_1;
-				break;
-			case 1:
-			// pin 3
-				controlChange = CC_MOD_MIX_2;
-				break;
-			case 2:
-			// pin 4
-				controlChange = CC_OSC_MOD;
-				break;
-			case 3:
-			// pin 5
-				controlChange = CC_PORTAMENTO_ON_OFF;
-				break;
-			case 4:
-			// pin 6
-				controlChange = CC_LFO_SHAPE;
-				break;
-			case 5:
-			// pin 7
-				controlChange = CC_OSC3_CTRL;
-				break;
-			case 6:
-			// pin 8
+		if(isMixSwitch(i)){
 			// Mixer switches are handled by a dedicate function with pots.
-				mixSw[0] = (bool)change;
-				updateMix(0, 1);
-				continue;
-			case 7:
-			// pin 9
-				mixSw[1] = (bool)change;
-				updateMix(1, 1);
-				continue;
-			case 8:
-			// pin 10
-				mixSw[2] = (bool)change;
-				updateMix(2, 1);
-				continue;
-			case 9:
-			// pin 11
-				mixSw[3] = (bool)change;
-				updateMix(3, 1);
-				continue;
-			case 10:
-			// pin 12
-				mixSw[4] = (bool)change;
-				updateMix(4, 1);
-				continue;
-			case 11:
-			// pin 13
-				controlChange = CC_NOISE_COLOR;
-				break;
-			case 12:
-			// pin 14
-				controlChange = CC_FUNCTION;
-				break;
-			case 13:
-			// pin 15
-				controlChange = CC_TRANSPOSE;
-				if(change == 0) continue;
-				change = 127;
-				break;
-			case 14:
-			// pin 16
-				controlChange = CC_TRANSPOSE;
-				if(change == 127) continue;
-				change = 0;
-				break;
-			default:
-				continue;			
+			updateMix(i - SWITCH_FIRST_MIX, 1);
+			continue;
+		}
+
+		// Transpose switches share the same control change : 127 for octave +, 0 for octave -.
+		if(i == SWITCH_TRANSPOSE_UP){
+			if(change == 0) continue;
+			change = 127;
+		} else if(i == SWITCH_TRANSPOSE_DOWN){
+			if(change == 127) continue;
+			change = 0;
 		}
 
+		uint8_t controlChange = SWITCH_CC[i];
+
 		midi1.sendControlChange(controlChange, change, 1);
 	}
 }
 
+// Tell if a pot has moved enough from its last sent value.
+bool potMoved(uint8_t pot, uint16_t value){
+	if(potState[pot] == POT_UNKNOWN) return 1;
+	if(value == potState[pot]) return 0;
+	if((value == 0) || (value == ADC_MAX)) return 1;
+	return abs((int16_t)value - (int16_t)potState[pot]) > POT_HYSTERESIS;
+}
+
+// Pitch bend from the calibrated wheel value. Each side of the rest position is spread on its half of the MIDI range,
+// as the rest position is seldom the middle of the course.
+int16_t pitchBend(uint16_t value){
+	uint16_t rest = adcCalibrate(POT_PITCH_BEND, pitchBendRest);
+	// The wheel was held at power up : the middle of the course is used instead.
+	if((rest < ADC_MAX / 4) || (rest > ADC_MAX - ADC_MAX / 4)) rest = ADC_MAX / 2;
+
+	int32_t bend;
+	if(value >= rest){
+		bend = ((int32_t)(value - rest) * 8191) / (ADC_MAX - rest);
+	} else {
+		bend = -((int32_t)(rest - value) * 8192) / rest;
+	}
+	if(abs(bend) < PITCH_BEND_DEAD_ZONE) bend = 0;
+	return bend;
+}
+
+// Read the values from the ADC scan, as long as there are some.
+// Values are 12 bits. Pots are calibrated, rotary selectors are not : they always cover the whole ADC range.
 void updateControls(){
-	for(uint8_t i = 0; i < NUM_POTS; ++i){
-		uint16_t value = 0;
+	adcReading_t reading;
+	while(adcScanRead(&reading)){
+		uint8_t i = reading.channel;
+		uint16_t value = reading.value;
 
-		value = pots[i].filter(analogRead(APIN[i]));
-		if((value != potState[i]) || update){
-			potState[i] = value;
-		} else {
+		// Pots are not sent until they have all been read once. Their state is still kept.
+		if(!potsReady && (potsRead >= NUM_POTS)) potsReady = 1;
+		if(!potsReady && (potState[i] == POT_UNKNOWN)) ++potsRead;
+		if((i == POT_PITCH_BEND) && (pitchBendRest == POT_UNKNOWN)) pitchBendRest = value;
+
+		// Rotary selectors are not calibrated.
+		if(!isSelector(i)) value = adcCalibrate(i, value);
+
+		if(!potMoved(i, value)){
 			// If not change, skip midi update
-			continue;				
+			continue;
 		}
+		potState[i] = value;
 
-		int8_t controlChange = -1;
-
-		switch(i){
-			case 0:
-				controlChange = CC_LFO_RATE;
-				break;
-			case 1:
-				controlChange = CC_MODULATION_MIX;
-				break;
-			case 2:
-				controlChange = CC_PORTAMENTO_TIME;
-				break;
-			case 3:
-//				int16_t val = remap(value, 360, 660, -8190, 8190);
-				midi1.sendPitchBend((int16_t)value, 1);
-				continue;
-			case 4:
-				// Mod wheel uses a standard 270° potentiometer, but its course is around 90°.
-				// The input value is then remaped to the standard MIDI 14-bits range.
-				controlChange = CC_MOD_WHEEL;
-				value = remap(value, 360, 660, 0, 16384);
-//				value = map(value, 360, 660, 0, 16384);
-//				value = constrain(value, 0, 16384);				
-				break;
-			case 5:
-				// rotary selector : value must be divided by ~170
-				// Selectors use resistor array, as explained at the begining of this file. 
-				// the divisions "re-maps" the 10-bits range of the ADC to the 0-6 range we need.
-				controlChange = CC_OSC1_RANGE;
-				value /= 170;
-				value = 5 - value;
-				// We have to check if the value after dividing is different from the previous one !
-				// Otherwise each selector change will send dozens of useless update !
-				if(value == selectors[0]){
-					continue;
-				} else {
-					selectors[0] = value;
-				}
-				break;
-			case 6:
-				controlChange = CC_OSC2_RANGE;
-				value /= 170;
-				value = 5 - value;
-				if(value == selectors[1]){
-					continue;
-				} else {
-					selectors[1] = value;
-				}
-				break;
-			case 7:
-				controlChange = CC_OSC3_RANGE;
-				value /= 170;
-				value = 5 - value;
-				if(value == selectors[2]){
-					continue;
-				} else {
-					selectors[2] = value;
-				}
-				break;
-			case 8:
-				controlChange = CC_OSC1_WAVEFORM;
-				value /= 170;
-				if(value == selectors[3]){
-					continue;
-				} else {
-					selectors[3] = value;
-				}
-				break;
-			case 9:
-				controlChange = CC_OSC2_WAVEFORM;
-				value /= 170;
-				if(value == selectors[4]){
-					continue;
-				} else {
-					selectors[4] = value;
-				}
-				break;
-			case 10:
-				controlChange = CC_OSC3_WAVEFORM;
-				value /= 170;
-				if(value == selectors[5]){
-					continue;
-				} else {
-					selectors[5] = value;
-				}
-				break;
-			case 11:
-				// mix is to be sent only if switch is on, and is handled by a dedicated function (see above).
-//				controlChange = CC_OSC1_MIX;
-				mix[0] = value;
-				updateMix(0);
-				continue;
-			case 12:
-//				controlChange = CC_OSC2_MIX;
-				mix[1] = value;
-				updateMix(1);
-				continue;
-			case 13:
-//				controlChange = CC_OSC3_MIX;
-				mix[2] = value;
-				updateMix(2);
-				continue;
-			case 14:
-//				controlChange = CC_NOISE_MIX;
-				mix[3] = value;
-				updateMix(3);
-				continue;
-			case 15:
-//				controlChange = CC_FEEDBACK_MIX;
-				mix[4] = value;
-				updateMix(4);
-				continue;
-			default:
-				continue;
+		uint8_t controlChange = POT_CC[i];
+
+		if(i == POT_PITCH_BEND){
+			// Calibration gives the wheel the full range, which is then sent as a standard MIDI pitch bend.
+			if(potsReady) midi1.sendPitchBend(pitchBend(value), 1);
+			continue;
+		} else if(isSelector(i)){
+			uint8_t selector = i - POT_FIRST_SELECTOR;
+			value = selectorPosition(selector, value);
+			// We have to check if the value after dividing is different from the previous one !
+			// Otherwise each selector change will send dozens of useless update !
+			if(value == selectors[selector]) continue;
+			selectors[selector] = value;
+		} else if(isMixPot(i)){
+			// mix is to be sent only if switch is on, and is handled by a dedicated function (see above).
+			mix[i - POT_FIRST_MIX] = value;
+			updateMix(i - POT_FIRST_MIX);
+			continue;
 		}
+		if(!potsReady) continue;
 
 		// See comment about 14-bits control change at the sendLongControlChange() function.
 		if( controlChange < 32){
@@ -584,12 +526,89 @@ void updateControls(){
 	}
 }
 
-// Handle requests from Teensy. For now, the only one needed is a global update.
+// Add a control to the state dump frame, if it differs from what the Teensy knows.
+// 14-bits values are sent as two control changes : if one byte differs, both are sent.
+void appendState(uint8_t *frame, uint16_t *length, uint8_t controlChange, uint16_t value){
+	if(controlChange < 32){
+		uint8_t valueHigh = value >> 7;
+		uint8_t valueLow = value & 0x7F;
+		if((teensyState[controlChange] == valueHigh) && (teensyState[controlChange + 32] == valueLow)) return;
+		frame[(*length)++] = controlChange;
+		frame[(*length)++] = valueHigh;
+		frame[(*length)++] = controlChange + 32;
+		frame[(*length)++] = valueLow;
+	} else {
+		if(teensyState[controlChange] == value) return;
+		frame[(*length)++] = controlChange;
+		frame[(*length)++] = value;
+	}
+}
+
+// Answer the Teensy's state request with the controls that differ from what it knows.
+// Keys, pitch bend, function and transpose are not a state of the panel.
+void sendStateDump(){
+	// 4 long pots, 5 long mixers, 6 selectors, 7 switches.
+	uint8_t frame[2 + 4 * 9 + 2 * 13];
+	uint16_t length = 0;
+	frame[length++] = SYSEX_ID;
+	frame[length++] = SYSEX_STATE_DUMP;
+
+	for(uint8_t i = 0; i < NUM_POTS; ++i){
+		if(i == POT_PITCH_BEND) continue;
+		uint16_t value = potState[i];
+		if(isSelector(i)){
+			value = selectors[i - POT_FIRST_SELECTOR];
+		} else if(isMixPot(i)){
+			value = mixOn(i - POT_FIRST_MIX) ? mix[i - POT_FIRST_MIX] : 0;
+		}
+		appendState(frame, &length, POT_CC[i], value);
+	}
+
+	// Mixer switches are part of the mixer values above.
+	for(uint8_t i = 0; i < NUM_SWITCHES; ++i){
+		if(isMixSwitch(i) || (SWITCH_CC[i] == CC_FUNCTION) || (SWITCH_CC[i] == CC_TRANSPOSE)) continue;
+		appendState(frame, &length, SWITCH_CC[i], switches[i].isPressed() ? 127 : 0);
+	}
+
+	midi1.sendSysEx(length, frame);
+	dumpRequested = 0;
+}
+
+// State request from the Teensy. The frame given by the MIDI library has its start and end bytes.
+void handleSysEx(uint8_t *frame, unsigned size){
+	if((size < 3) || (frame[1] != SYSEX_ID) || (frame[2] != SYSEX_STATE_REQUEST)) return;
+
+	// Controls not in the request are unknown to the Teensy, they have a value that is never sent.
+	for(uint8_t i = 0; i < 128; ++i){
+		teensyState[i] = 0xFF;
+	}
+	for(unsigned i = 3; (i + 1) < size; i += 2){
+		if(frame[i] & 0x80) break;
+		teensyState[frame[i]] = frame[i + 1];
+	}
+	dumpRequested = 1;
+}
+
+// Handle requests from Teensy : global update, and pots calibration.
 // Maybe it could be usefull to use the data byte to specify which kind of controls are to be updated.
 void handleControlChange(uint8_t channel, uint8_t command, uint8_t value){
 	switch(command){
 		case CC_ASK_FOR_DATA:
 			update = 1;
+			// Pots are read in the background : they are all sent on their next reading.
+			for(uint8_t i = 0; i < NUM_POTS; ++i){
+				potState[i] = POT_UNKNOWN;
+			}
+			for(uint8_t i = 0; i < NUM_SELECTORS; ++i){
+				selectors[i] = SELECTOR_UNKNOWN;
+			}
+			break;
+		case CC_CALIBRATE:
+			if(value > 63){
+				adcCalibrationStart();
+			} else {
+				adcCalibrationStore();
+			}
 			break;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,206 @@
+// Minimoog - mega 2
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <EEPROM.h>
+
+#include "adc_scan.h"
+
+// Calibration is stored after an ID, the same way as the Teensy stores its settings.
+// The ID should be changed whenever the mapping changes.
+const uint16_t EE_CALIBRATION_ID_ADD = 0;
+const uint16_t EE_CALIBRATION_ADD = 4;
+const uint8_t CALIBRATION_ID = 0;
+
+// Ring buffer. The interrupt writes the head, the main loop reads the tail.
+// Both are one byte long, so they are read and written at once.
+volatile adcReading_t adcBuffer[ADC_BUFFER_SIZE];
+volatile uint8_t adcHead = 0;
+volatile uint8_t adcTail = 0;
+
+// Scan state, only used by the interrupt. adcChannel is the channel read, adcScanned the last one of the scan,
+// and adcFastNext the next fast channel to try.
+uint8_t adcChannel = 0;
+uint8_t adcScanned = 0;
+uint8_t adcFastNext = 0;
+volatile uint16_t adcFast = 0;
+uint8_t adcCount = 0;
+uint16_t adcSum = 0;
+bool adcSettle = 1;
+
+// Calibration
+uint16_t adcMin[ADC_NUM_CHANNELS];
+uint16_t adcMax[ADC_NUM_CHANNELS];
+uint16_t adcDefaultMin[ADC_NUM_CHANNELS];
+uint16_t adcDefaultMax[ADC_NUM_CHANNELS];
+bool adcCalibrated = 0;
+bool adcCalibrating = 0;
+
+// Select the input. Channels 8 to 15 need the MUX5 bit, which is in another register.
+static void adcSelect(uint8_t channel){
+	ADMUX = _BV(REFS0) | (channel & 0x07);
+	if(channel & 0x08){
+		ADCSRB |= _BV(MUX5);
+	} else {
+		ADCSRB &= ~_BV(MUX5);
+	}
+}
+
+// Next channel to read : the fast channels in turn, then the next channel of the scan.
+static uint8_t adcNext(){
+	while(adcFastNext < ADC_NUM_CHANNELS){
+		uint8_t channel = adcFastNext++;
+		if(adcFast & (1U << channel)) return channel;
+	}
+	adcFastNext = 0;
+	do{
+		if(++adcScanned >= ADC_NUM_CHANNELS) adcScanned = 0;
+	} while(adcFast & (1U << adcScanned));
+	return adcScanned;
+}
+
+ISR(ADC_vect){
+	uint16_t value = ADC;
+
+	if(adcSettle){
+		adcSettle = 0;
+	} else {
+		adcSum += value;
+		bool fast = adcFast & (1U << adcChannel);
+		if(++adcCount >= (fast ? ADC_FAST_OVERSAMPLING : ADC_OVERSAMPLING)){
+			uint8_t next = (adcHead + 1) & (ADC_BUFFER_SIZE - 1);
+			// If the buffer is full the reading is lost. There will be a new one on the next pass.
+			if(next != adcTail){
+				adcBuffer[adcHead].channel = adcChannel;
+				adcBuffer[adcHead].value = fast ? adcSum * (ADC_OVERSAMPLING / ADC_FAST_OVERSAMPLING) : adcSum;
+				adcHead = next;
+			}
+
+			adcSum = 0;
+			adcCount = 0;
+			adcSettle = 1;
+			adcChannel = adcNext();
+			adcSelect(adcChannel);
+		}
+	}
+
+	// Start next conversion
+	ADCSRA |= _BV(ADSC);
+}
+
+void adcScanBegin(){
+	for(uint8_t i = 0; i < ADC_NUM_CHANNELS; ++i){
+		adcDefaultMin[i] = 0;
+		adcDefaultMax[i] = ADC_MAX;
+	}
+
+	adcCalibrated = (EEPROM.read(EE_CALIBRATION_ID_ADD) == 'c') && (EEPROM.read(EE_CALIBRATION_ID_ADD + 1) == CALIBRATION_ID);
+	if(adcCalibrated){
+		EEPROM.get(EE_CALIBRATION_ADD, adcMin);
+		EEPROM.get(EE_CALIBRATION_ADD + sizeof(adcMin), adcMax);
+	} else {
+		for(uint8_t i = 0; i < ADC_NUM_CHANNELS; ++i){
+			adcMin[i] = adcDefaultMin[i];
+			adcMax[i] = adcDefaultMax[i];
+		}
+	}
+
+	adcChannel = 0;
+	adcScanned = 0;
+	adcFastNext = 0;
+	adcCount = 0;
+	adcSum = 0;
+	adcSettle = 1;
+	adcSelect(adcChannel);
+
+	// ADC on, interrupt on, prescaler 128 : 125kHz ADC clock, about 9600 conversions per second.
+	// The ADC needs a clock under 200kHz for its full 10 bits accuracy, that the oversampling relies on.
+	// With 16 conversions and one for settling per input, it gives around 35 values per second for each input.
+	// With two fast channels, each read with 4 conversions and one for settling after every other channel, they
+	// get around 350 values per second, every 2.8ms, and the others around 25.
+	ADCSRA = _BV(ADEN) | _BV(ADIE) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+	ADCSRA |= _BV(ADSC);
+}
+
+void adcFastChannels(uint16_t channels){
+	// The scan must have a channel to go to.
+	if(channels == 0xFFFF) channels = 0;
+	adcFast = channels;
+}
+
+void adcDefaultRange(uint8_t channel, uint16_t lower, uint16_t upper){
+	adcDefaultMin[channel] = lower;
+	adcDefaultMax[channel] = upper;
+	if(!adcCalibrated){
+		adcMin[channel] = lower;
+		adcMax[channel] = upper;
+	}
+}
+
+bool adcScanRead(adcReading_t *reading){
+	if(adcTail == adcHead) return 0;
+
+	reading->channel = adcBuffer[adcTail].channel;
+	// Decimation : 14 bits sum to 12 bits value.
+	reading->value = adcBuffer[adcTail].value >> 2;
+	adcTail = (adcTail + 1) & (ADC_BUFFER_SIZE - 1);
+
+	if(adcCalibrating){
+		if(reading->value < adcMin[reading->channel]) adcMin[reading->channel] = reading->value;
+		if(reading->value > adcMax[reading->channel]) adcMax[reading->channel] = reading->value;
+	}
+
+	return 1;
+}
+
+uint16_t adcCalibrate(uint8_t channel, uint16_t value){
+	uint16_t lower = adcMin[channel];
+	uint16_t upper = adcMax[channel];
+	if(upper <= lower) return value;
+	if(value <= lower) return 0;
+	if(value >= upper) return ADC_MAX;
+	return ((uint32_t)(value - lower) * ADC_MAX) / (upper - lower);
+}
+
+void adcCalibrationStart(){
+	// Min and max are set upside down, so the first readings set them.
+	for(uint8_t i = 0; i < ADC_NUM_CHANNELS; ++i){
+		adcMin[i] = ADC_MAX;
+		adcMax[i] = 0;
+	}
+	adcCalibrating = 1;
+}
+
+void adcCalibrationStore(){
+	if(!adcCalibrating) return;
+	adcCalibrating = 0;
+
+	// An input that has not moved keeps its default range.
+	for(uint8_t i = 0; i < ADC_NUM_CHANNELS; ++i){
+		if(adcMax[i] <= adcMin[i]){
+			adcMin[i] = adcDefaultMin[i];
+			adcMax[i] = adcDefaultMax[i];
+		}
+	}
+	adcCalibrated = 1;
+
+	EEPROM.update(EE_CALIBRATION_ID_ADD, 'c');
+	EEPROM.update(EE_CALIBRATION_ID_ADD + 1, CALIBRATION_ID);
+	EEPROM.put(EE_CALIBRATION_ADD, adcMin);
+	EEPROM.put(EE_CALIBRATION_ADD + sizeof(adcMin), adcMax);
+}
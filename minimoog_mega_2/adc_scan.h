@@ -0,0 +1,81 @@
+// Minimoog - mega 2
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Background scan of the 16 analog inputs of the Mega.
+ *
+ * The ADC runs on its own, from its conversion complete interrupt : each channel is read
+ * ADC_OVERSAMPLING times in a row, then the scan moves to the next channel.
+ * The first conversion after a channel change is thrown away, to let the input settle.
+ * Fast channels, set by adcFastChannels(), are read after every other channel, with ADC_FAST_OVERSAMPLING readings :
+ * they are updated about ten times as often, for inputs that are played rather than set, like the wheels.
+ * The sum of the readings (14 bits) is pushed in a ring buffer, and the main loop reads it when it has time.
+ * It is never waiting for the converter.
+ *
+ * Decimating the sum gives 12 bits values. The pot noise is enough to dither the readings.
+ *
+ * Calibration : pots never reach both ends of the ADC range, so each input has a min and a max stored in EEPROM.
+ * When calibration is running, every value read extends the min and max of its input. Moving all pots through
+ * their whole course, then storing, gives them the full 12 bits range.
+ * Without calibration, an input covers the whole ADC range, or the range set by adcDefaultRange() when its course
+ * is known.
+ */
+
+#ifndef ADC_SCAN_H
+#define ADC_SCAN_H
+
+#include <Arduino.h>
+
+const uint8_t ADC_NUM_CHANNELS = 16;
+// Readings added for each value. 16 readings of 10 bits give 2 more bits.
+const uint8_t ADC_OVERSAMPLING = 16;
+// Readings added for a fast channel. Their sum is scaled to the one of the other channels.
+const uint8_t ADC_FAST_OVERSAMPLING = 4;
+const uint8_t ADC_BITS = 12;
+const uint16_t ADC_MAX = (1 << ADC_BITS) - 1;
+
+// Must be a power of 2.
+const uint8_t ADC_BUFFER_SIZE = 32;
+
+struct adcReading_t{
+	uint8_t channel;
+	uint16_t value;
+};
+
+// Start the scan. Calibration is loaded from EEPROM.
+void adcScanBegin();
+
+// Range of an input when it's not calibrated, or when it didn't move while calibrating. Values are 12 bits.
+// Call after adcScanBegin().
+void adcDefaultRange(uint8_t channel, uint16_t lower, uint16_t upper);
+
+// Channels read after every other channel, one bit per channel. At least one channel must be left out.
+void adcFastChannels(uint16_t channels);
+
+// Get the next value from the ring buffer. Returns false if there is none.
+// The value is on 12 bits, not calibrated.
+bool adcScanRead(adcReading_t *reading);
+
+// Apply the stored calibration to a value from a channel. Result is from 0 to ADC_MAX.
+uint16_t adcCalibrate(uint8_t channel, uint16_t value);
+
+// Calibration is running from start until stored.
+void adcCalibrationStart();
+void adcCalibrationStore();
+
+#endif
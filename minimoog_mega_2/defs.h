@@ -219,36 +219,36 @@
 #define CC_LFO_RATE_LSB					CC63
 // #define CC_DAMPER_PEDAL_ON_OFF 			CC64
 #define CC_PORTAMENTO_ON_OFF 			CC65
-// #define CC_SOSTENUTO_ON_OFF 			CC66
-// #define CC_SOFT_PEDAL_ON_OFF 			CC67
+#define CC_SEQUENCER_CLOCK				CC66
+#define CC_SEQUENCER_OCTAVES			CC67
 // #define CC_LEGATO_PEDAL 				CC68
 // #define CC_HOLD_2 						CC69
-// #define CC_SOUND_CTRL_1 				CC70
-// #define CC_SOUND_CTRL_2 				CC71
-// #define CC_SOUND_CTRL_3 				CC72
-// #define CC_SOUND_CTRL_4 				CC73
-// #define CC_SOUND_CTRL_5 				CC74
-// #define CC_SOUND_CTRL_6 				CC75
-// #define CC_SOUND_CTRL_7 				CC76
-// #define CC_SOUND_CTRL_8 				CC77
-// #define CC_SOUND_CTRL_9 				CC78
-// #define CC_SOUND_CTRL_10 				CC79
-// #define CC_GEN_PURPOSE_CTRL_5 			CC80
-// #define CC_GEN_PURPOSE_CTRL_6 			CC81
-// #define CC_GEN_PURPOSE_CTRL_7 			CC82
-// #define CC_GEN_PURPOSE_CTRL_8 			CC83
-// #define CC_PORTAMENTO_CTRL 				CC84
-// #define CC_ 								CC85
-// #define CC_ 								CC86
-// #define CC_ 								CC87
-// #define CC_ 								CC88
-// #define CC_ 								CC89
+#define CC_WAVETABLE_MORPH				CC70
+#define CC_OSC2_SYNC					CC71
+#define CC_OSC3_SYNC					CC72
+#define CC_OSC_FM_AMOUNT				CC73
+#define CC_OSC1_PAN						CC74
+#define CC_OSC2_PAN						CC75
+#define CC_OSC3_PAN						CC76
+#define CC_NOISE_PAN					CC77
+#define CC_FX_PAN						CC78
+#define CC_STEREO_FILTER_OFFSET			CC79
+#define CC_CALIBRATE					CC80
+#define CC_STEREO_ENVELOPE_OFFSET		CC81
+#define CC_SEQUENCER_TEMPO				CC82
+#define CC_SEQUENCER_GATE				CC83
+#define CC_SEQUENCER_DIVISION			CC84
+#define CC_FX_DELAY_TIME					CC85
+#define CC_FX_DELAY_FEEDBACK				CC86
+#define CC_FX_CHORUS_RATE					CC87
+#define CC_FX_CHORUS_DEPTH					CC88
+#define CC_FX_REVERB_SIZE					CC89
 #define CC_ASK_FOR_DATA						CC90
 #define CC_BITCRUSH_OUT 					CC91
-// #define CC_EFFECT_2_DEPTH 				CC92
-// #define CC_EFFECT_3_DEPTH 				CC93
-// #define CC_EFFECT_4_DEPTH 				CC94
-// #define CC_EFFECT_5_DEPTH 				CC95
+#define CC_FX_DELAY_MIX 					CC92
+#define CC_FX_CHORUS_MIX 					CC93
+#define CC_FX_REVERB_MIX 					CC94
+#define CC_FX_ON_OFF 						CC95
 // #define CC_DATA_INC 					CC96
 // #define CC_DATA_DEC 					CC97
 // #define CC_NRPN_LSB 					CC98
@@ -281,3 +281,11 @@
 // #define CC_OMNI_MODE_ON 				CC125
 // #define CC_MONO_MODE_ON 				CC126
 // #define CC_POLY_MODE_ON 				CC127
+
+// System exclusive frames between the Teensy and the Megas.
+// 0x7D is the manufacturer ID for non-commercial use.
+// A state request holds the panel state known by the Teensy, as control change and value pairs.
+// The state dump that answers it holds, the same way, the controls that differ.
+#define SYSEX_ID						0x7D
+#define SYSEX_STATE_REQUEST				0x01
+#define SYSEX_STATE_DUMP				0x02
@@ -68,14 +68,17 @@
 // includes
 #include "MIDI.h"			// https://github.com/FortySevenEffects/arduino_midi_library
 #include "PushButton.h"		// https://github.com/troisiemetype/PushButton
-#include "ExpFilter.h"		// https://github.com/troisiemetype/expfilter
 
 #include "defs.h"
+#include "adc_scan.h"
 
 // Constants
 const uint8_t NUM_SWITCHES = 3;
 const uint8_t NUM_POTS = 16;
-const uint8_t POT_FILTER_COEF = 20;
+// A pot is sent again only when it moves more than this, or when it reaches one end.
+const uint8_t POT_HYSTERESIS = 2;
+// Pot state that is never read, for sending a pot anyway.
+const uint16_t POT_UNKNOWN = 0xFFFF;
 
 // Note : pins are defined via tables, to improve code efficiency.
 // Digital pin definition
@@ -105,19 +108,42 @@ const uint8_t APIN_SUSTAIN = A13;
 const uint8_t APIN_RELEASE = A14;
 */
 
-const uint8_t APIN[NUM_POTS] = {A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15};
+// Pots are read by the ADC scan, in the order of analog inputs, from A0 to A15.
+
+// Control changes sent by each pot and switch, in the order of their inputs.
+// Note on osc 3 tune : sends CC10 (instead of CC13) then CC45 as should be.
+// or maybe pure data has a bug that shifts bits.
+// It seems it's a bug of pure data : 13 are replaced by 10 also for values...
+const uint8_t POT_CC[NUM_POTS] = {
+	CC_OSC_TUNE, CC_OSC2_TUNE, CC_OSC3_TUNE,
+	CC_FILTER_BAND, CC_FILTER_CUTOFF_FREQ, CC_FILTER_EMPHASIS, CC_FILTER_CONTOUR,
+	CC_FILTER_ATTACK, CC_FILTER_DECAY, CC_FILTER_SUSTAIN, CC_FILTER_RELEASE,
+	CC_EG_ATTACK, CC_EG_DECAY, CC_EG_SUSTAIN, CC_EG_RELEASE,
+	CC_CHANNEL_VOL
+};
+const uint8_t SWITCH_CC[NUM_SWITCHES] = {CC_FILTER_MOD, CC_FILTER_KEYTRACK_1, CC_FILTER_KEYTRACK_2};
 
 // Variables
 uint16_t potState[NUM_POTS];
 
 PushButton switches[NUM_SWITCHES];
-ExpFilter pots[NUM_POTS];
 
 bool update = 0;
 
+// Pots are not sent until they have all been read once : the Teensy asks for the panel state when it starts.
+// They are all read about 35 times per second.
+bool potsReady = 0;
+uint8_t potsRead = 0;
+
+// Panel state known by the Teensy, from its last request, and flag for answering it.
+uint8_t teensyState[128];
+bool dumpRequested = 0;
+
 struct midiSettings : public midi::DefaultSettings{
 //	static const bool UseRunningStatus = true;
 	static const long BaudRate = 115200;
+	// The panel state frames are a bit longer than the default.
+	static const unsigned SysExMaxSize = 300;
 };
 
 // The one we use on synth
@@ -133,26 +159,15 @@ void setup(){
 	}
 
 	for (uint8_t i = 0; i < NUM_POTS; ++i){
-		pots[i].begin(analogRead(APIN[i]));
-		pots[i].setCoef(POT_FILTER_COEF);
+		potState[i] = POT_UNKNOWN;
 	}
 
-	// Run init sequence to debounce switches and filter pots, so it's running for stable values.
-	// This one causes a bug on Mega 1, that I don't understand.
-	// Here it works perfect, when the system powers up every control is updated to its current state.
-	uint32_t initEnd = millis() + 500;
-	while(millis() < initEnd){
-		for(uint8_t i = 0; i < NUM_SWITCHES; ++i){
-			switches[i].update();
-		}
-
-		for(uint8_t i = 0; i < NUM_POTS; ++i){
-			uint16_t value = pots[i].filter(analogRead(APIN[i]));
-			potState[i] = value;
-		}		
-	}
+	adcScanBegin();
 
+	// There is no init sequence : pots are scanned in the background, and the Teensy asks for what it needs
+	// with a state request, answered when every pot has been read.
 	midi1.setHandleControlChange(handleControlChange);
+	midi1.setHandleSystemExclusive(handleSysEx);
 	midi1.begin(1);
 	midi1.turnThruOff();
 
@@ -163,79 +178,32 @@ void loop(){
 	updateControls();
 	updateSwitches();
 	update = 0;
+	if(dumpRequested && potsReady) sendStateDump();
 }
 
+// Read the values from the ADC scan, as long as there are some.
+// Values are 12 bits, calibrated, sent as 14-bits control changes.
 void updateControls(){
-	for(uint8_t i = 0; i < NUM_POTS; ++i){
-		uint16_t value = 0;
+	adcReading_t reading;
+	while(adcScanRead(&reading)){
+		uint8_t i = reading.channel;
+		uint16_t value = adcCalibrate(i, reading.value);
 
-		value = pots[i].filter(analogRead(APIN[i]));
-		if((value != potState[i]) || update){
-			potState[i] = value;
-		} else {
+		if(!potMoved(i, value)){
 			// If not change, skip midi update
-			continue;				
+			continue;
 		}
+		bool firstReading = (potState[i] == POT_UNKNOWN);
+		potState[i] = value;
 
-		int8_t controlChange = -1;
-
-		switch(i){
-			case 0:
-				controlChange = CC_OSC_TUNE;
-				break;
-			case 1:
-				controlChange = CC_OSC2_TUNE;
-				break;
-			case 2:
-			// This one has a problem : sends CC10 (instead of CC13) then CC45 as should be.
-			// or maybe pure data has a bug that shifts bits.
-			// It seems it's a bug of pure data : 13 are replaced by 10 also for values...
-				controlChange = CC_OSC3_TUNE;
-				break;
-			case 3:
-				controlChange = CC_FILTER_BAND;
-				break;
-			case 4:
-				controlChange = CC_FILTER_CUTOFF_FREQ;
-				break;
-			case 5:
-				controlChange = CC_FILTER_EMPHASIS;
-				break;
-			case 6:
-				controlChange = CC_FILTER_CONTOUR;
-				break;
-			case 7:
-				controlChange = CC_FILTER_ATTACK;
-				break;
-			case 8:
-				controlChange = CC_FILTER_DECAY;
-				break;
-			case 9:
-				controlChange = CC_FILTER_SUSTAIN;
-				break;
-			case 10:
-				controlChange = CC_FILTER_RELEASE;
-				break;
-			case 11:
-				controlChange = CC_EG_ATTACK;
-				break;
-			case 12:
-				controlChange = CC_EG_DECAY;
-				break;
-			case 13:
-				controlChange = CC_EG_SUSTAIN;
-				break;
-			case 14:
-				controlChange = CC_EG_RELEASE;
-				break;
-			case 15:
-				controlChange = CC_CHANNEL_VOL;
-				break;
-			default:
-				continue;
-
+		// Pots are not sent until they have all been read once.
+		if(!potsReady){
+			if(firstReading && (++potsRead >= NUM_POTS)) potsReady = 1;
+			continue;
 		}
 
+		uint8_t controlChange = POT_CC[i];
+
 		uint8_t valueHigh = value >> 7;
 		uint8_t valueLow = value & 0x7F;
 		midi1.sendControlChange(controlChange, valueHigh, 1);
@@ -243,6 +211,14 @@ void updateControls(){
 	}
 }
 
+// Tell if a pot has moved enough from its last sent value.
+bool potMoved(uint8_t pot, uint16_t value){
+	if(potState[pot] == POT_UNKNOWN) return 1;
+	if(value == potState[pot]) return 0;
+	if((value == 0) || (value == ADC_MAX)) return 1;
+	return abs((int16_t)value - (int16_t)potState[pot]) > POT_HYSTERESIS;
+}
+
 void updateSwitches(){
 	for(uint8_t i = 0; i < NUM_SWITCHES; ++i){
 		uint8_t change = 0;
@@ -260,31 +236,73 @@ void updateSwitches(){
 			continue;
 		}
 
-		int8_t controlChange = -1;
-
-		switch(i){
-			case 0:
-				controlChange = CC_FILTER_MOD;
-				break;
-			case 1:
-				controlChange = CC_FILTER_KEYTRACK_1;
-				break;
-			case 2:
-				controlChange = CC_FILTER_KEYTRACK_2;
-				break;
-			default:
-				continue;			
-		}
+		uint8_t controlChange = SWITCH_CC[i];
 
 		midi1.sendControlChange(controlChange, change, 1);
 	}
 }
 
 
+// Answer the Teensy's state request with the controls that differ from what it knows.
+// Pots are sent as 14-bits values : if one byte differs, both are sent.
+void sendStateDump(){
+	uint8_t frame[2 + 2 * (2 * NUM_POTS + NUM_SWITCHES)];
+	uint16_t length = 0;
+	frame[length++] = SYSEX_ID;
+	frame[length++] = SYSEX_STATE_DUMP;
+
+	for(uint8_t i = 0; i < NUM_POTS; ++i){
+		uint8_t valueHigh = potState[i] >> 7;
+		uint8_t valueLow = potState[i] & 0x7F;
+		uint8_t controlChange = POT_CC[i];
+		if((teensyState[controlChange] == valueHigh) && (teensyState[controlChange + 32] == valueLow)) continue;
+		frame[length++] = controlChange;
+		frame[length++] = valueHigh;
+		frame[length++] = controlChange + 32;
+		frame[length++] = valueLow;
+	}
+
+	for(uint8_t i = 0; i < NUM_SWITCHES; ++i){
+		uint8_t value = switches[i].isPressed() ? 127 : 0;
+		if(teensyState[SWITCH_CC[i]] == value) continue;
+		frame[length++] = SWITCH_CC[i];
+		frame[length++] = value;
+	}
+
+	midi1.sendSysEx(length, frame);
+	dumpRequested = 0;
+}
+
+// State request from the Teensy. The frame given by the MIDI library has its start and end bytes.
+void handleSysEx(uint8_t *frame, unsigned size){
+	if((size < 3) || (frame[1] != SYSEX_ID) || (frame[2] != SYSEX_STATE_REQUEST)) return;
+
+	// Controls not in the request are unknown to the Teensy, they have a value that is never sent.
+	for(uint8_t i = 0; i < 128; ++i){
+		teensyState[i] = 0xFF;
+	}
+	for(unsigned i = 3; (i + 1) < size; i += 2){
+		if(frame[i] & 0x80) break;
+		teensyState[frame[i]] = frame[i + 1];
+	}
+	dumpRequested = 1;
+}
+
 void handleControlChange(uint8_t channel, uint8_t command, uint8_t value){
 	switch(command){
 		case CC_ASK_FOR_DATA:
 			update = 1;
+			// Pots are read in the background : they are all sent on their next reading.
+			for(uint8_t i = 0; i < NUM_POTS; ++i){
+				potState[i] = POT_UNKNOWN;
+			}
+			break;
+		case CC_CALIBRATE:
+			if(value > 63){
+				adcCalibrationStart();
+			} else {
+				adcCalibrationStore();
+			}
 			break;
 	}
 }
\ No newline at end of file
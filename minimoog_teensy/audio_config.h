@@ -0,0 +1,49 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Audio block size and sample rate.
+ *
+ * The audio library runs with 128 samples blocks at 44.1kHz, that is 2.9ms of latency for each block.
+ * Both can be changed, but they must be seen by the audio library as well as by the sketch, so they can't be set here :
+ * they are given to the compiler, with a boards.local.txt file next to the boards.txt of Teensyduino, e.g.
+ *	teensy40.build.flags.defs=-D__IMXRT1062__ -DTEENSYDUINO=153 -DAUDIO_BLOCK_SAMPLES=32 -DAUDIO_SAMPLE_RATE_EXACT=48000.0f
+ * (keep the defines already in boards.txt, and only add the last two.)
+ *
+ * Smaller blocks lower the latency, at the cost of more CPU : every node has a fixed cost for each block.
+ * A higher sample rate costs CPU in proportion, and lowers the delay time available in the effect bus.
+ * Set REPORT_USAGE in the sketch to see what a setting costs, and run make benchmark in tools/patch_renderer
+ * to compare them all on a computer.
+ */
+
+#ifndef AUDIO_CONFIG_H
+#define AUDIO_CONFIG_H
+
+#include <AudioStream.h>
+
+static_assert((AUDIO_BLOCK_SAMPLES == 16) || (AUDIO_BLOCK_SAMPLES == 32)
+		|| (AUDIO_BLOCK_SAMPLES == 64) || (AUDIO_BLOCK_SAMPLES == 128),
+		"AUDIO_BLOCK_SAMPLES must be 16, 32, 64 or 128");
+
+static_assert((AUDIO_SAMPLE_RATE_EXACT > 44000) && (AUDIO_SAMPLE_RATE_EXACT < 96001),
+		"AUDIO_SAMPLE_RATE_EXACT must be between 44.1kHz and 96kHz");
+
+// Duration of one block, in microseconds.
+const float AUDIO_BLOCK_TIME = AUDIO_BLOCK_SAMPLES * 1000000.0 / AUDIO_SAMPLE_RATE_EXACT;
+
+#endif
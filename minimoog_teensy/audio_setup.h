@@ -4,17 +4,25 @@
 #include <SD.h>
 #include <SerialFlash.h>
 
+#include "audio_config.h"
+#include "effect_envelope_exp.h"
+#include "effect_fx_bus.h"
+#include "mixer_stereo.h"
+#include "synth_dc_timed.h"
+#include "synth_oscillator.h"
+#include "synth_sequencer.h"
+
 // GUItool: begin automatically generated code
-AudioSynthWaveformDc     dcFilterEnvelope; //xy=108.33332824707031,538
+AudioSynthSequencer      sequencer;      //xy=167.3333282470703,67
 AudioSynthWaveformDc     dcOscTune;      //xy=167.3333282470703,147
-AudioSynthWaveformDc     dcKeyTrack;     //xy=170.3333282470703,111
+AudioSynthDcTimed        dcKeyTrack;     //xy=170.3333282470703,111
 AudioSynthWaveformDc     dcPitchBend;    //xy=173.3333282470703,182
 AudioSynthWaveformDc     dcFilter;       //xy=275.3333282470703,593
 AudioSynthNoisePink      pinkNoise;      //xy=297.3333282470703,318
 AudioSynthWaveformDc     dcLfoFreq;      //xy=299.3333282470703,367
 AudioSynthNoiseWhite     whiteNoise;     //xy=300.3333282470703,282
-AudioEffectEnvelope      filterEnvelope; //xy=306.3333282470703,538
-AudioSynthWaveformDc     dcFilterKeyTrack; //xy=308.3333282470703,627
+AudioEffectEnvelopeExp   filterEnvelope; //xy=306.3333282470703,538
+AudioSynthDcTimed        dcFilterKeyTrack; //xy=308.3333282470703,627
 AudioAmplifier           ampPitchBend;   //xy=346.3333282470703,182
 AudioMixer4              noiseMixer;     //xy=483.3333282470703,315
 AudioSynthWaveformModulated lfoWaveform;    //xy=488.3333282470703,367
@@ -32,25 +40,25 @@ AudioAmplifier           ampModWheelOsc; //xy=1094.3333282470703,426
 AudioAmplifier           ampModWheelFilter; //xy=1101.3333282470703,461
 AudioMixer4              osc3TuneMixer;  //xy=1228.3333282470703,215
 AudioMixer4              osc2TuneMixer;  //xy=1229.3333282470703,151
-AudioSynthWaveformDc     dcPulse;        //xy=1245.3333282470703,63
-AudioSynthWaveformModulated osc1Waveform;   //xy=1462.3333282470703,112
-AudioSynthWaveformModulated osc2Waveform;   //xy=1463.3333282470703,149
-AudioSynthWaveformModulated osc3Waveform;   //xy=1463.3333282470703,186
-AudioMixer4              oscMixer;       //xy=1649.3333282470703,155
-AudioMixer4              globalMixer;    //xy=1858.3333282470703,202
-AudioAmplifier           ampPreFilter;   //xy=2022.3333282470703,201
+AudioSynthOscillatorBank oscillators;    //xy=1462.3333282470703,149
+AudioMixerStereo         stereoMixer;    //xy=1858.3333282470703,202
 AudioMixer4              filterMixer;    //xy=2040.3333282470703,444
 AudioFilterStateVariable vcf;            //xy=2209.3333282470703,438
+AudioFilterStateVariable vcfRight;       //xy=2209.3333282470703,538
 AudioAnalyzePeak         peakPreFilter;  //xy=2271.3333282470703,188
 AudioAnalyzePrint        printPreFilter; //xy=2271.3333282470703,225
 AudioMixer4              bandMixer;      //xy=2380.3333282470703,433
-AudioEffectEnvelope      mainEnvelope;   //xy=2559.3333282470703,434
+AudioMixer4              bandMixerRight; //xy=2380.3333282470703,533
+AudioEffectEnvelopeExp   mainEnvelope;   //xy=2559.3333282470703,434
+AudioEffectEnvelopeExp   mainEnvelopeRight; //xy=2559.3333282470703,554
 AudioAnalyzePeak         peakPostFilter; //xy=2559.3333282470703,503
 AudioAnalyzePrint        printPostFilter; //xy=2562.3333282470703,471
 AudioEffectBitcrusher    bitCrushOutput; //xy=2795.3333282470703,431
+AudioEffectBitcrusher    bitCrushOutputRight; //xy=2795.3333282470703,531
 AudioAmplifier           masterVolume;   //xy=2988.3333282470703,430
+AudioAmplifier           masterVolumeRight; //xy=2988.3333282470703,530
+AudioEffectFxBus         fxBus;          //xy=3075.3333282470703,430
 AudioOutputI2S           i2s;            //xy=3159.3333282470703,430
-AudioConnection          patchCord1(dcFilterEnvelope, filterEnvelope);
 AudioConnection          patchCord2(dcOscTune, 0, mainTuneMixer, 1);
 AudioConnection          patchCord3(dcKeyTrack, 0, mainTuneMixer, 0);
 AudioConnection          patchCord4(dcPitchBend, ampPitchBend);
@@ -59,16 +67,16 @@ AudioConnection          patchCord6(pinkNoise, 0, noiseMixer, 1);
 AudioConnection          patchCord7(dcLfoFreq, 0, lfoWaveform, 0);
 AudioConnection          patchCord8(whiteNoise, 0, noiseMixer, 0);
 AudioConnection          patchCord9(filterEnvelope, 0, filterMixer, 1);
-AudioConnection          patchCord10(filterEnvelope, ampModEg);
+AudioConnection          patchCord10(filterEnvelope, 0, ampModEg, 0);
 AudioConnection          patchCord11(dcFilterKeyTrack, 0, filterMixer, 3);
 AudioConnection          patchCord12(ampPitchBend, 0, mainTuneMixer, 2);
 AudioConnection          patchCord13(noiseMixer, 0, modMix1, 0);
-AudioConnection          patchCord14(noiseMixer, 0, oscMixer, 3);
+AudioConnection          patchCord14(noiseMixer, 0, stereoMixer, 3);
 AudioConnection          patchCord15(lfoWaveform, 0, modMix1, 1);
 AudioConnection          patchCord16(ampOsc3Mod, 0, modMix2, 0);
 AudioConnection          patchCord17(ampModEg, 0, modMix2, 1);
 AudioConnection          patchCord18(mainTuneMixer, 0, osc3ControlMixer, 0);
-AudioConnection          patchCord19(mainTuneMixer, 0, osc1Waveform, 0);
+AudioConnection          patchCord19(mainTuneMixer, 0, oscillators, 0);
 AudioConnection          patchCord20(mainTuneMixer, 0, osc2TuneMixer, 0);
 AudioConnection          patchCord21(modMix2, 0, modMixer, 1);
 AudioConnection          patchCord22(modMix1, 0, modMixer, 0);
@@ -80,46 +88,46 @@ AudioConnection          patchCord27(dcOsc2Tune, 0, osc2TuneMixer, 1);
 AudioConnection          patchCord28(dcOsc3Tune, 0, osc3TuneMixer, 1);
 AudioConnection          patchCord29(ampModWheelOsc, 0, mainTuneMixer, 3);
 AudioConnection          patchCord30(ampModWheelFilter, 0, filterMixer, 0);
-AudioConnection          patchCord31(osc3TuneMixer, 0, osc3Waveform, 0);
-AudioConnection          patchCord32(osc2TuneMixer, 0, osc2Waveform, 0);
-AudioConnection          patchCord33(dcPulse, 0, osc1Waveform, 1);
-AudioConnection          patchCord34(dcPulse, 0, osc2Waveform, 1);
-AudioConnection          patchCord35(dcPulse, 0, osc3Waveform, 1);
-AudioConnection          patchCord36(osc1Waveform, 0, oscMixer, 0);
-AudioConnection          patchCord37(osc2Waveform, 0, oscMixer, 1);
-AudioConnection          patchCord38(osc3Waveform, 0, oscMixer, 2);
-AudioConnection          patchCord39(osc3Waveform, ampOsc3Mod);
-AudioConnection          patchCord40(oscMixer, 0, globalMixer, 0);
-AudioConnection          patchCord41(globalMixer, ampPreFilter);
-AudioConnection          patchCord42(ampPreFilter, 0, vcf, 0);
-AudioConnection          patchCord43(ampPreFilter, printPreFilter);
-AudioConnection          patchCord44(filterMixer, 0, vcf, 1);
-AudioConnection          patchCord45(vcf, 0, bandMixer, 0);
-AudioConnection          patchCord46(vcf, 1, bandMixer, 1);
-AudioConnection          patchCord47(vcf, 2, bandMixer, 2);
+AudioConnection          patchCord31(osc3TuneMixer, 0, oscillators, 2);
+AudioConnection          patchCord32(osc2TuneMixer, 0, oscillators, 1);
+AudioConnection          patchCord33(oscillators, 0, stereoMixer, 0);
+AudioConnection          patchCord34(oscillators, 1, stereoMixer, 1);
+AudioConnection          patchCord35(oscillators, 2, stereoMixer, 2);
+AudioConnection          patchCord36(oscillators, 2, ampOsc3Mod, 0);
+AudioConnection          patchCord37(stereoMixer, 0, vcf, 0);
+AudioConnection          patchCord38(stereoMixer, 0, printPreFilter, 0);
+AudioConnection          patchCord39(stereoMixer, 1, vcfRight, 0);
+AudioConnection          patchCord40(filterMixer, 0, vcf, 1);
+AudioConnection          patchCord41(filterMixer, 0, vcfRight, 1);
+AudioConnection          patchCord42(vcf, 0, bandMixer, 0);
+AudioConnection          patchCord43(vcf, 1, bandMixer, 1);
+AudioConnection          patchCord44(vcf, 2, bandMixer, 2);
+AudioConnection          patchCord45(vcfRight, 0, bandMixerRight, 0);
+AudioConnection          patchCord46(vcfRight, 1, bandMixerRight, 1);
+AudioConnection          patchCord47(vcfRight, 2, bandMixerRight, 2);
 AudioConnection          patchCord48(bandMixer, mainEnvelope);
-AudioConnection          patchCord49(bandMixer, 0, globalMixer, 1);
-AudioConnection          patchCord50(mainEnvelope, bitCrushOutput);
-AudioConnection          patchCord51(bitCrushOutput, masterVolume);
-AudioConnection          patchCord52(masterVolume, 0, i2s, 0);
-AudioConnection          patchCord53(masterVolume, 0, i2s, 1);
+AudioConnection          patchCord49(bandMixer, 0, stereoMixer, 4);
+AudioConnection          patchCord50(bandMixerRight, mainEnvelopeRight);
+AudioConnection          patchCord51(bandMixerRight, 0, stereoMixer, 5);
+AudioConnection          patchCord52(mainEnvelope, bitCrushOutput);
+AudioConnection          patchCord53(mainEnvelopeRight, bitCrushOutputRight);
+AudioConnection          patchCord54(bitCrushOutput, masterVolume);
+AudioConnection          patchCord55(bitCrushOutputRight, masterVolumeRight);
+AudioConnection          patchCord56(masterVolume, 0, fxBus, 0);
+AudioConnection          patchCord57(masterVolumeRight, 0, fxBus, 1);
+AudioConnection          patchCord58(fxBus, 0, i2s, 0);
+AudioConnection          patchCord59(fxBus, 1, i2s, 1);
 
 // for debug purpose, uncomment to test audio with internal DAC, or USB.
 
 // on board DAC may need a decoupling capacitor (10uF is a safe value)
 // AudioOutputAnalog        dac1;           //xy=3166.3333282470703,501.3333282470703
-// AudioConnection          patchCord54(masterVolume, dac1);
+// AudioConnection          patchCord60(fxBus, dac1);
 
 // USB needs the sketch to be compiled with USB type set to audio, MIDI + audio or MIDI + serial + audio in the IDE
 // AudioOutputUSB           usb1;           //xy=3159.3333740234375,363.3333435058594
-// AudioConnection          patchCord55(masterVolume, 0, usb1, 0);
-// AudioConnection          patchCord56(masterVolume, 0, usb1, 1);
-
-
-// Sync connection
-//AudioConnection          patchCord54(osc1Waveform, 1, osc2Waveform, 2);
-//AudioConnection          patchCord55(osc1Waveform, 1, osc3Waveform, 2);
-// Sync connection  -end
+// AudioConnection          patchCord61(fxBus, 0, usb1, 0);
+// AudioConnection          patchCord62(fxBus, 1, usb1, 1);
 
 
 // GUItool: end automatically generated code
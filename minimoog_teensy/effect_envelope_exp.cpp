@@ -0,0 +1,227 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "effect_envelope_exp.h"
+
+// The attack charges towards a level higher than full scale, and stops when full scale is reached.
+// This is what gives its shape to an analog attack : fast at start, slower when reaching the top.
+static const float ATTACK_TARGET = 1.3;
+static const float ATTACK_RATIO = ATTACK_TARGET / (ATTACK_TARGET - 1.0);
+// Decay and release times are given for reaching -60dB of the remaining course.
+static const float DECAY_RATIO = 1000.0;
+// Under this distance to target, the segment is considered as done. It's under the 16 bits resolution.
+static const float SETTLE_LEVEL = 1.0 / 65536;
+
+// Compute the recursion coefficient for a segment that covers "ratio" in "ms" milliseconds.
+float AudioEffectEnvelopeExp::coefFromTime(float ms, float ratio){
+	float samples = ms * AUDIO_SAMPLE_RATE_EXACT / 1000.0;
+	if(samples < 1.0) return 0.0;
+	return expf(-logf(ratio) / samples);
+}
+
+void AudioEffectEnvelopeExp::attack(float ms){
+	float coef = coefFromTime(ms, ATTACK_RATIO);
+	_attackCoef = coef;
+	_attackBase = ATTACK_TARGET * (1.0 - coef);
+}
+
+void AudioEffectEnvelopeExp::decay(float ms){
+	float coef = coefFromTime(ms, DECAY_RATIO);
+	_decayCoef = coef;
+	_decayBase = _sustain * (1.0 - coef);
+}
+
+void AudioEffectEnvelopeExp::sustain(float level){
+	if(level < 0.0) level = 0.0;
+	if(level > 1.0) level = 1.0;
+	_sustain = level;
+	_decayBase = _sustain * (1.0 - _decayCoef);
+	// When the sustain knob moves while a note is held, glide to the new level instead of jumping.
+	if(_state == STATE_SUSTAIN) _state = STATE_DECAY;
+}
+
+void AudioEffectEnvelopeExp::release(float ms){
+	_releaseCoef = coefFromTime(ms, DECAY_RATIO);
+}
+
+// Start (or restart) the attack from the current level.
+void AudioEffectEnvelopeExp::noteOn(uint16_t offset){
+	if(offset >= AUDIO_BLOCK_SAMPLES) offset = AUDIO_BLOCK_SAMPLES - 1;
+	if(offset == 0){
+		_onOffset = -1;
+		_state = STATE_ATTACK;
+	} else {
+		_onOffset = offset;
+	}
+}
+
+void AudioEffectEnvelopeExp::noteOff(uint16_t offset){
+	if(offset >= AUDIO_BLOCK_SAMPLES) offset = AUDIO_BLOCK_SAMPLES - 1;
+	if(offset == 0){
+		_offOffset = -1;
+		if(_state != STATE_IDLE) _state = STATE_RELEASE;
+	} else {
+		_offOffset = offset;
+	}
+}
+
+bool AudioEffectEnvelopeExp::isActive(){
+	return _state != STATE_IDLE;
+}
+
+bool AudioEffectEnvelopeExp::isSustain(){
+	return _state == STATE_SUSTAIN;
+}
+
+// Compute the envelope for one block, with the pending note on and off at their offset.
+// Returns the number of samples computed in env[]. Zero means the whole block is at sustain level.
+uint16_t AudioEffectEnvelopeExp::render(float *env){
+	int16_t on = _onOffset;
+	int16_t off = _offOffset;
+	_onOffset = -1;
+	_offOffset = -1;
+
+	if((on < 0) && (off < 0)){
+		if(_state == STATE_SUSTAIN) return 0;
+		renderSegment(env, 0, AUDIO_BLOCK_SAMPLES);
+		return AUDIO_BLOCK_SAMPLES;
+	}
+
+	// Both can happen in the same block, they are applied in time order.
+	uint16_t i = 0;
+	for(uint8_t n = 0; n < 2; ++n){
+		bool isOn = (on >= 0) && ((off < 0) || (on <= off));
+		int16_t offset = isOn ? on : off;
+		if(offset < 0) break;
+		renderSegment(env, i, offset);
+		i = offset;
+		if(isOn){
+			_state = STATE_ATTACK;
+			on = -1;
+		} else {
+			if(_state != STATE_IDLE) _state = STATE_RELEASE;
+			off = -1;
+		}
+	}
+	renderSegment(env, i, AUDIO_BLOCK_SAMPLES);
+
+	return AUDIO_BLOCK_SAMPLES;
+}
+
+// Compute the envelope from sample "start" to sample "end" (excluded) of the block.
+void AudioEffectEnvelopeExp::renderSegment(float *env, uint16_t start, uint16_t end){
+	float level = _level;
+	uint16_t i = start;
+
+	while(i < end){
+		switch(_state){
+			case STATE_ATTACK:
+				for(; i < end; ++i){
+					level = _attackBase + level * _attackCoef;
+					if(level >= 1.0){
+						level = 1.0;
+						env[i++] = level;
+						_state = STATE_DECAY;
+						break;
+					}
+					env[i] = level;
+				}
+				break;
+			case STATE_DECAY:
+				for(; i < end; ++i){
+					level = _decayBase + level * _decayCoef;
+					env[i] = level;
+				}
+				// Checking once per segment is enough, the course left is inaudible.
+				if(fabsf(level - _sustain) < SETTLE_LEVEL){
+					level = _sustain;
+					_state = STATE_SUSTAIN;
+				}
+				break;
+			case STATE_RELEASE:
+				for(; i < end; ++i){
+					level *= _releaseCoef;
+					env[i] = level;
+				}
+				if(level < SETTLE_LEVEL){
+					level = 0.0;
+					_state = STATE_IDLE;
+				}
+				break;
+			case STATE_SUSTAIN:
+				for(; i < end; ++i){
+					env[i] = level;
+				}
+				break;
+			default:
+				for(; i < end; ++i){
+					env[i] = 0.0;
+				}
+				break;
+		}
+	}
+
+	_level = level;
+}
+
+void AudioEffectEnvelopeExp::update(void){
+	audio_block_t *block = NULL;
+	float env[AUDIO_BLOCK_SAMPLES];
+
+	if(!_generator) block = receiveWritable(0);
+
+	if((_state == STATE_IDLE) && (_onOffset < 0)){
+		if(block) AudioStream::release(block);
+		_offOffset = -1;
+		return;
+	}
+
+	uint16_t length = render(env);
+	float endLevel = (length == 0) ? _sustain : _level;
+
+	if(_generator){
+		block = allocate();
+		if(block){
+			if(length == 0){
+				int16_t value = endLevel * 32767;
+				for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+					block->data[i] = value;
+				}
+			} else {
+				for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+					block->data[i] = env[i] * 32767;
+				}
+			}
+			transmit(block, 0);
+			AudioStream::release(block);
+		}
+	} else if(block){
+		if(length == 0){
+			for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+				block->data[i] = block->data[i] * endLevel;
+			}
+		} else {
+			for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+				block->data[i] = block->data[i] * env[i];
+			}
+		}
+		transmit(block, 0);
+		AudioStream::release(block);
+	}
+}
@@ -0,0 +1,109 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Exponential ADSR envelope, for use with the PJRC audio library.
+ *
+ * It behaves like the RC envelope of an analog synth : each segment charges or discharges
+ * towards a target, so attack is concave and decay / release are exponential.
+ * Each segment is computed recursively : level = base + level * coef, one multiply-add per sample.
+ *
+ * Note on (re)trigger : the attack starts from the current level, like an analog envelope does.
+ * There is no forced release to zero, hence no click when notes are played legato with retrigger.
+ *
+ * Note on and note off can be given a sample offset : they then happen at this sample of the next block,
+ * instead of at its start. It's for the sequencer, that runs at sample resolution.
+ *
+ * Outputs :
+ *	0	input multiplied by the envelope (VCA), or the envelope itself when used as a generator.
+ *
+ * When idle, nothing is transmitted. When on sustain, the level is constant and no recursion is done.
+ */
+
+#ifndef EFFECT_ENVELOPE_EXP_H
+#define EFFECT_ENVELOPE_EXP_H
+
+#include <Arduino.h>
+#include <AudioStream.h>
+
+class AudioEffectEnvelopeExp : public AudioStream{
+public:
+	AudioEffectEnvelopeExp() : AudioStream(1, inputQueueArray){
+		_state = STATE_IDLE;
+		_generator = false;
+		_onOffset = -1;
+		_offOffset = -1;
+		_level = 0;
+		_sustain = 1.0;
+		attack(10);
+		decay(50);
+		release(100);
+	}
+
+	// Times are given in milliseconds.
+	// Attack time is the time to go from zero to full level.
+	// Decay and release times are the time to get within -60dB of their target.
+	void attack(float ms);
+	void decay(float ms);
+	void sustain(float level);
+	void release(float ms);
+
+	// When set as a generator, the input is not used and the envelope itself is sent to output 0.
+	void generator(bool value){_generator = value;}
+
+	// Offset is in samples, from the start of the next block.
+	void noteOn(uint16_t offset = 0);
+	void noteOff(uint16_t offset = 0);
+
+	bool isActive();
+	bool isSustain();
+
+	virtual void update(void);
+
+private:
+	enum state_t{
+		STATE_IDLE = 0,
+		STATE_ATTACK,
+		STATE_DECAY,
+		STATE_SUSTAIN,
+		STATE_RELEASE,
+	};
+
+	float coefFromTime(float ms, float ratio);
+	uint16_t render(float *env);
+	void renderSegment(float *env, uint16_t start, uint16_t end);
+
+	audio_block_t *inputQueueArray[1];
+
+	volatile state_t _state;
+	bool _generator;
+	// Pending note on and note off, as offsets in the next block. -1 when none.
+	volatile int16_t _onOffset;
+	volatile int16_t _offOffset;
+
+	float _level;
+	float _sustain;
+
+	float _attackCoef;
+	float _attackBase;
+	float _decayCoef;
+	float _decayBase;
+	float _releaseCoef;
+};
+
+#endif
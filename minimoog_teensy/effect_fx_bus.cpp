@@ -0,0 +1,418 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "effect_fx_bus.h"
+
+// The arena. DMAMEM puts it in the second RAM bank of the Teensy 4.0.
+static DMAMEM int16_t fxArena[FX_ARENA_SAMPLES];
+
+extern "C" {
+extern const int16_t AudioWaveformSine[257];
+}
+
+// Chorus : base delay and maximum sweep, in milliseconds.
+static const float CHORUS_BASE_TIME = 12.0;
+static const float CHORUS_MAX_DEPTH = 6.0;
+// Delay feedback is damped, like a tape echo. This is the coefficient of the low pass in the loop.
+static const float DELAY_DAMPING = 0.35;
+// Delay time changes are smoothed, so turning the knob bends the pitch instead of clicking.
+static const float DELAY_SMOOTHING = 0.0005;
+
+// Reverb line lengths are given for a 29761Hz sample rate, as in Dattorro's paper.
+static const float REVERB_BASE_RATE = 29761.0;
+static const uint16_t REVERB_DIFFUSER_LENGTH[4] = {142, 107, 379, 277};
+static const float REVERB_DIFFUSER_GAIN[4] = {0.75, 0.75, 0.625, 0.625};
+static const uint16_t REVERB_TANK_AP1_LENGTH[2] = {672, 908};
+static const uint16_t REVERB_TANK_DELAY1_LENGTH[2] = {4453, 4217};
+static const uint16_t REVERB_TANK_AP2_LENGTH[2] = {1800, 2656};
+static const uint16_t REVERB_TANK_DELAY2_LENGTH[2] = {3720, 3163};
+static const float REVERB_TANK_AP1_GAIN = 0.7;
+static const float REVERB_TANK_AP2_GAIN = 0.5;
+static const float REVERB_DAMPING = 0.3;
+static const float REVERB_BANDWIDTH = 0.6;
+// The reverb tank runs at a lower level, to keep headroom in the 16 bits lines.
+static const float REVERB_INPUT_GAIN = 0.35;
+static const float REVERB_OUTPUT_GAIN = 1.0 / REVERB_INPUT_GAIN;
+
+// Circular buffer helpers.
+// "index" is where the next sample will be written, so the oldest sample is there too.
+static inline int16_t saturate16(float value){
+	if(value > 32767.0) return 32767;
+	if(value < -32768.0) return -32768;
+	return (int16_t)value;
+}
+
+static inline void lineWrite(FxDelayLine *line, float value){
+	line->buffer[line->index] = saturate16(value);
+	if(++line->index >= line->length) line->index = 0;
+}
+
+// Read the sample written "delay" samples ago.
+static inline float lineTap(const FxDelayLine *line, uint32_t delay){
+	int32_t index = (int32_t)line->index - (int32_t)delay;
+	if(index < 0) index += line->length;
+	return line->buffer[index];
+}
+
+// Ditto, with linear interpolation for fractional delays.
+static inline float lineRead(const FxDelayLine *line, float delay){
+	uint32_t whole = (uint32_t)delay;
+	float frac = delay - whole;
+	float a = lineTap(line, whole);
+	float b = lineTap(line, whole + 1);
+	return a + frac * (b - a);
+}
+
+// Oldest sample, i.e. the output of a delay that spans the whole line.
+static inline float lineOldest(const FxDelayLine *line){
+	return line->buffer[line->index];
+}
+
+// Schroeder allpass, used for diffusion.
+static inline float allpass(FxDelayLine *line, float input, float gain){
+	float delayed = lineOldest(line);
+	float value = input - gain * delayed;
+	lineWrite(line, value);
+	return delayed + gain * value;
+}
+
+AudioEffectFxBus::AudioEffectFxBus() : AudioStream(2, inputQueueArray){
+	_arenaUsed = 0;
+	_enabled = false;
+	_mono = false;
+	_dry = 1.0;
+	_returnL = 1.0;
+	_returnR = 1.0;
+
+	// Reverb and chorus first, they have a fixed size.
+	for(uint8_t i = 0; i < 4; ++i){
+		take(&_reverbDiffuser[i], scaleLength(REVERB_DIFFUSER_LENGTH[i]));
+	}
+	for(uint8_t i = 0; i < 2; ++i){
+		take(&_reverbTankAp1[i], scaleLength(REVERB_TANK_AP1_LENGTH[i]));
+		take(&_reverbTankDelay1[i], scaleLength(REVERB_TANK_DELAY1_LENGTH[i]));
+		take(&_reverbTankAp2[i], scaleLength(REVERB_TANK_AP2_LENGTH[i]));
+		take(&_reverbTankDelay2[i], scaleLength(REVERB_TANK_DELAY2_LENGTH[i]));
+		_reverbDamp[i] = 0.0;
+	}
+	_reverbBandwidth = 0.0;
+	_reverbDecay = 0.5;
+	_reverbMix = 0.0;
+
+	take(&_chorus, (CHORUS_BASE_TIME + CHORUS_MAX_DEPTH) * AUDIO_SAMPLE_RATE_EXACT / 1000.0 + 2);
+	_chorusPhase = 0;
+	_chorusDepth = 0.5;
+	_chorusMix = 0.0;
+	chorusRate(0.5);
+
+	// The stereo delay takes what is left, shared between both channels.
+	uint32_t delayLength = (FX_ARENA_SAMPLES - _arenaUsed) / 2;
+	take(&_delayL, delayLength);
+	take(&_delayR, delayLength);
+	_delayFeedback = 0.3;
+	_delayMix = 0.0;
+	_delayDampL = 0.0;
+	_delayDampR = 0.0;
+	delayTime(300);
+	_delayCurrent = _delayTarget;
+}
+
+// Take a line from the arena. Only called at startup.
+bool AudioEffectFxBus::take(FxDelayLine *line, uint32_t length){
+	if(length < 2) length = 2;
+	if(_arenaUsed + length > FX_ARENA_SAMPLES){
+		line->buffer = NULL;
+		line->length = 0;
+		line->index = 0;
+		return false;
+	}
+	line->buffer = fxArena + _arenaUsed;
+	line->length = length;
+	line->index = 0;
+	_arenaUsed += length;
+	clear(line);
+	return true;
+}
+
+void AudioEffectFxBus::clear(FxDelayLine *line){
+	if(line->buffer) memset(line->buffer, 0, line->length * sizeof(int16_t));
+	line->index = 0;
+}
+
+uint32_t AudioEffectFxBus::scaleLength(uint32_t length){
+	return (uint32_t)(length * AUDIO_SAMPLE_RATE_EXACT / REVERB_BASE_RATE + 0.5);
+}
+
+void AudioEffectFxBus::enable(bool value){
+	if(value && !_enabled){
+		// Don't play back what was left in the lines when the bus was last disabled.
+		for(uint8_t i = 0; i < 4; ++i) clear(&_reverbDiffuser[i]);
+		for(uint8_t i = 0; i < 2; ++i){
+			clear(&_reverbTankAp1[i]);
+			clear(&_reverbTankDelay1[i]);
+			clear(&_reverbTankAp2[i]);
+			clear(&_reverbTankDelay2[i]);
+		}
+		clear(&_chorus);
+		clear(&_delayL);
+		clear(&_delayR);
+	}
+	_enabled = value;
+}
+
+// Balance law : both returns are at full level when centered.
+void AudioEffectFxBus::returnPan(float value){
+	if(value < -1.0) value = -1.0;
+	if(value > 1.0) value = 1.0;
+	_returnL = (value > 0.0) ? 1.0 - value : 1.0;
+	_returnR = (value < 0.0) ? 1.0 + value : 1.0;
+}
+
+void AudioEffectFxBus::delayTime(float ms){
+	float samples = ms * AUDIO_SAMPLE_RATE_EXACT / 1000.0;
+	if(samples < 1.0) samples = 1.0;
+	if(samples > _delayL.length - 2) samples = _delayL.length - 2;
+	_delayTarget = samples;
+}
+
+void AudioEffectFxBus::delayFeedback(float value){
+	if(value < 0.0) value = 0.0;
+	if(value > 0.95) value = 0.95;
+	_delayFeedback = value;
+}
+
+void AudioEffectFxBus::delayMix(float level){
+	if((level > 0.0) && (_delayMix == 0.0)){
+		clear(&_delayL);
+		clear(&_delayR);
+	}
+	_delayMix = level;
+}
+
+void AudioEffectFxBus::chorusRate(float hz){
+	_chorusInc = hz * 4294967296.0 / AUDIO_SAMPLE_RATE_EXACT;
+}
+
+void AudioEffectFxBus::chorusDepth(float value){
+	if(value < 0.0) value = 0.0;
+	if(value > 1.0) value = 1.0;
+	_chorusDepth = value;
+}
+
+void AudioEffectFxBus::chorusMix(float level){
+	if((level > 0.0) && (_chorusMix == 0.0)) clear(&_chorus);
+	_chorusMix = level;
+}
+
+void AudioEffectFxBus::reverbSize(float value){
+	if(value < 0.0) value = 0.0;
+	if(value > 1.0) value = 1.0;
+	_reverbDecay = 0.2 + value * 0.75;
+}
+
+void AudioEffectFxBus::reverbMix(float level){
+	if((level > 0.0) && (_reverbMix == 0.0)){
+		for(uint8_t i = 0; i < 4; ++i) clear(&_reverbDiffuser[i]);
+		for(uint8_t i = 0; i < 2; ++i){
+			clear(&_reverbTankAp1[i]);
+			clear(&_reverbTankDelay1[i]);
+			clear(&_reverbTankAp2[i]);
+			clear(&_reverbTankDelay2[i]);
+		}
+	}
+	_reverbMix = level;
+}
+
+// Stereo chorus : one line, read by two taps swept in quadrature.
+void AudioEffectFxBus::processChorus(const float *in, float *left, float *right){
+	float base = CHORUS_BASE_TIME * AUDIO_SAMPLE_RATE_EXACT / 1000.0;
+	float depth = _chorusDepth * CHORUS_MAX_DEPTH * AUDIO_SAMPLE_RATE_EXACT / 1000.0 / 2.0;
+	uint32_t phase = _chorusPhase;
+
+	for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+		lineWrite(&_chorus, in[i]);
+
+		// Sine LFO, from the audio library table. The second tap is a quarter of a turn away.
+		uint32_t index = phase >> 24;
+		uint32_t indexQ = (index + 64) & 0xFF;
+		float lfo = AudioWaveformSine[index] / 32768.0;
+		float lfoQ = AudioWaveformSine[indexQ] / 32768.0;
+		phase += _chorusInc;
+
+		left[i] += _chorusMix * lineRead(&_chorus, base + depth * (1.0 + lfo));
+		right[i] += _chorusMix * lineRead(&_chorus, base + depth * (1.0 + lfoQ));
+	}
+
+	_chorusPhase = phase;
+}
+
+// Ping-pong delay : the left line is fed by the input, the right one by the left line.
+void AudioEffectFxBus::processDelay(const float *in, float *left, float *right){
+	float current = _delayCurrent;
+	float dampL = _delayDampL;
+	float dampR = _delayDampR;
+
+	for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+		current += DELAY_SMOOTHING * (_delayTarget - current);
+		float outL = lineRead(&_delayL, current);
+		float outR = lineRead(&_delayR, current);
+
+		dampL += DELAY_DAMPING * (outL - dampL);
+		dampR += DELAY_DAMPING * (outR - dampR);
+
+		lineWrite(&_delayL, in[i] + _delayFeedback * dampR);
+		lineWrite(&_delayR, _delayFeedback * dampL);
+
+		left[i] += _delayMix * outL;
+		right[i] += _delayMix * outR;
+	}
+
+	_delayCurrent = current;
+	_delayDampL = dampL;
+	_delayDampR = dampR;
+}
+
+// Plate reverb : input diffusion, then two cross-coupled tanks. Each side of the output is tapped on both tanks.
+void AudioEffectFxBus::processReverb(const float *in, float *left, float *right){
+	float bandwidth = _reverbBandwidth;
+	uint32_t tapL[7];
+	uint32_t tapR[7];
+
+	// Output taps, from the same paper.
+	tapL[0] = scaleLength(266);
+	tapL[1] = scaleLength(2974);
+	tapL[2] = scaleLength(1913);
+	tapL[3] = scaleLength(1996);
+	tapL[4] = scaleLength(1990);
+	tapL[5] = scaleLength(187);
+	tapL[6] = scaleLength(1066);
+	tapR[0] = scaleLength(353);
+	tapR[1] = scaleLength(3627);
+	tapR[2] = scaleLength(1228);
+	tapR[3] = scaleLength(2673);
+	tapR[4] = scaleLength(2111);
+	tapR[5] = scaleLength(335);
+	tapR[6] = scaleLength(121);
+
+	for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+		bandwidth += REVERB_BANDWIDTH * (in[i] * REVERB_INPUT_GAIN - bandwidth);
+		float value = bandwidth;
+		for(uint8_t d = 0; d < 4; ++d){
+			value = allpass(&_reverbDiffuser[d], value, REVERB_DIFFUSER_GAIN[d]);
+		}
+
+		// Each tank is fed by the diffused input and the output of the other one.
+		float feedA = lineOldest(&_reverbTankDelay2[1]);
+		float feedB = lineOldest(&_reverbTankDelay2[0]);
+		float tankIn[2] = {value + _reverbDecay * feedA, value + _reverbDecay * feedB};
+
+		for(uint8_t t = 0; t < 2; ++t){
+			float x = allpass(&_reverbTankAp1[t], tankIn[t], -REVERB_TANK_AP1_GAIN);
+			float delayed = lineOldest(&_reverbTankDelay1[t]);
+			lineWrite(&_reverbTankDelay1[t], x);
+			_reverbDamp[t] += (1.0 - REVERB_DAMPING) * (delayed - _reverbDamp[t]);
+			x = allpass(&_reverbTankAp2[t], _reverbDamp[t] * _reverbDecay, REVERB_TANK_AP2_GAIN);
+			lineWrite(&_reverbTankDelay2[t], x);
+		}
+
+		float outL = lineTap(&_reverbTankDelay1[1], tapL[0])
+				+ lineTap(&_reverbTankDelay1[1], tapL[1])
+				- lineTap(&_reverbTankAp2[1], tapL[2])
+				+ lineTap(&_reverbTankDelay2[1], tapL[3])
+				- lineTap(&_reverbTankDelay1[0], tapL[4])
+				- lineTap(&_reverbTankAp2[0], tapL[5])
+				- lineTap(&_reverbTankDelay2[0], tapL[6]);
+		float outR = lineTap(&_reverbTankDelay1[0], tapR[0])
+				+ lineTap(&_reverbTankDelay1[0], tapR[1])
+				- lineTap(&_reverbTankAp2[0], tapR[2])
+				+ lineTap(&_reverbTankDelay2[0], tapR[3])
+				- lineTap(&_reverbTankDelay1[1], tapR[4])
+				- lineTap(&_reverbTankAp2[1], tapR[5])
+				- lineTap(&_reverbTankDelay2[1], tapR[6]);
+
+		left[i] += _reverbMix * outL * REVERB_OUTPUT_GAIN * 0.3;
+		right[i] += _reverbMix * outR * REVERB_OUTPUT_GAIN * 0.3;
+	}
+
+	_reverbBandwidth = bandwidth;
+}
+
+void AudioEffectFxBus::update(void){
+	audio_block_t *blockL = receiveReadOnly(0);
+	audio_block_t *blockR = receiveReadOnly(1);
+	if(_mono){
+		if(blockR) release(blockR);
+		blockR = NULL;
+	}
+
+	if(!_enabled){
+		if(blockL){
+			transmit(blockL, 0);
+			if(_mono) transmit(blockL, 1);
+			release(blockL);
+		}
+		if(blockR){
+			transmit(blockR, 1);
+			release(blockR);
+		}
+		return;
+	}
+
+	audio_block_t *outL = allocate();
+	audio_block_t *outR = allocate();
+	if(!outL || !outR){
+		if(outL) release(outL);
+		if(outR) release(outR);
+		if(blockL) release(blockL);
+		if(blockR) release(blockR);
+		return;
+	}
+
+	// The effects keep running without input, so tails can ring.
+	float in[AUDIO_BLOCK_SAMPLES];
+	float left[AUDIO_BLOCK_SAMPLES];
+	float right[AUDIO_BLOCK_SAMPLES];
+	float wetL[AUDIO_BLOCK_SAMPLES];
+	float wetR[AUDIO_BLOCK_SAMPLES];
+	for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+		float inL = blockL ? blockL->data[i] : 0.0;
+		float inR = _mono ? inL : (blockR ? blockR->data[i] : 0.0);
+		in[i] = (inL + inR) * 0.5;
+		left[i] = _dry * inL;
+		right[i] = _dry * inR;
+		wetL[i] = 0.0;
+		wetR[i] = 0.0;
+	}
+	if(blockL) release(blockL);
+	if(blockR) release(blockR);
+
+	if(_chorusMix > 0.0) processChorus(in, wetL, wetR);
+	if(_delayMix > 0.0) processDelay(in, wetL, wetR);
+	if(_reverbMix > 0.0) processReverb(in, wetL, wetR);
+
+	for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+		outL->data[i] = saturate16(left[i] + _returnL * wetL[i]);
+		outR->data[i] = saturate16(right[i] + _returnR * wetR[i]);
+	}
+
+	transmit(outL, 0);
+	transmit(outR, 1);
+	release(outL);
+	release(outR);
+}
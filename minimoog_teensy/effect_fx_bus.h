@@ -0,0 +1,130 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Post-output effect bus : stereo delay, chorus and plate reverb, for use with the PJRC audio library.
+ *
+ * It takes the stereo output of the synth, and sends its mono sum in parallel to the three effects.
+ * The stereo output is the dry signal of each side plus the effect returns, that can be panned as a whole.
+ *
+ * Memory : every delay line is taken once, at startup, from a fixed size arena.
+ * On Teensy 4.0 this arena lives in the second RAM bank (DMAMEM), so it doesn't eat the RAM used by the code.
+ * The reverb and chorus lines have a fixed size, the stereo delay gets what is left.
+ * Delay lines store 16 bits samples, and are read and written with an integer circular index.
+ * There is no allocation after startup.
+ *
+ * CPU : an effect whose mix is at zero is not computed. When the bus is disabled, the inputs are passed through.
+ */
+
+#ifndef EFFECT_FX_BUS_H
+#define EFFECT_FX_BUS_H
+
+#include <Arduino.h>
+#include <AudioStream.h>
+
+// Size of the arena, in bytes. The delay time available depends on it, and on sample rate.
+const uint32_t FX_ARENA_BYTES = 192 * 1024;
+const uint32_t FX_ARENA_SAMPLES = FX_ARENA_BYTES / sizeof(int16_t);
+
+// A circular buffer, taken from the arena.
+struct FxDelayLine{
+	int16_t *buffer;
+	uint32_t length;
+	uint32_t index;
+};
+
+class AudioEffectFxBus : public AudioStream{
+public:
+	AudioEffectFxBus();
+
+	void enable(bool value);
+	void dry(float level){_dry = level;}
+	// Balance of the effect returns, from -1 (left) to 1 (right).
+	void returnPan(float value);
+	// In mono, the left input feeds both sides, and the right one is not read.
+	void mono(bool value){_mono = value;}
+
+	// Delay time is in milliseconds, clamped to the time available in the arena.
+	void delayTime(float ms);
+	void delayFeedback(float value);
+	void delayMix(float level);
+
+	void chorusRate(float hz);
+	void chorusDepth(float value);
+	void chorusMix(float level);
+
+	// Size sets the reverb decay, from small room to long plate.
+	void reverbSize(float value);
+	void reverbMix(float level);
+
+	// Memory report, in bytes.
+	uint32_t memoryUsed(){return _arenaUsed * sizeof(int16_t);}
+	uint32_t memoryBudget(){return FX_ARENA_BYTES;}
+	float delayMaxTime(){return _delayL.length * 1000.0 / AUDIO_SAMPLE_RATE_EXACT;}
+
+	virtual void update(void);
+
+private:
+	bool take(FxDelayLine *line, uint32_t length);
+	void clear(FxDelayLine *line);
+	uint32_t scaleLength(uint32_t length);
+
+	void processChorus(const float *in, float *left, float *right);
+	void processDelay(const float *in, float *left, float *right);
+	void processReverb(const float *in, float *left, float *right);
+
+	audio_block_t *inputQueueArray[2];
+
+	uint32_t _arenaUsed;
+
+	bool _enabled;
+	bool _mono;
+	float _dry;
+	float _returnL;
+	float _returnR;
+
+	// Stereo delay
+	FxDelayLine _delayL;
+	FxDelayLine _delayR;
+	float _delayTarget;
+	float _delayCurrent;
+	float _delayFeedback;
+	float _delayMix;
+	float _delayDampL;
+	float _delayDampR;
+
+	// Chorus
+	FxDelayLine _chorus;
+	uint32_t _chorusPhase;
+	uint32_t _chorusInc;
+	float _chorusDepth;
+	float _chorusMix;
+
+	// Plate reverb, after Dattorro's topology.
+	FxDelayLine _reverbDiffuser[4];
+	FxDelayLine _reverbTankAp1[2];
+	FxDelayLine _reverbTankDelay1[2];
+	FxDelayLine _reverbTankAp2[2];
+	FxDelayLine _reverbTankDelay2[2];
+	float _reverbDecay;
+	float _reverbDamp[2];
+	float _reverbBandwidth;
+	float _reverbMix;
+};
+
+#endif
@@ -0,0 +1,90 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "key_track.h"
+
+KeyTrack::KeyTrack(){
+	clear();
+}
+
+void KeyTrack::clear(){
+	for(uint8_t i = 0; i < 4; ++i){
+		_held[i] = 0;
+	}
+	_first = KEY_TRACK_NONE;
+	_last = KEY_TRACK_NONE;
+	_count = 0;
+}
+
+void KeyTrack::add(uint8_t note, uint8_t velocity, bool toEnd){
+	if(note > 127) return;
+	if(isHeld(note) && !toEnd){
+		_velocity[note] = velocity;
+		return;
+	}
+	remove(note);
+
+	_velocity[note] = velocity;
+	_previous[note] = _last;
+	_next[note] = KEY_TRACK_NONE;
+	if(_last == KEY_TRACK_NONE){
+		_first = note;
+	} else {
+		_next[_last] = note;
+	}
+	_last = note;
+
+	_held[note >> 5] |= (uint32_t)1 << (note & 0x1F);
+	_count++;
+}
+
+bool KeyTrack::remove(uint8_t note){
+	if(!isHeld(note)) return false;
+
+	uint8_t previous = _previous[note];
+	uint8_t next = _next[note];
+	if(previous == KEY_TRACK_NONE){
+		_first = next;
+	} else {
+		_next[previous] = next;
+	}
+	if(next == KEY_TRACK_NONE){
+		_last = previous;
+	} else {
+		_previous[next] = previous;
+	}
+
+	_held[note >> 5] &= ~((uint32_t)1 << (note & 0x1F));
+	_count--;
+	return true;
+}
+
+int8_t KeyTrack::lower(){
+	for(uint8_t i = 0; i < 4; ++i){
+		if(_held[i]) return (i << 5) + __builtin_ctz(_held[i]);
+	}
+	return -1;
+}
+
+int8_t KeyTrack::upper(){
+	for(int8_t i = 3; i >= 0; --i){
+		if(_held[i]) return (i << 5) + 31 - __builtin_clz(_held[i]);
+	}
+	return -1;
+}
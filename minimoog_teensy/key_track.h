@@ -0,0 +1,68 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/* Key track : the keys held, for note priority.
+ *
+ * Held keys are kept in a 128 bits set, so the lower and upper ones are found with one count of leading
+ * or trailing zeros per 32 bits word. They are also kept in a doubly linked list, in the order they were pressed,
+ * so the first and last ones are known at once, and a key released in the middle is taken out in constant time.
+ * There is no limit on the number of keys held : every MIDI note can be.
+ */
+
+#ifndef KEY_TRACK_H
+#define KEY_TRACK_H
+
+#include <Arduino.h>
+
+const uint8_t KEY_TRACK_NONE = 0xFF;
+
+class KeyTrack{
+public:
+	KeyTrack();
+
+	void clear();
+
+	// A key pressed again takes its new velocity. It goes to the end of the list if toEnd is set,
+	// else it keeps its place : with first note priority, pressing it again must not change its rank.
+	void add(uint8_t note, uint8_t velocity, bool toEnd = true);
+	// Returns false if the key was not held.
+	bool remove(uint8_t note);
+
+	bool isHeld(uint8_t note){return (note < 128) && (_held[note >> 5] & ((uint32_t)1 << (note & 0x1F)));}
+	uint8_t count(){return _count;}
+	uint8_t velocity(uint8_t note){return _velocity[note & 0x7F];}
+
+	// Held keys, -1 when there is none.
+	int8_t lower();
+	int8_t upper();
+	int8_t first(){return (_first == KEY_TRACK_NONE) ? -1 : _first;}
+	int8_t last(){return (_last == KEY_TRACK_NONE) ? -1 : _last;}
+
+private:
+	uint32_t _held[4];
+	uint8_t _velocity[128];
+	uint8_t _previous[128];
+	uint8_t _next[128];
+	uint8_t _first;
+	uint8_t _last;
+	uint8_t _count;
+};
+
+#endif
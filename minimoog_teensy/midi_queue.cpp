@@ -0,0 +1,148 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "midi_queue.h"
+
+MidiQueue::MidiQueue(){
+	_head = 0;
+	_tail = 0;
+	_overflows = 0;
+	for(uint8_t i = 0; i < 4; ++i){
+		_ccPending[i] = 0;
+	}
+	_noteOn = 0;
+	_noteOff = 0;
+	_pitchBend = 0;
+	_controlChange = 0;
+}
+
+void MidiQueue::push(uint8_t type, uint8_t channel, uint8_t data1, int16_t data2){
+	uint8_t next = (_head + 1) & (MIDI_QUEUE_SIZE - 1);
+	if(next == _tail){
+		_overflows = _overflows + 1;
+		return;
+	}
+	_events[_head].type = type;
+	_events[_head].channel = channel;
+	_events[_head].data1 = data1;
+	_events[_head].data2 = data2;
+	_head = next;
+}
+
+// Free places in the ring.
+uint16_t MidiQueue::room(){
+	return (_tail - _head - 1) & (MIDI_QUEUE_SIZE - 1);
+}
+
+void MidiQueue::noteOn(uint8_t channel, uint8_t note, uint8_t velocity){
+	push(MIDI_EVENT_NOTE_ON, channel, note, velocity);
+}
+
+void MidiQueue::noteOff(uint8_t channel, uint8_t note, uint8_t velocity){
+	push(MIDI_EVENT_NOTE_OFF, channel, note, velocity);
+}
+
+void MidiQueue::pitchBend(uint8_t channel, int16_t bend){
+	push(MIDI_EVENT_PITCH_BEND, channel, 0, bend);
+}
+
+void MidiQueue::controlChange(uint8_t channel, uint8_t command, uint8_t value, bool ordered){
+	if(command > 127) return;
+	if(ordered){
+		// An action changes how the next controls are handled (function mode...) :
+		// the controls waiting are put in order before it, if they fit besides the room kept for notes.
+		uint8_t waiting = 0;
+		for(uint8_t i = 0; i < 4; ++i){
+			waiting += __builtin_popcount(_ccPending[i]);
+		}
+		bool fits = (waiting + MIDI_QUEUE_RESERVE) <= room();
+		for(uint8_t i = 0; (i < 4) && fits; ++i){
+			uint32_t pending = _ccPending[i];
+			_ccPending[i] = 0;
+			while(pending){
+				uint8_t cc = (i << 5) + __builtin_ctz(pending);
+				pending &= pending - 1;
+				push(MIDI_EVENT_CONTROL_CHANGE, _ccChannel[cc], cc, _ccValue[cc]);
+			}
+		}
+		push(MIDI_EVENT_CONTROL_CHANGE, channel, command, value);
+		return;
+	}
+	_ccValue[command] = value;
+	_ccChannel[command] = channel;
+	_ccPending[command >> 5] |= (uint32_t)1 << (command & 0x1F);
+}
+
+// Only the main loop moves the tail.
+void MidiQueue::dispatchEvents(){
+	while(_tail != _head){
+		uint8_t type = _events[_tail].type;
+		uint8_t channel = _events[_tail].channel;
+		uint8_t data1 = _events[_tail].data1;
+		int16_t data2 = _events[_tail].data2;
+		_tail = (_tail + 1) & (MIDI_QUEUE_SIZE - 1);
+
+		switch(type){
+			case MIDI_EVENT_NOTE_ON:
+				if(_noteOn) _noteOn(channel, data1, data2);
+				break;
+			case MIDI_EVENT_NOTE_OFF:
+				if(_noteOff) _noteOff(channel, data1, data2);
+				break;
+			case MIDI_EVENT_PITCH_BEND:
+				if(_pitchBend) _pitchBend(channel, data2);
+				break;
+			case MIDI_EVENT_CONTROL_CHANGE:
+				if(_controlChange) _controlChange(channel, data1, data2);
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+// The pending bits and their values are all taken at once, with interrupts off, before any is applied :
+// a 14 bits control sent while the handlers run has its MSB and LSB both kept for the next dispatch, so its
+// LSB is never applied with the MSB it replaced.
+void MidiQueue::dispatchControls(){
+	uint32_t pending[4];
+	uint8_t value[128];
+	uint8_t channel[128];
+	noInterrupts();
+	for(uint8_t i = 0; i < 4; ++i){
+		pending[i] = _ccPending[i];
+		_ccPending[i] = 0;
+		uint32_t bits = pending[i];
+		while(bits){
+			uint8_t cc = (i << 5) + __builtin_ctz(bits);
+			bits &= bits - 1;
+			value[cc] = _ccValue[cc];
+			channel[cc] = _ccChannel[cc];
+		}
+	}
+	interrupts();
+
+	for(uint8_t i = 0; i < 4; ++i){
+		while(pending[i]){
+			uint8_t cc = (i << 5) + __builtin_ctz(pending[i]);
+			pending[i] &= pending[i] - 1;
+			if(_controlChange) _controlChange(channel[cc], cc, value[cc]);
+		}
+	}
+}
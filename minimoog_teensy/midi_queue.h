@@ -0,0 +1,102 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Receive queue for one MIDI source (a Mega, or usb MIDI).
+ *
+ * MIDI messages are read from a timer interrupt, and pushed here. The main loop then dispatches them.
+ * Notes, pitch bend, and control changes that are an action rather than a setting (transpose, function...)
+ * are kept in order in a ring buffer. Other control changes only keep their last value : when a knob is
+ * turned fast, only its latest position is applied. The ordered events are dispatched first, so a flood of
+ * control changes never delays a note.
+ *
+ * When an ordered control change comes, the control changes waiting are put in the ring before it. There are
+ * at most 128 of them, the ring is sized so that they fit, and they never take the last MIDI_QUEUE_RESERVE
+ * places : those are for notes. If there is not enough room, they stay waiting, and are applied after.
+ */
+
+#ifndef MIDI_QUEUE_H
+#define MIDI_QUEUE_H
+
+#include <Arduino.h>
+
+// Must be a power of 2, up to 256.
+const uint16_t MIDI_QUEUE_SIZE = 256;
+// Places that control changes never take.
+const uint16_t MIDI_QUEUE_RESERVE = 64;
+
+enum midiEventType_t{
+	MIDI_EVENT_NOTE_ON = 0,
+	MIDI_EVENT_NOTE_OFF,
+	MIDI_EVENT_PITCH_BEND,
+	MIDI_EVENT_CONTROL_CHANGE,
+};
+
+struct midiEvent_t{
+	uint8_t type;
+	uint8_t channel;
+	uint8_t data1;
+	int16_t data2;
+};
+
+class MidiQueue{
+public:
+	MidiQueue();
+
+	// Called from the interrupt that reads MIDI.
+	// An ordered control change is kept in order with notes, the others are coalesced.
+	void noteOn(uint8_t channel, uint8_t note, uint8_t velocity);
+	void noteOff(uint8_t channel, uint8_t note, uint8_t velocity);
+	void pitchBend(uint8_t channel, int16_t bend);
+	void controlChange(uint8_t channel, uint8_t command, uint8_t value, bool ordered = 0);
+
+	// Called from the main loop. Ordered events, in the order they came.
+	void dispatchEvents();
+	// Called from the main loop. The last value of each control change, in increasing control number,
+	// so 14 bits values have their MSB before their LSB.
+	void dispatchControls();
+
+	void setHandleNoteOn(void (*f)(uint8_t, uint8_t, uint8_t)){_noteOn = f;}
+	void setHandleNoteOff(void (*f)(uint8_t, uint8_t, uint8_t)){_noteOff = f;}
+	void setHandlePitchBend(void (*f)(uint8_t, int16_t)){_pitchBend = f;}
+	void setHandleControlChange(void (*f)(uint8_t, uint8_t, uint8_t)){_controlChange = f;}
+
+	// Events lost because the ring buffer was full.
+	uint32_t overflows(){return _overflows;}
+
+private:
+	void push(uint8_t type, uint8_t channel, uint8_t data1, int16_t data2);
+	uint16_t room();
+
+	volatile midiEvent_t _events[MIDI_QUEUE_SIZE];
+	volatile uint8_t _head;
+	volatile uint8_t _tail;
+	volatile uint32_t _overflows;
+
+	// Coalesced control changes : last value and channel, and a bit set for each one waiting.
+	volatile uint8_t _ccValue[128];
+	volatile uint8_t _ccChannel[128];
+	volatile uint32_t _ccPending[4];
+
+	void (*_noteOn)(uint8_t, uint8_t, uint8_t);
+	void (*_noteOff)(uint8_t, uint8_t, uint8_t);
+	void (*_pitchBend)(uint8_t, int16_t);
+	void (*_controlChange)(uint8_t, uint8_t, uint8_t);
+};
+
+#endif
@@ -51,25 +51,23 @@
 
 #include "audio_setup.h"
 #include "defs.h"
+#include "midi_queue.h"
+#include "key_track.h"
 
 #include "MIDI.h"					// https://github.com/troisiemetype/PushButton
 // #include "Timer.h"
 
 // constants
 
-const int8_t MEMORY_ID = 0;
+const int8_t MEMORY_ID = 3;
 
-// my pots never go full clockwise... :/ So this can be used to adapt their range.
+// Resolution of the controls. The Megas send calibrated 12 bits values, see adc_scan.h in their sketches.
 // These two commented out values for testing with external midi triggering (like puredata).
 //const uint16_t RESO = 127;
 //const uint16_t RESO = 16383;
-const uint16_t RESO = 1005;
+const uint16_t RESO = 4095;
 const uint16_t HALF_RESO = RESO / 2;
 
-// There is a function that handles and tracks the key presses. Here is the max.
-// It can me more, but whith ten fingers on a monophonic synth, I think this is enough !
-const uint8_t KEYTRACK_MAX = 10;
-
 // Mega1 sends midi note 0 for the lower note ; we offset it by for octave to get into the usefull range
 const uint8_t MIDI_OFFSET = 48;
 // To be modified according to keybed used. It's actualy not used, and any note can be handled from MIDI in.
@@ -84,6 +82,8 @@ const float NOTE_MIDI_0 = 8.1757989156434;
 const float NOTE_RATIO = 1.0594630943593;
 const float HALFTONE_TO_DC = (float)1 / (MAX_OCTAVE * 12);
 const float FILTER_HALFTONE_TO_DC = (float)1 / (FILTER_MAX_OCTAVE * 12);
+// Pitch bend values are ramped to over this time, about the time between two readings of the wheel by Mega 1.
+const float PITCH_BEND_RAMP_MS = 3.0;
 
 // Filter base frequency : the filter cutoff frequency varies around this value.
 const float FILTER_BASE_FREQUENCY = 440.0;
@@ -108,29 +108,37 @@ const float FILTER_DIV_Q = RESO / (FILTER_MAX_Q - FILTER_MIN_Q);
 // but with this value the difference with and without feedback is barrely noticeable.
 const float MAX_MIX = 0.32;
 
-// To be put in Mega1 sketch, so it sends a value on 14 bits.
-// Note : the pitchbend wheel poses problems on the other sketch. For now it will stay like that,
-// but there is room for improvement.
-//343 - 492 - 500 - 651
-const int16_t PITCH_BEND_MIN = 343;
-const int16_t PITCH_BEND_MAX = 651;
-const int16_t PITCH_BEND_NEUTRAL = PITCH_BEND_MIN + (PITCH_BEND_MAX - PITCH_BEND_MIN) / 2;
-const int16_t PITCH_BEND_COURSE = PITCH_BEND_MAX - PITCH_BEND_MIN;
-const float PITCH_BEND_INTERNAL_TO_MIDI = 8192.0 / PITCH_BEND_COURSE;
-
 // Maximum attack, decay, release and glide time (in milliseconds)
 // These use an exponential course to have both fine-tune of low values and a great range.
 const float MAX_ATTACK_TIME = 10000;
 const float MAX_DECAY_TIME = 10000;
 const float MAX_RELEASE_TIME = 10000;
 const float MAX_GLIDE_TIME = 10000;
-/*
-// Moved to Mega 1
-const uint16_t MOD_WHEEL_MIN = 360;
-const uint16_t MOD_WHEEL_MAX = 666;
-const uint16_t MOD_WHEEL_NEUTRAL = MOD_WHEEL_MIN + (MOD_WHEEL_MAX - MOD_WHEEL_MIN) / 2;
-const uint16_t MOD_WHEEL_COURSE = MOD_WHEEL_MAX - MOD_WHEEL_MIN;
-*/
+
+// Stereo : the right filter can be up to this many octaves away from the left one,
+// and the right envelope this much slower (as a ratio of the left envelope times).
+const float STEREO_MAX_FILTER_OFFSET = 1.0;
+const float STEREO_MAX_ENVELOPE_OFFSET = 0.5;
+
+// Sequencer tempo range, in beats per minute, and steps per beat available.
+const float SEQUENCER_MIN_TEMPO = 40.0;
+const float SEQUENCER_MAX_TEMPO = 300.0;
+const uint8_t SEQUENCER_DIVISIONS[6] = {1, 2, 3, 4, 6, 8};
+
+// Effect bus settings. Delay time is bounded by the memory given to the bus, see effect_fx_bus.h.
+const float FX_CHORUS_MIN_RATE = 0.05;
+const float FX_CHORUS_MAX_RATE = 5.0;
+
+// Panel state is saved this long after the last control moved, so moving a knob doesn't write memory continuously.
+const uint16_t PANEL_SAVE_DELAY = 5000;
+// Panel state is asked to the Megas until they answer, they may still be starting.
+const uint16_t PANEL_REQUEST_DELAY = 250;
+// Value of a control whose state is not known.
+const uint8_t PANEL_UNKNOWN = 0xFF;
+
+// Set to true to print CPU and memory usage to the serial port, every REPORT_DELAY milliseconds.
+const bool REPORT_USAGE = false;
+const uint16_t REPORT_DELAY = 2000;
 
 // Teensy can reset both Mega, if needed.
 const uint8_t MEGA1_RST = 2;
@@ -148,7 +156,13 @@ const uint16_t EE_FILTER_MODE = 9;
 const uint16_t EE_PITCH_BEND_RANGE = 10;
 const uint16_t EE_MOD_WHEEL_OSC_RANGE = 11;
 const uint16_t EE_MOD_WHEEL_FILTER_RANGE = 12;
+const uint16_t EE_OSC_MODE = 13;
+const uint16_t EE_SEQUENCER_MODE = 14;
 const uint16_t EE_DETUNE_TABLE_ADD = 20;
+// The detune table takes 128 floats.
+const uint16_t EE_PANEL_STATE_ADD = EE_DETUNE_TABLE_ADD + 128 * 4;
+// The sequencer pattern : its length, then note and velocity of each step.
+const uint16_t EE_SEQUENCER_PATTERN_ADD = EE_PANEL_STATE_ADD + 128;
 
 // variables
 // Note : 
@@ -179,6 +193,19 @@ float egDecay = 0;
 // Stores the current band value, for recall when the band mode is changed.
 int16_t filterBandValue = 0;
 
+// Main envelope times, for recall when the stereo envelope offset is changed.
+// The right envelope times are these, multiplied by envelopeRatio.
+float egAttackTime = 10;
+float egDecayTime = 25;
+float egReleaseTime = 100;
+float envelopeRatio = 1.0;
+
+// Stereo controls that are off center, one bit each : the pans use the bit of their stereo mixer input.
+// While none is, both sides would be the same : the right side is not computed, and the left one feeds both outputs.
+const uint8_t STEREO_SPREAD_FILTER = 4;
+const uint8_t STEREO_SPREAD_ENVELOPE = 5;
+uint8_t stereoSpread = 0;
+
 uint8_t pitchBendRange = 3;
 uint8_t modWheelOscRange = 3;
 uint8_t modWheelFilterRange = 12;
@@ -186,6 +213,15 @@ uint8_t modWheelFilterRange = 12;
 // Waveforms
 uint8_t waveforms[6] = {WAVEFORM_SINE, WAVEFORM_TRIANGLE, WAVEFORM_SAWTOOTH,
 						WAVEFORM_SAWTOOTH_REVERSE, WAVEFORM_SQUARE, WAVEFORM_PULSE};
+// Waveform selectors position, for recall when the oscillator mode is changed.
+uint8_t oscWaveform[3] = {1, 2, 4};
+
+enum oscMode_t{
+	OSC_MODE_CLASSIC = 0,
+	OSC_MODE_WAVETABLE,
+};
+
+oscMode_t oscMode = OSC_MODE_CLASSIC;
 // detune table. For emulating resistor-ladder keybed and induce key detuning.
 float detuneTable[128];
 // keyTrack
@@ -195,12 +231,9 @@ float detuneTable[128];
  *	The other (this one) is a system tracks key being pressed to send not according to note priority setting.
  * A better name for one or the other should be found...
  */
-uint8_t keyTrackIndex = 0;
-struct {
-	uint8_t key;
-	uint8_t velocity;
-} keyTrack[KEYTRACK_MAX];
+KeyTrack keyTrack;
 
+// The note sounding, -1 when it has been released.
 int8_t nowPlaying = -1;
 
 // double CC track
@@ -217,6 +250,9 @@ enum function_t{
 	FUNCTION_PITCH_BEND_RANGE,
 	FUNCTION_MOD_WHEEL_OSC_RANGE,
 	FUNCTION_MOD_WHEEL_FILTER_RANGE,
+	FUNCTION_OSC_MODE,
+	FUNCTION_CALIBRATE,
+	FUNCTION_SEQUENCER,
 };
 
 function_t currentFunction = FUNCTION_KEYBOARD_MODE;
@@ -250,9 +286,39 @@ filterMode_t filterMode = FILTER_BAND_PASS;
 
 uint8_t bitCrushLevel = 16;
 
+uint32_t lastReport = 0;
+
+// Panel state : the last value received from the Megas for each control change.
+// It is saved in permanent memory, so the synth sounds as the panel is set as soon as it starts.
+uint8_t panelState[128];
+bool panelChanged = 0;
+uint32_t panelChangeTime = 0;
+volatile bool panelSynced[2] = {0, 0};
+uint32_t panelRequestTime = 0;
+
+// Boot times, in milliseconds from power up.
+uint32_t panelRestoredTime = 0;
+volatile uint32_t panelSyncedTime = 0;
+uint32_t firstNoteTime = 0;
+
+// MIDI from the Megas is read from a timer interrupt, into one queue per source, and dispatched from the main loop.
+// Each read drains at most MIDI_READ_MAX messages from a source, so the interrupt stays short.
+// USB MIDI is read from the main loop into its queue : usbMIDI is not reentrant, and the main loop sends to it.
+const uint16_t MIDI_READ_PERIOD = 500;
+const uint8_t MIDI_READ_MAX = 16;
+IntervalTimer midiTimer;
+// The MIDI library is not reentrant either : while the main loop sends to the Megas, the timer doesn't read them.
+// Their messages wait in the serial buffers.
+volatile bool megaSending = 0;
+MidiQueue mega1Queue;
+MidiQueue mega2Queue;
+MidiQueue usbQueue;
+
 struct midiSettings : public midi::DefaultSettings{
 //	static const bool UseRunningStatus = true;
 	static const long BaudRate = 115200;
+	// The panel state frames are a bit longer than the default.
+	static const unsigned SysExMaxSize = 300;
 };
 
 // USB midi for sending and receiving to and from other device or computer.
@@ -290,6 +356,13 @@ void initMemory(){
 	EEPROM.write(EE_PITCH_BEND_RANGE, pitchBendRange);
 	EEPROM.write(EE_MOD_WHEEL_OSC_RANGE, modWheelOscRange);
 	EEPROM.write(EE_MOD_WHEEL_FILTER_RANGE, modWheelFilterRange);
+	EEPROM.write(EE_OSC_MODE, OSC_MODE_CLASSIC);
+	EEPROM.write(EE_SEQUENCER_MODE, SEQUENCER_OFF);
+	EEPROM.write(EE_SEQUENCER_PATTERN_ADD, 0);
+
+	for(uint8_t i = 0; i < 128; ++i){
+		EEPROM.write(EE_PANEL_STATE_ADD + i, PANEL_UNKNOWN);
+	}
 
 	resetDetuneTable();
 }
@@ -323,6 +396,7 @@ void loadMemory(){
 	EEPROM.get(EE_PITCH_BEND_RANGE, pitchBendRange);
 	EEPROM.get(EE_MOD_WHEEL_OSC_RANGE, modWheelOscRange);
 	EEPROM.get(EE_MOD_WHEEL_FILTER_RANGE, modWheelFilterRange);
+	EEPROM.get(EE_OSC_MODE, oscMode);
 
 	uint16_t address = EE_DETUNE_TABLE_ADD;
 	for(uint16_t i = 0; i < 128; ++i){
@@ -330,6 +404,18 @@ void loadMemory(){
 		address += 4;
 	}
 
+	EEPROM.get(EE_PANEL_STATE_ADD, panelState);
+
+	sequencerMode_t sequencerMode;
+	EEPROM.get(EE_SEQUENCER_MODE, sequencerMode);
+	// Recording is not resumed at power up.
+	if(sequencerMode == SEQUENCER_RECORD) sequencerMode = SEQUENCER_PLAY;
+	sequencer.mode(sequencerMode);
+	uint8_t length = EEPROM.read(EE_SEQUENCER_PATTERN_ADD);
+	for(uint8_t i = 0; (i < length) && (i < SEQUENCER_MAX_STEPS); ++i){
+		sequencer.addStep(EEPROM.read(EE_SEQUENCER_PATTERN_ADD + 1 + 2 * i), EEPROM.read(EE_SEQUENCER_PATTERN_ADD + 2 + 2 * i));
+	}
+
 }
 
 void setup() {
@@ -346,16 +432,24 @@ void setup() {
 	digitalWrite(MEGA2_RST, 1);
 
 	// midi settings, start and callback
+	// The MIDI callbacks only fill the queues, the queues call the handlers from the main loop.
 	midi1.begin(1);
 	midi1.turnThruOff();
-	midi1.setHandleNoteOn(handleInternalNoteOn);
-	midi1.setHandleNoteOff(handleInternalNoteOff);
-	midi1.setHandlePitchBend(handleInternalPitchBend);
-	midi1.setHandleControlChange(handleControlChange);
+	midi1.setHandleNoteOn(queueMega1NoteOn);
+	midi1.setHandleNoteOff(queueMega1NoteOff);
+	midi1.setHandlePitchBend(queueMega1PitchBend);
+	midi1.setHandleControlChange(queueMega1ControlChange);
+	midi1.setHandleSystemExclusive(handleMega1SysEx);
+	mega1Queue.setHandleNoteOn(handleInternalNoteOn);
+	mega1Queue.setHandleNoteOff(handleInternalNoteOff);
+	mega1Queue.setHandlePitchBend(handleInternalPitchBend);
+	mega1Queue.setHandleControlChange(handleInternalControlChange);
 
 	midi2.begin(1);
 	midi2.turnThruOff();
-	midi2.setHandleControlChange(handleControlChange);
+	midi2.setHandleControlChange(queueMega2ControlChange);
+	midi2.setHandleSystemExclusive(handleMega2SysEx);
+	mega2Queue.setHandleControlChange(handleInternalControlChange);
 /*
 	Serial.begin(115200);
 	Serial.println("started...");
@@ -364,14 +458,24 @@ void setup() {
 	loadMemory();
 
 	// TODO : check how to receive and transmit on different channels.
-	usbMIDI.setHandleNoteOn(handleNoteOn);
-	usbMIDI.setHandleNoteOff(handleNoteOff);
-	usbMIDI.setHandlePitchChange(handlePitchBend);
+	usbMIDI.setHandleNoteOn(queueUsbNoteOn);
+	usbMIDI.setHandleNoteOff(queueUsbNoteOff);
+	usbMIDI.setHandlePitchChange(queueUsbPitchBend);
 //	usbMIDI.setHandleNoteOn(handleInternalNoteOn);
 //	usbMIDI.setHandleNoteOff(handleInternalNoteOff);
 //	usbMIDI.setHandlePitchBend(handleInternalPitchBend);
 //	usbMIDI.setHandleControlChange(handleControlChange);
+	usbMIDI.setHandleControlChange(queueUsbControlChange);
+	// MIDI clock is not queued : the sequencer timestamps it as soon as it's read.
+	usbMIDI.setHandleClock(handleClock);
+	usbMIDI.setHandleStart(handleStart);
+	usbMIDI.setHandleStop(handleStop);
+	usbMIDI.setHandleContinue(handleContinue);
 	usbMIDI.begin();
+	usbQueue.setHandleNoteOn(handleNoteOn);
+	usbQueue.setHandleNoteOff(handleNoteOff);
+	usbQueue.setHandlePitchBend(handlePitchBend);
+	usbQueue.setHandleControlChange(handleUsbControlChange);
 
 	AudioMemory(200);
 
@@ -379,7 +483,6 @@ void setup() {
 	// dc
 	dcKeyTrack.amplitude(0.0);
 	dcPitchBend.amplitude(0.0);
-	dcFilterEnvelope.amplitude(1.0);
 	dcFilter.amplitude(0.0);
 	dcFilterKeyTrack.amplitude(0.0);
 	dcOsc3.amplitude(0.2);
@@ -387,23 +490,26 @@ void setup() {
 	dcOscTune.amplitude(0.0);
 	dcOsc2Tune.amplitude(0.0);
 	dcOsc3Tune.amplitude(0.0);
-	dcPulse.amplitude(-0.95);
 
 	// amp
 	ampPitchBend.gain(pitchBendRange * HALFTONE_TO_DC * 2);
 	ampModWheelOsc.gain(0.0);
 	ampModWheelFilter.gain(0.0);
-	ampPreFilter.gain(1.0);
 	ampModEg.gain(0.1);
 	ampOsc3Mod.gain(1);
 	masterVolume.gain(1.0);
+	masterVolumeRight.gain(1.0);
 
-	osc1Waveform.frequencyModulation(MAX_OCTAVE);
-	osc2Waveform.frequencyModulation(MAX_OCTAVE);
-	osc3Waveform.frequencyModulation(MAX_OCTAVE);
-	osc1Waveform.begin(1, NOTE_MIDI_0, WAVEFORM_TRIANGLE);
-	osc2Waveform.begin(1, NOTE_MIDI_0, WAVEFORM_SAWTOOTH);
-	osc3Waveform.begin(1, NOTE_MIDI_0, WAVEFORM_SQUARE);
+	oscillators.rangeBase(NOTE_MIDI_0);
+	for(uint8_t i = 0; i < 3; ++i){
+		oscillators.frequencyModulation(i, MAX_OCTAVE);
+		oscillators.begin(i, 1, NOTE_MIDI_0, WAVEFORM_SINE);
+		setOscWaveform(i, oscWaveform[i]);
+	}
+	oscillators.pulseWidth(-0.95);
+	oscillators.sync(1, false);
+	oscillators.sync(2, false);
+	oscillators.fmAmount(0.0);
 
 	// noise
 	whiteNoise.amplitude(1);
@@ -423,14 +529,17 @@ void setup() {
 	osc3TuneMixer.gain(0, 1);
 	osc3TuneMixer.gain(1, 1);
 
-	oscMixer.gain(0, 1);
-	oscMixer.gain(1, 0);
-	oscMixer.gain(2, 0);
-	oscMixer.gain(3, 0);
-
-	globalMixer.gain(0, 1);
-	globalMixer.gain(1, 0);
-	globalMixer.gain(2, 1);
+	// Sources are centered, the feedback of each side goes back to its own side.
+	stereoMixer.gain(0, 1);
+	stereoMixer.gain(1, 0);
+	stereoMixer.gain(2, 0);
+	stereoMixer.gain(3, 0);
+	stereoMixer.gain(4, 0);
+	stereoMixer.gain(5, 0);
+	stereoMixer.pan(4, -1.0);
+	stereoMixer.pan(5, 1.0);
+	// Nothing is off center yet : the right side is not computed (see setStereoSpread()).
+	stereoMixer.mono(true);
 
 	noiseMixer.gain(0, 1);
 	noiseMixer.gain(1, 0);
@@ -450,49 +559,64 @@ void setup() {
 	filterMixer.gain(2, 1);
 	filterMixer.gain(3, 0);
 
-	bandMixer.gain(0, 1);
-	bandMixer.gain(1, 0);
-	bandMixer.gain(2, 0);
+	setFilterBand();
 
 	// filter
 	vcf.frequency(FILTER_BASE_FREQUENCY);
 	vcf.resonance(0.7);
 	vcf.octaveControl(FILTER_MAX_OCTAVE);
+	vcfRight.frequency(FILTER_BASE_FREQUENCY);
+	vcfRight.resonance(0.7);
+	vcfRight.octaveControl(FILTER_MAX_OCTAVE);
 
 	// envelopes
-	mainEnvelope.delay(0);
-	mainEnvelope.attack(10);
-	mainEnvelope.hold(0);
-	mainEnvelope.decay(25);
+	// They are exponential, like analog RC envelopes. The filter one is a generator, it has no input.
+	setMainEnvelope();
 	mainEnvelope.sustain(0.9);
-	mainEnvelope.release(100);
+	mainEnvelopeRight.sustain(0.9);
 
-	filterEnvelope.delay(0);
+	filterEnvelope.generator(true);
 	filterEnvelope.attack(200);
-	filterEnvelope.hold(0);
 	filterEnvelope.decay(100);
 	filterEnvelope.sustain(0.8);
 	filterEnvelope.release(50);
 
 	bitCrushOutput.bits(16);
-	bitCrushOutput.sampleRate(44100.0);
-
-	delay(500);
+	bitCrushOutput.sampleRate(AUDIO_SAMPLE_RATE_EXACT);
+	bitCrushOutputRight.bits(16);
+	bitCrushOutputRight.sampleRate(AUDIO_SAMPLE_RATE_EXACT);
+
+	// effects. The bus is off until turned on by its CC.
+	fxBus.dry(1.0);
+	fxBus.returnPan(0.0);
+	fxBus.mono(true);
+	fxBus.delayTime(300);
+	fxBus.delayFeedback(0.3);
+	fxBus.delayMix(0.0);
+	fxBus.chorusRate(0.5);
+	fxBus.chorusDepth(0.5);
+	fxBus.chorusMix(0.0);
+	fxBus.reverbSize(0.5);
+	fxBus.reverbMix(0.0);
+	fxBus.enable(false);
+
+	// sequencer. It plays the notes from the audio update, at the sample they are due.
+	sequencer.setHandleNoteOn(handleSequencerNoteOn);
+	sequencer.setHandleNoteOff(handleSequencerNoteOff);
+	sequencer.tempo(120);
+	sequencer.division(4);
+	sequencer.gate(0.5);
+	sequencer.octaves(1);
+	sequencer.externalClock(false);
+
+	// The synth sounds as the panel was last set, then the Megas send what has changed since.
+	// They are asked from the main loop, as they may still be starting.
+	restorePanel();
+	panelRestoredTime = millis();
+
+	midiTimer.begin(readMidi, MIDI_READ_PERIOD);
 
 	digitalWrite(13, 0);
-	delay(200);
-
-// Blink. For debug. And letting a bit more time to Mega 1 to start.
-	for(uint8_t i = 0; i < 5; ++i){
-		digitalWrite(13, 1);
-		delay(100);
-		digitalWrite(13, 0);
-		delay(50);
-	}
-
-//	Serial.println("asking for all controls");
-	midi1.sendControlChange(CC_ASK_FOR_DATA, 127, 1);
-	midi2.sendControlChange(CC_ASK_FOR_DATA, 127, 1);
 
 
 /*
@@ -511,9 +635,17 @@ void setup() {
 }
 
 void loop() {
-	midi1.read();
-	midi2.read();
-	usbMIDI.read(midiInChannel);
+	for(uint8_t i = 0; (i < MIDI_READ_MAX) && usbMIDI.read(midiInChannel); ++i);
+
+	// Notes, pitch bend and actions of every source first, then the last value of the controls that moved.
+	mega1Queue.dispatchEvents();
+	mega2Queue.dispatchEvents();
+	usbQueue.dispatchEvents();
+	mega1Queue.dispatchControls();
+	mega2Queue.dispatchControls();
+	usbQueue.dispatchControls();
+
+	updatePanel();
 /*
 	if(timerCPU.update()){
 		Serial.print("cpu usage :");
@@ -534,16 +666,218 @@ void loop() {
 */
 
 //	if(timerGraph.update()) printPostFilter.trigger();
+
+	if(REPORT_USAGE && ((millis() - lastReport) > REPORT_DELAY)){
+		lastReport = millis();
+		reportUsage();
+	}
+}
+
+// Print CPU and memory usage, for the whole audio graph and for the effect bus,
+// so we can see what fits alongside the voice.
+void reportUsage(){
+	// Time spent on each block : comparing the time per sample between two block sizes gives the cost
+	// that smaller blocks add.
+	float blockTime = AudioProcessorUsage() * AUDIO_BLOCK_TIME / 100.0;
+	Serial.print("audio : ");
+	Serial.print(AUDIO_BLOCK_SAMPLES);
+	Serial.print(" samples blocks at ");
+	Serial.print(AUDIO_SAMPLE_RATE_EXACT);
+	Serial.print("Hz, ");
+	Serial.print(AUDIO_BLOCK_TIME);
+	Serial.println("us per block");
+	Serial.print("audio time : ");
+	Serial.print(blockTime);
+	Serial.print("us per block, ");
+	Serial.print(blockTime * 1000.0 / AUDIO_BLOCK_SAMPLES);
+	Serial.println("ns per sample");
+	Serial.print("audio cpu : ");
+	Serial.print(AudioProcessorUsage());
+	Serial.print("% (max ");
+	Serial.print(AudioProcessorUsageMax());
+	Serial.println("%)");
+	Serial.print("audio blocks : ");
+	Serial.println(AudioMemoryUsageMax());
+
+	Serial.print("fx cpu : ");
+	Serial.print(fxBus.processorUsage());
+	Serial.print("% (max ");
+	Serial.print(fxBus.processorUsageMax());
+	Serial.println("%)");
+	Serial.print("fx memory : ");
+	Serial.print(fxBus.memoryUsed());
+	Serial.print(" / ");
+	Serial.print(fxBus.memoryBudget());
+	Serial.print(" bytes, delay up to ");
+	Serial.print(fxBus.delayMaxTime());
+	Serial.println("ms");
+
+	Serial.print("boot : panel restored at ");
+	Serial.print(panelRestoredTime);
+	Serial.print("ms, megas synced at ");
+	Serial.print(panelSyncedTime);
+	Serial.print("ms, first note at ");
+	Serial.print(firstNoteTime);
+	Serial.println("ms");
+}
+
+// Apply the panel state saved in memory, as if the Megas had sent it.
+// Control changes are sent in order, so each 14-bits value has its MSB before its LSB.
+void restorePanel(){
+	for(uint8_t i = 0; i < 128; ++i){
+		if(panelState[i] == PANEL_UNKNOWN) continue;
+		handleControlChange(1, i, panelState[i]);
+	}
+}
+
+// Ask the Megas for the panel state until they answer, and save it when it has changed.
+void updatePanel(){
+	if((!panelSynced[0] || !panelSynced[1]) && ((millis() - panelRequestTime) > PANEL_REQUEST_DELAY)){
+		panelRequestTime = millis();
+		uint8_t frame[2 + 2 * 128];
+		uint16_t length = panelRequestFrame(frame);
+		megaSendBegin();
+		if(!panelSynced[0]) midi1.sendSysEx(length, frame);
+		if(!panelSynced[1]) midi2.sendSysEx(length, frame);
+		megaSendEnd();
+	}
+
+	if(panelChanged && ((millis() - panelChangeTime) > PANEL_SAVE_DELAY)){
+		panelChanged = 0;
+		for(uint8_t i = 0; i < 128; ++i){
+			EEPROM.update(EE_PANEL_STATE_ADD + i, panelState[i]);
+		}
+	}
+}
+
+// Build the frame that sends our panel state to a Mega. It answers with a frame holding only the controls that differ.
+// Frame : SYSEX_ID, SYSEX_STATE_REQUEST, then control change and value for every known control.
+uint16_t panelRequestFrame(uint8_t *frame){
+	uint16_t length = 0;
+	frame[length++] = SYSEX_ID;
+	frame[length++] = SYSEX_STATE_REQUEST;
+	for(uint8_t i = 0; i < 128; ++i){
+		if(panelState[i] == PANEL_UNKNOWN) continue;
+		frame[length++] = i;
+		frame[length++] = panelState[i];
+	}
+	return length;
+}
+
+// Read the Megas, from the timer interrupt.
+void readMidi(){
+	if(megaSending) return;
+	for(uint8_t i = 0; (i < MIDI_READ_MAX) && midi1.read(); ++i);
+	for(uint8_t i = 0; (i < MIDI_READ_MAX) && midi2.read(); ++i);
+}
+
+// Sending to the Megas from the main loop. Interrupts are only turned off to set the flag :
+// the timer can't be in the middle of a read then, as it interrupts the main loop and not the other way round.
+void megaSendBegin(){
+	noInterrupts();
+	megaSending = 1;
+	interrupts();
+}
+
+void megaSendEnd(){
+	noInterrupts();
+	megaSending = 0;
+	interrupts();
+}
+
+// MIDI callbacks, called from the timer interrupt (Megas) or the main loop (USB) : they only queue the message.
+// Controls that are not a state (transpose, function...) are an action, they are kept in order with the notes.
+void queueMega1NoteOn(uint8_t channel, uint8_t note, uint8_t velocity){
+	mega1Queue.noteOn(channel, note, velocity);
+}
+
+void queueMega1NoteOff(uint8_t channel, uint8_t note, uint8_t velocity){
+	mega1Queue.noteOff(channel, note, velocity);
+}
+
+void queueMega1PitchBend(uint8_t channel, int bend){
+	mega1Queue.pitchBend(channel, bend);
+}
+
+void queueMega1ControlChange(uint8_t channel, uint8_t command, uint8_t value){
+	mega1Queue.controlChange(channel, command, value, !isPanelControl(command));
+}
+
+void queueMega2ControlChange(uint8_t channel, uint8_t command, uint8_t value){
+	mega2Queue.controlChange(channel, command, value, !isPanelControl(command));
+}
+
+void queueUsbNoteOn(uint8_t channel, uint8_t note, uint8_t velocity){
+	usbQueue.noteOn(channel, note, velocity);
+}
+
+void queueUsbNoteOff(uint8_t channel, uint8_t note, uint8_t velocity){
+	usbQueue.noteOff(channel, note, velocity);
+}
+
+void queueUsbPitchBend(uint8_t channel, int bend){
+	usbQueue.pitchBend(channel, bend);
+}
+
+void queueUsbControlChange(uint8_t channel, uint8_t command, uint8_t value){
+	usbQueue.controlChange(channel, command, value, !isPanelControl(command));
+}
+
+// Controls that are not a state of the panel, and are not saved.
+bool isPanelControl(uint8_t command){
+	switch(command){
+		case CC_TRANSPOSE:
+		case CC_FUNCTION:
+		case CC_ASK_FOR_DATA:
+		case CC_CALIBRATE:
+		case CC_ALL_NOTE_OFF:
+			return 0;
+		default:
+			return 1;
+	}
+}
+
+// Control changes from the Megas. Their value is kept in the panel state.
+void handleInternalControlChange(uint8_t channel, uint8_t command, uint8_t value){
+	if(!function && isPanelControl(command) && (panelState[command] != value)){
+		panelState[command] = value;
+		panelChanged = 1;
+		panelChangeTime = millis();
+	}
+	handleControlChange(channel, command, value);
+}
+
+// Panel state frame from a Mega : SYSEX_ID, SYSEX_STATE_DUMP, then control change and value for every
+// control that differs from what we have. The frame given by the MIDI library has its start and end bytes.
+// Called from the timer interrupt : the controls go through the queue, like the ones sent one by one.
+void handlePanelState(uint8_t mega, uint8_t *frame, unsigned size){
+	if((size < 4) || (frame[1] != SYSEX_ID) || (frame[2] != SYSEX_STATE_DUMP)) return;
+	MidiQueue *queue = mega ? &mega2Queue : &mega1Queue;
+	for(unsigned i = 3; (i + 1) < size; i += 2){
+		if(frame[i] & 0x80) break;
+		queue->controlChange(1, frame[i], frame[i + 1], !isPanelControl(frame[i]));
+	}
+	panelSynced[mega] = 1;
+	if(panelSynced[0] && panelSynced[1] && !panelSyncedTime) panelSyncedTime = millis();
+}
+
+void handleMega1SysEx(uint8_t *frame, unsigned size){
+	handlePanelState(0, frame, size);
+}
+
+void handleMega2SysEx(uint8_t *frame, unsigned size){
+	handlePanelState(1, frame, size);
 }
 
 // handle note on. compute dc to waveforms, glide enveloppe triggering, etc.
-void noteOn(uint8_t note, uint8_t velocity, bool trigger = 1){
+void noteOn(uint8_t note, uint8_t velocity, bool trigger = 1, uint16_t offset = 0){
 /*
 	Serial.print("playing :");
 	Serial.println(note);
 */
 	// Note tracking.
 	nowPlaying = note;
+	if(!firstNoteTime) firstNoteTime = millis();
 	// Applying detune per key.
 	float fineTune = detuneTable[note] * detuneCoeff[detune];
 //	float duration = 1.0 + (float)glideEn * (float)glide * 3.75;
@@ -555,104 +889,119 @@ void noteOn(uint8_t note, uint8_t velocity, bool trigger = 1){
 	filterLevel += fineTune;
 
 	AudioNoInterrupts();
-	dcKeyTrack.amplitude(level, duration);
-	dcFilterKeyTrack.amplitude(filterLevel, duration);
+	dcKeyTrack.amplitude(level, duration, offset);
+	dcFilterKeyTrack.amplitude(filterLevel, duration, offset);
 	if(trigger){
-		filterEnvelope.noteOn();
-		mainEnvelope.noteOn();
+		filterEnvelope.noteOn(offset);
+		mainEnvelope.noteOn(offset);
+		mainEnvelopeRight.noteOn(offset);
 	}
 	AudioInterrupts();
 }
 
 // Stop note.
-void noteOff(){
+void noteOff(uint16_t offset = 0){
+	nowPlaying = -1;
 	AudioNoInterrupts();
-	filterEnvelope.noteOff();
-	mainEnvelope.noteOff();
+	filterEnvelope.noteOff(offset);
+	mainEnvelope.noteOff(offset);
+	mainEnvelopeRight.noteOff(offset);
 	AudioInterrupts();
 }
 
-// Keytrack functions
-// This one check if the key is the lower one, or not, and returns the index of the lower one.
-int8_t keyTrackGetLower(uint8_t note){
-	uint8_t lower = 127;
-	int8_t lowerIndex = keyTrackIndex - 1;
+// Sequencer notes. They are called from the audio update, with the sample of the block they are due at.
+void handleSequencerNoteOn(uint8_t note, uint8_t velocity, uint16_t offset){
+	noteOn(note, velocity, 1, offset);
+}
 
-	for(uint8_t i = 0; i < keyTrackIndex; ++i){
-		if(keyTrack[i].key < lower){
-			lower = keyTrack[i].key;
-			lowerIndex = i;
-		}
-	}
-/*
-	Serial.print("lower note   : ");
-	Serial.print(lower);
-	Serial.print("\t index : ");
-	Serial.println(lowerIndex);
-*/
-	return lowerIndex;
+void handleSequencerNoteOff(uint16_t offset){
+	noteOff(offset);
 }
 
-// Ditto upper key.
-int8_t keyTrackGetUpper(uint8_t note){
-	uint8_t upper = 0;
-	int8_t upperIndex = keyTrackIndex - 1;
+// MIDI clock, read from the main loop. The sequencer stamps it with the time it comes, and filters the jitter.
+void handleClock(){
+	sequencer.clock();
+}
 
-	for(uint8_t i = 0; i < keyTrackIndex; ++i){
-		if(keyTrack[i].key > upper){
-			upper = keyTrack[i].key;
-			upperIndex = i;
-		}
-	}
-/*
-	Serial.print("upper note   : ");
-	Serial.print(upper);
-	Serial.print("\t index : ");
-	Serial.println(upperIndex);
-*/
-	return upperIndex;
+void handleStart(){
+	sequencer.start();
 }
 
-// Add a key to the keytrack table.
-int8_t keyTrackAdd(uint8_t note, uint8_t velocity){
-	// We only keep count of a limited quantity of notes !
-	if (keyTrackIndex >= KEYTRACK_MAX) return -1;
-/*
-	Serial.print("note added   : ");
-	Serial.print(note);
-	Serial.print("\t index : ");
-	Serial.println(keyTrackIndex);
-*/
-	keyTrack[keyTrackIndex].key = note;
-	keyTrack[keyTrackIndex].velocity = velocity;
+void handleStop(){
+	sequencer.stop();
+}
 
-	return keyTrackIndex++;
+void handleContinue(){
+	sequencer.resume();
 }
 
-// remove a key that has been released on the keyboard, and reorder all that were pressed after.
-int8_t keyTrackRemove(uint8_t note){
-	int8_t update = -1;
-	for(uint8_t i = 0; i < keyTrackIndex; ++i){
-		if(keyTrack[i].key == note){
-			update = i;
-			keyTrackIndex--;
-			break;
+// Set both band mixers from the filter band value, according to filter mode.
+void setFilterBand(){
+	float low = 0.0;
+	float band = 0.0;
+	float high = 0.0;
+	if(filterMode == FILTER_BAND_PASS){
+		if(filterBandValue < HALF_RESO){
+			low = ((float)HALF_RESO - (float)filterBandValue) / HALF_RESO;
+			band = (float)filterBandValue / HALF_RESO;
+		} else {
+			band = ((float)RESO - (float)filterBandValue) / HALF_RESO;
+			high = ((float)filterBandValue - HALF_RESO) / HALF_RESO;
 		}
+	} else if(filterMode == FILTER_BAND_STOP){
+		low = (float)(RESO - filterBandValue) / RESO;
+		high = (float)filterBandValue / RESO;
 	}
 
-	if(update >= 0){
-/*
-		Serial.print("note removed : ");
-		Serial.print(note);
-		Serial.print("\t index : ");
-		Serial.println(update);
-*/
-		for(uint8_t i = update; i < keyTrackIndex; ++i){
-			keyTrack[i] = keyTrack[i + 1];
-		}
+	AudioNoInterrupts();
+	bandMixer.gain(0, low);
+	bandMixer.gain(1, band);
+	bandMixer.gain(2, high);
+	bandMixerRight.gain(0, low);
+	bandMixerRight.gain(1, band);
+	bandMixerRight.gain(2, high);
+	AudioInterrupts();
+}
+
+// Set both main envelopes times. The right one is slower by the stereo envelope offset.
+void setMainEnvelope(){
+	AudioNoInterrupts();
+	mainEnvelope.attack(egAttackTime);
+	mainEnvelope.decay(egDecayTime);
+	mainEnvelope.release(egReleaseTime);
+	mainEnvelopeRight.attack(egAttackTime * envelopeRatio);
+	mainEnvelopeRight.decay(egDecayTime * envelopeRatio);
+	mainEnvelopeRight.release(egReleaseTime * envelopeRatio);
+	AudioInterrupts();
+}
+
+// Set whether a stereo control is off center, and compute the right side only when one is.
+// The right filter goes on from where it stopped, which can click a little as the first control leaves the center.
+void setStereoSpread(uint8_t control, bool spread){
+	if(spread){
+		stereoSpread |= (1 << control);
+	} else {
+		stereoSpread &= ~(1 << control);
 	}
+	AudioNoInterrupts();
+	stereoMixer.mono(!stereoSpread);
+	fxBus.mono(!stereoSpread);
+	AudioInterrupts();
+}
 
-	return update;
+// The key to play among the ones held, according to key priority. -1 if none is held.
+int8_t keyTrackGetPriority(){
+	switch(keyMode){
+		case KEY_LOWER:
+			return keyTrack.lower();
+		case KEY_UPPER:
+			return keyTrack.upper();
+		case KEY_FIRST:
+			return keyTrack.first();
+		case KEY_LAST:
+		default:
+			return keyTrack.last();
+	}
 }
 
 // Handle note on. Internal MIDI from Mega 1 lands here.
@@ -677,70 +1026,22 @@ void handleNoteOn(uint8_t channel, uint8_t note, uint8_t velocity){
 	Serial.println(" on");
 */
 
-	int8_t newIndex = -1;
-	int8_t lowerIndex = -1;
-	int8_t upperIndex = -1;
-	switch(keyMode){
-		// When KEY_FIRST, we play the note only if there is not one already playing
-		// But we keep track of all notes depressed !
-		case KEY_FIRST:
-			if(keyTrackAdd(note, velocity) == 0)
-			noteOn(note, velocity);
-			break;
-		// When KEY_LAST, we play the new note anyway.
-		// And keep track. Of course.
-		case KEY_LAST:
-//			if(keyTrackAdd(note, velocity) >= 0) noteOn(note, velocity);
-			newIndex = keyTrackAdd(note, velocity);
-			if(newIndex == 0){
-				noteOn(note, velocity, 1);
-			} else if(newIndex > 0){
-				noteOn(note, velocity, noteRetrigger);
-			}
-			break;
-		case KEY_LOWER:
-			// add note to the keytrack table.
-			// check if there is a lower one.
-			// if no, play the note.
-			// if yes, do nothing.
-//			Serial.println("handle note on");
-
-			newIndex = keyTrackAdd(note, velocity);
-			lowerIndex = keyTrackGetLower(note);
-/*
-			Serial.print("new   : ");
-			Serial.print(newIndex);
-			Serial.print("\tlower : ");
-			Serial.println(lowerIndex);
-*/
-			if(lowerIndex == (keyTrackIndex - 1)){
-				if(newIndex == 0){
-					noteOn(note, velocity);
-				} else if(newIndex > 0){
-					noteOn(note, velocity, noteRetrigger);
-				}
-			}
-			break;
-		case KEY_UPPER:
-			// add note to the keytrack table.
-			// check if there is an upper one.
-			// If no, play the note.
-			// If yes, do nothing.
-			newIndex = keyTrackAdd(note, velocity);
-			upperIndex = keyTrackGetUpper(note);
-
-			if(upperIndex == (keyTrackIndex - 1)){
-				if(newIndex == 0){
-					noteOn(note, velocity);
-				} else if(newIndex > 0){
-					noteOn(note, velocity, noteRetrigger);
-				}
-			}
-			break;
-		default:
-			break;
+	// When the arpeggiator or the sequencer plays, the keys only tell it what to play.
+	if(sequencer.isPlaying()){
+		sequencer.noteOn(note, velocity);
+		return;
+	}
+	if(sequencer.mode() == SEQUENCER_RECORD) sequencer.addStep(note, velocity);
+
+	// The new note is played if it has the priority. The first one pressed always triggers the envelopes.
+	// A key pressed again while held can change the priority (last note), so what sounds is checked too.
+	// With first note priority it keeps its place.
+	bool first = (keyTrack.count() == 0);
+	keyTrack.add(note, velocity, keyMode != KEY_FIRST);
+	int8_t priority = keyTrackGetPriority();
+	if((priority == note) || (priority != nowPlaying)){
+		noteOn(priority, keyTrack.velocity(priority), first ? 1 : noteRetrigger);
 	}
-
 }
 
 // handle internal note off.
@@ -764,84 +1065,30 @@ void handleNoteOff(uint8_t channel, uint8_t note, uint8_t velocity){
 	Serial.println(" off");
 */
 
-	int8_t lowerIndex = -1;
-	int8_t upperIndex = -1;
-	int8_t newIndex = -1;
-	switch(keyMode){
-		case KEY_FIRST:
-			if(keyTrackRemove(note) == 0){
-				if(keyTrackIndex > 0){
-					noteOn(keyTrack[0].key, keyTrack[0].velocity, noteRetrigger);
-				} else {
-					noteOff();					
-				}
-			}
-			break;
-		case KEY_LAST:
-			if(keyTrackRemove(note) == keyTrackIndex){
-				if(keyTrackIndex > 0){
-					noteOn(keyTrack[keyTrackIndex - 1].key,
-						keyTrack[keyTrackIndex - 1].velocity, noteRetrigger);
-				} else {
-					noteOff();					
-				}
-			}
-			break;			
-		case KEY_LOWER:
-			// check the keytrack table and remove the note of it.
-			// compare it to other notes.
-			// if there is no, send note off.
-			// if there is a lower, do nothing.
-			// if there is an upper, play the new lower note.
-//			Serial.println("handle note off");
-
-			lowerIndex = keyTrackGetLower(note);
-			newIndex = keyTrackRemove(note);
-/*
-			Serial.print("new   : ");
-			Serial.print(newIndex);
-			Serial.print("\tlower : ");
-			Serial.println(lowerIndex);
-*/
-
-			if(newIndex == lowerIndex){
-				if(keyTrackIndex == 0){
-					noteOff();
-				} else {
-					lowerIndex = keyTrackGetLower(note);
-					noteOn(keyTrack[lowerIndex].key,
-						keyTrack[lowerIndex].velocity, noteRetrigger);
-				}
-			}
-			break;
-		case KEY_UPPER:
-			upperIndex = keyTrackGetUpper(note);
-			newIndex = keyTrackRemove(note);
-
-			if(newIndex == upperIndex){
-				if(keyTrackIndex == 0){
-					noteOff();
-				} else {
-					upperIndex = keyTrackGetUpper(note);
-					noteOn(keyTrack[upperIndex].key,
-						keyTrack[upperIndex].velocity, noteRetrigger);
-				}
-			}
-			break;
-		default:
-			break;
+	if(sequencer.isPlaying()){
+		sequencer.noteOff(note);
+		return;
 	}
 
+	// Releasing a key only changes something if the note with priority is no longer the one sounding :
+	// the next one with priority is played, if any.
+	if(!keyTrack.remove(note)) return;
+
+	int8_t next = keyTrackGetPriority();
+	if(next == nowPlaying) return;
+	if(next < 0){
+		noteOff();
+	} else {
+		noteOn(next, keyTrack.velocity(next), noteRetrigger);
+	}
 }
 
-// internal pitch bend from Mega 1.
+// internal pitch bend from Mega 1. The wheel is calibrated there, it sends a standard pitch bend.
 // Echo to usb MIDI out.
-// Still work to do here, as there is still this bug on Mega 1 side.
 void handleInternalPitchBend(uint8_t channel, int16_t bend){
 	if(function) handlePitchBendFunction();
-	int16_t bendAmount = (bend - PITCH_BEND_NEUTRAL) * PITCH_BEND_INTERNAL_TO_MIDI;
-	handlePitchBend(channel, bendAmount);
-	usbMIDI.sendPitchBend(bendAmount, midiOutChannel);
+	handlePitchBend(channel, bend);
+	usbMIDI.sendPitchBend(bend, midiOutChannel);
 /*
 	Serial.print("pitch bend :");
 	Serial.println(bend);
@@ -850,8 +1097,7 @@ void handleInternalPitchBend(uint8_t channel, int16_t bend){
 
 // Pitch bend from usb MIDI in lands here.
 void handlePitchBend(uint8_t channel, int16_t bend){
-	dcPitchBend.amplitude(((float)bend) / 8190);
-	// neutral at -11 from u(bend - PITCH_BEND_NEUTRAL) * PITCH_BEND_INTERNAL_TO_MIDIp, -24 from down. :/
+	dcPitchBend.amplitude(((float)bend) / 8190, PITCH_BEND_RAMP_MS);
 }
 
 // Handle internal control changes, and probably some from outside
@@ -868,8 +1114,9 @@ void handleControlChange(uint8_t channel, uint8_t command, uint8_t value){
 */
 
 	// Long value reconstruct the 14-bits value send with CC 0-31, associated to CC LSB 32-63.
-	// Ramp value is used for glide, attack, decay and release, which have exponential settings.
-	// Short times can be precisely set, but longer are available as well.
+	// Ramp value is used for glide, attack, decay and release : it's the pot value squared, so that short times
+	// can be precisely set, but longer are available as well. Half the pot covers the first quarter of the times.
+	// Decay and release times are the time to get within -60dB of their target.
 	uint16_t longValue = 0;
 	float rampValue = 0;
 	if(command < 32){
@@ -977,10 +1224,8 @@ void handleControlChange(uint8_t channel, uint8_t command, uint8_t value){
 			break;
 		case CC_MOD_WHEEL_LSB:
 		// CC_33
-//			ampModWheelOsc.gain(((float)longValue - 1 - MOD_WHEEL_MIN) / 12 / MOD_WHEEL_COURSE);
-			ampModWheelOsc.gain(((float)(longValue * modWheelOscRange)) / MAX_OCTAVE / 12 / 16384);
-			ampModWheelFilter.gain(((float)(longValue * modWheelFilterRange)) / FILTER_MAX_OCTAVE / 12 / 16384);
-			// Mod wheel goes from 360 to 666.
+			ampModWheelOsc.gain(((float)(longValue * modWheelOscRange)) / MAX_OCTAVE / 12 / RESO);
+			ampModWheelFilter.gain(((float)(longValue * modWheelFilterRange)) / FILTER_MAX_OCTAVE / 12 / RESO);
 /*
 			Serial.print("mod wheel : ");
 			Serial.println(longValue);
@@ -1001,6 +1246,7 @@ void handleControlChange(uint8_t channel, uint8_t command, uint8_t value){
 		case CC_CHANNEL_VOL_LSB:
 		// CC_39
 			masterVolume.gain((float)longValue / RESO);
+			masterVolumeRight.gain((float)longValue / RESO);
 			break;
 		case CC_OSC_TUNE_LSB:
 		// CC_41
@@ -1016,44 +1262,31 @@ void handleControlChange(uint8_t channel, uint8_t command, uint8_t value){
 			break;
 		case CC_OSC1_MIX_LSB:
 		// CC_46
-			oscMixer.gain(0, MAX_MIX * (float)longValue / RESO);
+			stereoMixer.gain(0, MAX_MIX * (float)longValue / RESO);
 			break;
 		case CC_OSC2_MIX_LSB:
 		// CC_47
-			oscMixer.gain(1, MAX_MIX * (float)longValue / RESO);
+			stereoMixer.gain(1, MAX_MIX * (float)longValue / RESO);
 			break;
 		case CC_OSC3_MIX_LSB:
 		// CC_48
-			oscMixer.gain(2, MAX_MIX * (float)longValue / RESO);
+			stereoMixer.gain(2, MAX_MIX * (float)longValue / RESO);
 			break;
 		case CC_NOISE_MIX_LSB:
 		// CC_49
-			oscMixer.gain(3, MAX_MIX * (float)longValue / RESO);
+			stereoMixer.gain(3, MAX_MIX * (float)longValue / RESO);
 			break;
 		case CC_FEEDBACK_MIX_LSB:
 		// CC_50
-			globalMixer.gain(1, MAX_MIX * (float)longValue / RESO);
+			AudioNoInterrupts();
+			stereoMixer.gain(4, MAX_MIX * (float)longValue / RESO);
+			stereoMixer.gain(5, MAX_MIX * (float)longValue / RESO);
+			AudioInterrupts();
 			break;
 		case CC_FILTER_BAND_LSB:
 		// CC_51
 			filterBandValue = longValue;
-			AudioNoInterrupts();
-			if(filterMode == FILTER_BAND_PASS){
-				if(longValue < HALF_RESO){
-					bandMixer.gain(0, ((float)HALF_RESO - (float)longValue) / HALF_RESO);
-					bandMixer.gain(1, (float)longValue / HALF_RESO);
-					bandMixer.gain(2, 0.0);
-				} else {
-					bandMixer.gain(0, 0.0);
-					bandMixer.gain(1, ((float)RESO - (float)longValue) / HALF_RESO);
-					bandMixer.gain(2, ((float)longValue - HALF_RESO) / HALF_RESO);
-				}
-			} else if(filterMode == FILTER_BAND_STOP){
-				bandMixer.gain(0, (float)(RESO - longValue) / RESO);
-				bandMixer.gain(1, 0.0);
-				bandMixer.gain(2, (float)longValue / RESO);
-			}
-			AudioInterrupts();
+			setFilterBand();
 			break;
 		case CC_FILTER_CUTOFF_FREQ_LSB:
 		// CC_52
@@ -1062,6 +1295,7 @@ void handleControlChange(uint8_t channel, uint8_t command, uint8_t value){
 		case CC_FILTER_EMPHASIS_LSB:
 		// CC_53
 			vcf.resonance(FILTER_MIN_Q + (float)longValue / FILTER_DIV_Q);
+			vcfRight.resonance(FILTER_MIN_Q + (float)longValue / FILTER_DIV_Q);
 			break;
 		case CC_FILTER_CONTOUR_LSB:
 		// CC_54
@@ -1092,21 +1326,27 @@ void handleControlChange(uint8_t channel, uint8_t command, uint8_t value){
 		case CC_EG_ATTACK_LSB:
 		// CC_59
 //			mainEnvelope.attack(1 + (float)longValue * 5.0);
-			mainEnvelope.attack(rampValue * MAX_ATTACK_TIME);
+			egAttackTime = rampValue * MAX_ATTACK_TIME;
+			setMainEnvelope();
 			break;
 		case CC_EG_DECAY_LSB:
 		// CC_60
 //			mainEnvelope.decay((float)longValue * 5.0);
-			mainEnvelope.decay(rampValue * MAX_ATTACK_TIME);
+			egDecayTime = rampValue * MAX_ATTACK_TIME;
+			setMainEnvelope();
 			break;
 		case CC_EG_SUSTAIN_LSB:
 		// CC_61
+			AudioNoInterrupts();
 			mainEnvelope.sustain((float)longValue / RESO);
+			mainEnvelopeRight.sustain((float)longValue / RESO);
+			AudioInterrupts();
 			break;
 		case CC_EG_RELEASE_LSB:
 		// CC_62
 //			mainEnvelope.release(1 + (float)longValue * 5.0);
-			mainEnvelope.release(rampValue * MAX_ATTACK_TIME);
+			egReleaseTime = rampValue * MAX_ATTACK_TIME;
+			setMainEnvelope();
 			break;
 		case CC_LFO_RATE_LSB:
 		// CC_63
@@ -1124,33 +1364,153 @@ void handleControlChange(uint8_t channel, uint8_t command, uint8_t value){
 				glideEn = 0;
 			}
 			break;
+		case CC_FX_DELAY_TIME:
+		// CC_85
+			fxBus.delayTime((float)value * fxBus.delayMaxTime() / 127);
+			break;
+		case CC_FX_DELAY_FEEDBACK:
+		// CC_86
+			fxBus.delayFeedback((float)value / 127);
+			break;
+		case CC_FX_CHORUS_RATE:
+		// CC_87
+			fxBus.chorusRate(FX_CHORUS_MIN_RATE + pow((float)value / 127, 2) * FX_CHORUS_MAX_RATE);
+			break;
+		case CC_FX_CHORUS_DEPTH:
+		// CC_88
+			fxBus.chorusDepth((float)value / 127);
+			break;
+		case CC_FX_REVERB_SIZE:
+		// CC_89
+			fxBus.reverbSize((float)value / 127);
+			break;
 		case CC_BITCRUSH_OUT:
 		// CC_91
 			bitCrushOutput.bits(value);
+			bitCrushOutputRight.bits(value);
+			break;
+		case CC_FX_DELAY_MIX:
+		// CC_92
+			AudioNoInterrupts();
+			fxBus.delayMix((float)value / 127);
+			AudioInterrupts();
+			break;
+		case CC_FX_CHORUS_MIX:
+		// CC_93
+			AudioNoInterrupts();
+			fxBus.chorusMix((float)value / 127);
+			AudioInterrupts();
+			break;
+		case CC_FX_REVERB_MIX:
+		// CC_94
+			AudioNoInterrupts();
+			fxBus.reverbMix((float)value / 127);
+			AudioInterrupts();
+			break;
+		case CC_FX_ON_OFF:
+		// CC_95
+			AudioNoInterrupts();
+			fxBus.enable(value > 63);
+			AudioInterrupts();
 			break;
 		case CC_OSC1_RANGE:
 		// CC_102
-			osc1Waveform.frequency(NOTE_MIDI_0 / pow(2, value));
+			oscillators.range(0, value);
 			break;
 		case CC_OSC1_WAVEFORM:
 		// CC_103
-			osc1Waveform.begin(waveforms[value]);
+			setOscWaveform(0, value);
 			break;
 		case CC_OSC2_RANGE:
 		// CC_104
-			osc2Waveform.frequency(NOTE_MIDI_0 / pow(2, value));
+			oscillators.range(1, value);
 			break;
 		case CC_OSC2_WAVEFORM:
 		// CC_105
-			osc2Waveform.begin(waveforms[value]);
+			setOscWaveform(1, value);
 			break;
 		case CC_OSC3_RANGE:
 		// CC_106
-			osc3Waveform.frequency(NOTE_MIDI_0 / pow(2, value));
+			oscillators.range(2, value);
 			break;
 		case CC_OSC3_WAVEFORM:
 		// CC_107
-			osc3Waveform.begin(waveforms[value]);
+			setOscWaveform(2, value);
+			break;
+		case CC_WAVETABLE_MORPH:
+		// CC_70
+			for(uint8_t i = 0; i < 3; ++i){
+				oscillators.morph(i, (float)value / 127);
+			}
+			break;
+		case CC_OSC2_SYNC:
+		// CC_71
+			oscillators.sync(1, value > 63);
+			break;
+		case CC_OSC3_SYNC:
+		// CC_72
+			oscillators.sync(2, value > 63);
+			break;
+		case CC_OSC_FM_AMOUNT:
+		// CC_73
+			// Squared, for a finer setting of small amounts.
+			oscillators.fmAmount(OSC_MAX_FM_AMOUNT * ((float)value * value) / (127 * 127));
+			break;
+		case CC_OSC1_PAN:
+		// CC_74
+			stereoMixer.pan(0, ((float)value - 64) / 63);
+			setStereoSpread(0, value != 64);
+			break;
+		case CC_OSC2_PAN:
+		// CC_75
+			stereoMixer.pan(1, ((float)value - 64) / 63);
+			setStereoSpread(1, value != 64);
+			break;
+		case CC_OSC3_PAN:
+		// CC_76
+			stereoMixer.pan(2, ((float)value - 64) / 63);
+			setStereoSpread(2, value != 64);
+			break;
+		case CC_NOISE_PAN:
+		// CC_77
+			stereoMixer.pan(3, ((float)value - 64) / 63);
+			setStereoSpread(3, value != 64);
+			break;
+		case CC_FX_PAN:
+		// CC_78
+			fxBus.returnPan(((float)value - 64) / 63);
+			break;
+		case CC_STEREO_FILTER_OFFSET:
+		// CC_79
+			// The right filter is moved up, or down, from the left one. Centered, both are the same.
+			vcfRight.frequency(FILTER_BASE_FREQUENCY * pow(2, STEREO_MAX_FILTER_OFFSET * ((float)value - 64) / 63));
+			setStereoSpread(STEREO_SPREAD_FILTER, value != 64);
+			break;
+		case CC_STEREO_ENVELOPE_OFFSET:
+		// CC_81
+			envelopeRatio = 1.0 + STEREO_MAX_ENVELOPE_OFFSET * (float)value / 127;
+			setMainEnvelope();
+			setStereoSpread(STEREO_SPREAD_ENVELOPE, value != 0);
+			break;
+		case CC_SEQUENCER_CLOCK:
+		// CC_66
+			sequencer.externalClock(value > 63);
+			break;
+		case CC_SEQUENCER_OCTAVES:
+		// CC_67
+			sequencer.octaves(1 + value / 32);
+			break;
+		case CC_SEQUENCER_TEMPO:
+		// CC_82
+			sequencer.tempo(SEQUENCER_MIN_TEMPO + (SEQUENCER_MAX_TEMPO - SEQUENCER_MIN_TEMPO) * (float)value / 127);
+			break;
+		case CC_SEQUENCER_GATE:
+		// CC_83
+			sequencer.gate((float)value / 127);
+			break;
+		case CC_SEQUENCER_DIVISION:
+		// CC_84
+			sequencer.division(SEQUENCER_DIVISIONS[value * 6 / 128]);
 			break;
 		case CC_OSC3_CTRL:
 		// CC_108
@@ -1204,7 +1564,8 @@ void handleControlChange(uint8_t channel, uint8_t command, uint8_t value){
 		// CC_113
 			if(value < 64){
 				noteOff();
-				keyTrackIndex = 0;
+				keyTrack.clear();
+				sequencer.allNotesOff();
 				usbMIDI.sendControlChange(CC_ALL_NOTE_OFF, 0, midiOutChannel);
 				function = 1;
 //				Serial.println("enterring function mode");
@@ -1293,7 +1654,44 @@ void handleControlChange(uint8_t channel, uint8_t command, uint8_t value){
 		case CC_ALL_NOTE_OFF:
 		// CC_123
 			noteOff();
-			keyTrackIndex = 0;
+			keyTrack.clear();
+			sequencer.allNotesOff();
+			break;
+		default:
+			break;
+	}
+}
+
+// Control changes from usb MIDI in.
+// There are no panel controls for the effect bus, the wavetable morph, the sync and the FM, so their CC are the ones accepted from outside.
+void handleUsbControlChange(uint8_t channel, uint8_t command, uint8_t value){
+	switch(command){
+		case CC_FX_DELAY_TIME:
+		case CC_FX_DELAY_FEEDBACK:
+		case CC_FX_CHORUS_RATE:
+		case CC_FX_CHORUS_DEPTH:
+		case CC_FX_REVERB_SIZE:
+		case CC_FX_DELAY_MIX:
+		case CC_FX_CHORUS_MIX:
+		case CC_FX_REVERB_MIX:
+		case CC_FX_ON_OFF:
+		case CC_WAVETABLE_MORPH:
+		case CC_OSC2_SYNC:
+		case CC_OSC3_SYNC:
+		case CC_OSC_FM_AMOUNT:
+		case CC_OSC1_PAN:
+		case CC_OSC2_PAN:
+		case CC_OSC3_PAN:
+		case CC_NOISE_PAN:
+		case CC_FX_PAN:
+		case CC_STEREO_FILTER_OFFSET:
+		case CC_STEREO_ENVELOPE_OFFSET:
+		case CC_SEQUENCER_CLOCK:
+		case CC_SEQUENCER_OCTAVES:
+		case CC_SEQUENCER_TEMPO:
+		case CC_SEQUENCER_GATE:
+		case CC_SEQUENCER_DIVISION:
+			handleControlChange(channel, command, value);
 			break;
 		default:
 			break;
@@ -1316,6 +1714,14 @@ void handleKeyboardFunction(uint8_t key, bool active){
 			currentFunction = FUNCTION_KEYBOARD_MODE;
 //			Serial.println("keyboard mode");
 			break;
+		case 1:
+		// lower DO#
+			currentFunction = FUNCTION_OSC_MODE;
+			break;
+		case 3:
+		// lower RE#
+			currentFunction = FUNCTION_CALIBRATE;
+			break;
 		case 2:
 		// lower RE
 			currentFunction = FUNCTION_RETRIGGER;
@@ -1331,6 +1737,10 @@ void handleKeyboardFunction(uint8_t key, bool active){
 			currentFunction = FUNCTION_BITCRUSH;
 //			Serial.println("bitcrush");
 			break;
+		case 6:
+		// lower FA#
+			currentFunction = FUNCTION_SEQUENCER;
+			break;
 		case 7:
 		// lower SOL
 			currentFunction = FUNCTION_FILTER_MODE;
@@ -1377,31 +1787,14 @@ void handleKeyboardFunction(uint8_t key, bool active){
 			if(key > 12) return;
 			key += 4;
 			bitCrushOutput.bits(key);
+			bitCrushOutputRight.bits(key);
 			EEPROM.put(EE_BITCRUSH_ADD, key);
 			break;
 		case FUNCTION_FILTER_MODE:
 			if(key > 1) return;
 			filterMode = (filterMode_t)key;
 			EEPROM.put(EE_FILTER_MODE, filterMode);
-			AudioNoInterrupts();
-			// This is the same as in the CC handle function.
-			// Could probably be a dedicate function called from both place.
-			if(filterMode == FILTER_BAND_PASS){
-				if(filterBandValue < HALF_RESO){
-					bandMixer.gain(0, ((float)HALF_RESO - (float)filterBandValue) / HALF_RESO);
-					bandMixer.gain(1, (float)filterBandValue / HALF_RESO);
-					bandMixer.gain(2, 0.0);
-				} else {
-					bandMixer.gain(0, 0.0);
-					bandMixer.gain(1, ((float)RESO - (float)filterBandValue) / HALF_RESO);
-					bandMixer.gain(2, ((float)filterBandValue - HALF_RESO) / HALF_RESO);
-				}
-			} else if(filterMode == FILTER_BAND_STOP){
-				bandMixer.gain(0, (float)(RESO - filterBandValue) / RESO);
-				bandMixer.gain(1, 0.0);
-				bandMixer.gain(2, (float)filterBandValue / RESO);
-			}
-			AudioInterrupts();
+			setFilterBand();
 			break;			
 		case FUNCTION_MIDI_IN_CHANNEL:
 			// change (usb) midi in channel
@@ -1440,12 +1833,61 @@ void handleKeyboardFunction(uint8_t key, bool active){
 			modWheelFilterRange = key;
 			EEPROM.put(EE_MOD_WHEEL_FILTER_RANGE, modWheelFilterRange);
 			break;
+		case FUNCTION_CALIBRATE:
+			// Pots calibration is done on the Megas, and stored there.
+			// First key starts it, then every pot should be moved to both ends. Second key stores it.
+			if(key > 1) return;
+			megaSendBegin();
+			midi1.sendControlChange(CC_CALIBRATE, key ? 0 : 127, 1);
+			midi2.sendControlChange(CC_CALIBRATE, key ? 0 : 127, 1);
+			megaSendEnd();
+			break;
+		case FUNCTION_OSC_MODE:
+			if(key > OSC_MODE_WAVETABLE) return;
+			oscMode = (oscMode_t)key;
+			EEPROM.put(EE_OSC_MODE, oscMode);
+			for(uint8_t i = 0; i < 3; ++i){
+				setOscWaveform(i, oscWaveform[i]);
+			}
+			break;
+		case FUNCTION_SEQUENCER:
+			if(key > SEQUENCER_RECORD) return;
+			// The pattern recorded is saved when recording ends, a new recording starts from scratch.
+			if(sequencer.mode() == SEQUENCER_RECORD) saveSequencerPattern();
+			if(key == SEQUENCER_RECORD) sequencer.clearPattern();
+			sequencer.mode((sequencerMode_t)key);
+			EEPROM.put(EE_SEQUENCER_MODE, (sequencerMode_t)key);
+			break;
 		default:
 			break;		
 	}
 
 }
 
+// Store the sequencer pattern in permanent memory.
+void saveSequencerPattern(){
+	uint8_t length = sequencer.patternLength();
+	EEPROM.write(EE_SEQUENCER_PATTERN_ADD, length);
+	for(uint8_t i = 0; i < length; ++i){
+		EEPROM.write(EE_SEQUENCER_PATTERN_ADD + 1 + 2 * i, sequencer.patternNote(i));
+		EEPROM.write(EE_SEQUENCER_PATTERN_ADD + 2 + 2 * i, sequencer.patternVelocity(i));
+	}
+}
+
+// Set the waveform of an oscillator from its selector position.
+// In wavetable mode the selector chooses the table instead of the classic waveform.
+void setOscWaveform(uint8_t osc, uint8_t value){
+	if(value > 5) value = 5;
+	oscWaveform[osc] = value;
+
+	if(oscMode == OSC_MODE_WAVETABLE){
+		oscillators.wavetable(osc, value);
+		oscillators.begin(osc, WAVEFORM_WAVETABLE);
+	} else {
+		oscillators.begin(osc, waveforms[value]);
+	}
+}
+
 void handlePitchBendFunction(){
 	currentFunction = FUNCTION_PITCH_BEND_RANGE;
 }
@@ -0,0 +1,137 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Audio.h>
+
+#include "mixer_stereo.h"
+
+// Highest gain the 16.16 fixed point gains hold : the largest float under 32768.
+static const float MAX_GAIN = 32768.0 - 1.0 / 256;
+
+AudioMixerStereo::AudioMixerStereo() : AudioStream(MIXER_STEREO_INPUTS, inputQueueArray){
+	for(uint8_t i = 0; i < MIXER_STEREO_INPUTS; ++i){
+		_level[i] = 1.0;
+		_pan[i] = 0.0;
+		computeGains(i);
+	}
+}
+
+void AudioMixerStereo::gain(uint8_t channel, float level){
+	if(channel >= MIXER_STEREO_INPUTS) return;
+	if(level > MAX_GAIN) level = MAX_GAIN;
+	if(level < -MAX_GAIN) level = -MAX_GAIN;
+	_level[channel] = level;
+	computeGains(channel);
+}
+
+void AudioMixerStereo::pan(uint8_t channel, float value){
+	if(channel >= MIXER_STEREO_INPUTS) return;
+	if(value < -1.0) value = -1.0;
+	if(value > 1.0) value = 1.0;
+	_pan[channel] = value;
+	computeGains(channel);
+}
+
+void AudioMixerStereo::computeGains(uint8_t channel){
+	float left = (_pan[channel] > 0.0) ? 1.0 - _pan[channel] : 1.0;
+	float right = (_pan[channel] < 0.0) ? 1.0 + _pan[channel] : 1.0;
+	// Both are set together, the audio update must not see one side changed and not the other.
+	int32_t gainLeft = _level[channel] * left * 65536.0;
+	int32_t gainRight = _level[channel] * right * 65536.0;
+	__disable_irq();
+	_left[channel] = gainLeft;
+	_right[channel] = gainRight;
+	__enable_irq();
+}
+
+static inline int16_t saturate16(int32_t value){
+	if(value > 32767) return 32767;
+	if(value < -32768) return -32768;
+	return value;
+}
+
+void AudioMixerStereo::update(void){
+	int32_t acc[2 * AUDIO_BLOCK_SAMPLES];
+	bool used = false;
+
+	for(uint8_t n = 0; n < MIXER_STEREO_INPUTS; ++n){
+		audio_block_t *in = receiveReadOnly(n);
+		if(!in) continue;
+		int32_t left = _left[n];
+		int32_t right = _right[n];
+		if(!left && (!right || _mono)){
+			release(in);
+			continue;
+		}
+
+		int32_t *out = acc;
+		const int16_t *data = in->data;
+		if(_mono){
+			if(!used){
+				for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+					*out++ = ((int64_t)data[i] * left) >> 16;
+				}
+			} else {
+				for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+					*out++ += ((int64_t)data[i] * left) >> 16;
+				}
+			}
+		} else if(!used){
+			for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+				*out++ = ((int64_t)data[i] * left) >> 16;
+				*out++ = ((int64_t)data[i] * right) >> 16;
+			}
+		} else {
+			for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+				*out++ += ((int64_t)data[i] * left) >> 16;
+				*out++ += ((int64_t)data[i] * right) >> 16;
+			}
+		}
+		used = true;
+		release(in);
+	}
+
+	// Like AudioMixer4, nothing is sent when every input is silent.
+	if(!used) return;
+
+	if(_mono){
+		audio_block_t *out = allocate();
+		if(!out) return;
+		for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+			out->data[i] = saturate16(acc[i]);
+		}
+		transmit(out, 0);
+		release(out);
+		return;
+	}
+
+	audio_block_t *outLeft = allocate();
+	audio_block_t *outRight = allocate();
+	if(outLeft && outRight){
+		const int32_t *in = acc;
+		for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+			outLeft->data[i] = saturate16(*in++);
+			outRight->data[i] = saturate16(*in++);
+		}
+		transmit(outLeft, 0);
+		transmit(outRight, 1);
+	}
+	if(outLeft) release(outLeft);
+	if(outRight) release(outRight);
+}
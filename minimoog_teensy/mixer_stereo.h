@@ -0,0 +1,68 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Stereo mixer, for use with the PJRC audio library.
+ *
+ * Each input has a gain and a pan :
+ *	input n		mono source
+ *	output 0	left
+ *	output 1	right
+ *
+ * It does in one node what would take two AudioMixer4 per four inputs and a pan stage : every input sample is read once,
+ * and added to both sides of an interleaved accumulator, which is split in two blocks at the end.
+ * The pan keeps the full gain at the center, and fades the other side towards the ends (balance law),
+ * so a centered source sounds as it does through a mono mixer.
+ *
+ * In mono, only the left side is computed and sent : the right output sends nothing, so the nodes after it don't run.
+ */
+
+#ifndef MIXER_STEREO_H
+#define MIXER_STEREO_H
+
+#include <Arduino.h>
+#include <AudioStream.h>
+
+const uint8_t MIXER_STEREO_INPUTS = 6;
+
+class AudioMixerStereo : public AudioStream{
+public:
+	AudioMixerStereo();
+
+	// Gain as for AudioMixer4, up to just under 32768 either way : gains are 16.16 fixed point.
+	// Pan from -1 (left) to 1 (right).
+	void gain(uint8_t channel, float level);
+	void pan(uint8_t channel, float value);
+	void mono(bool value){_mono = value;}
+
+	virtual void update(void);
+
+private:
+	void computeGains(uint8_t channel);
+
+	audio_block_t *inputQueueArray[MIXER_STEREO_INPUTS];
+
+	float _level[MIXER_STEREO_INPUTS];
+	float _pan[MIXER_STEREO_INPUTS];
+	// Gains for each side, 16.16 fixed point.
+	int32_t _left[MIXER_STEREO_INPUTS];
+	int32_t _right[MIXER_STEREO_INPUTS];
+	bool _mono = false;
+};
+
+#endif
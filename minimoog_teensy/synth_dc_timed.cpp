@@ -0,0 +1,90 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synth_dc_timed.h"
+
+void AudioSynthDcTimed::amplitude(float n, float ms, uint16_t offset){
+	if(n > 1.0) n = 1.0;
+	if(n < -1.0) n = -1.0;
+	float samples = ms * AUDIO_SAMPLE_RATE_EXACT / 1000.0;
+	if(offset >= AUDIO_BLOCK_SAMPLES) offset = AUDIO_BLOCK_SAMPLES - 1;
+
+	if(offset == 0){
+		_pendingOffset = -1;
+		start(n, samples);
+	} else {
+		_pendingTarget = n;
+		_pendingSamples = samples;
+		_pendingOffset = offset;
+	}
+}
+
+// Go to "target" from the current level, in "samples" samples, or at once if it's under one.
+void AudioSynthDcTimed::start(float target, float samples){
+	_target = target;
+	if(samples < 1.0){
+		_level = target;
+		_increment = 0;
+	} else {
+		_increment = (target - _level) / samples;
+	}
+}
+
+// Compute the level from sample "start" to sample "end" (excluded) of the block.
+void AudioSynthDcTimed::renderSegment(int16_t *data, uint16_t start, uint16_t end){
+	float level = _level;
+	uint16_t i = start;
+
+	if(_increment != 0){
+		for(; i < end; ++i){
+			level += _increment;
+			if(((_increment > 0) && (level >= _target)) || ((_increment < 0) && (level <= _target))){
+				level = _target;
+				_increment = 0;
+				break;
+			}
+			data[i] = (int16_t)(level * 32767.0f);
+		}
+	}
+	int16_t steady = (int16_t)(level * 32767.0f);
+	for(; i < end; ++i){
+		data[i] = steady;
+	}
+
+	_level = level;
+}
+
+void AudioSynthDcTimed::update(void){
+	audio_block_t *block = allocate();
+	if(!block) return;
+
+	int16_t offset = _pendingOffset;
+	_pendingOffset = -1;
+
+	if(offset < 0){
+		renderSegment(block->data, 0, AUDIO_BLOCK_SAMPLES);
+	} else {
+		renderSegment(block->data, 0, offset);
+		start(_pendingTarget, _pendingSamples);
+		renderSegment(block->data, offset, AUDIO_BLOCK_SAMPLES);
+	}
+
+	transmit(block);
+	release(block);
+}
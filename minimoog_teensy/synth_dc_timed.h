@@ -0,0 +1,70 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* DC level with sample accurate changes, for use with the PJRC audio library.
+ *
+ * It works as the library's AudioSynthWaveformDc : the level is set at once, or ramped to in a given time.
+ * A change can also be given a sample offset : it then happens at this sample of the next block, instead of
+ * at its start, the same way as the notes of the envelope. It's for the key tracking levels, so the pitch of a note
+ * played by the sequencer changes on the sample its envelope starts.
+ *
+ * Only one change waits for the next block : a new one replaces it.
+ */
+
+#ifndef SYNTH_DC_TIMED_H
+#define SYNTH_DC_TIMED_H
+
+#include <Arduino.h>
+#include <AudioStream.h>
+
+class AudioSynthDcTimed : public AudioStream{
+public:
+	AudioSynthDcTimed() : AudioStream(0, NULL){
+		_level = 0;
+		_target = 0;
+		_increment = 0;
+		_pendingOffset = -1;
+		_pendingTarget = 0;
+		_pendingSamples = 0;
+	}
+
+	// Level is from -1.0 to 1.0, ramp time is in milliseconds, offset is in samples from the start of the next block.
+	void amplitude(float n){amplitude(n, 0, 0);}
+	void amplitude(float n, float ms, uint16_t offset = 0);
+
+	float read(){return _level;}
+
+	virtual void update(void);
+
+private:
+	void start(float target, float samples);
+	void renderSegment(int16_t *data, uint16_t start, uint16_t end);
+
+	float _level;
+	float _target;
+	// Change per sample while ramping, zero when the level is steady.
+	float _increment;
+
+	// Pending change, at this offset in the next block. -1 when none.
+	volatile int16_t _pendingOffset;
+	float _pendingTarget;
+	float _pendingSamples;
+};
+
+#endif
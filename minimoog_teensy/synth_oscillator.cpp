@@ -0,0 +1,571 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Audio.h>
+
+#include "synth_oscillator.h"
+
+// Highest phase increment : just under Nyquist.
+static const float MAX_PHASE_INC = 2147000000.0;
+static const uint32_t MAX_INC = MAX_PHASE_INC;
+
+// Coefficients of 2^x - 1 on the fractional part, with 31 bits fraction : a third order polynomial,
+// less than 0.2 cent from the real value.
+static const uint32_t EXP2_C1 = 0.6951786 * 2147483648.0;
+static const uint32_t EXP2_C2 = 0.2261570 * 2147483648.0;
+static const uint32_t EXP2_C3 = 0.0781086 * 2147483648.0;
+
+// Phase increment raised by a number of octaves, with 27 bits fraction. It's done for each sample, in fixed point,
+// as AudioSynthWaveformModulated does.
+static inline uint32_t octaveInc(uint32_t inc, int32_t octaves){
+	int32_t whole = octaves >> 27;
+	uint32_t frac = (octaves & 0x7FFFFFF) << 4;
+	uint32_t value = EXP2_C2 + (((uint64_t)EXP2_C3 * frac) >> 31);
+	value = EXP2_C1 + (((uint64_t)value * frac) >> 31);
+	value = ((uint64_t)value * frac) >> 31;
+	uint64_t scaled = (((uint64_t)inc << 31) + (uint64_t)inc * value) >> (31 - whole);
+	return (scaled > MAX_INC) ? MAX_INC : scaled;
+}
+
+// Phase increment of a carrier, modulated by oscillator 3. It can be negative.
+static inline int32_t modulatedInc(uint32_t inc, float fm){
+	float value = inc * (1.0f + fm);
+	if(value > MAX_PHASE_INC) value = MAX_PHASE_INC;
+	if(value < -MAX_PHASE_INC) value = -MAX_PHASE_INC;
+	return value;
+}
+
+void AudioSynthOscillatorBank::frequency(uint8_t channel, float freq){
+	if(channel >= OSC_BANK_SIZE) return;
+	if(freq < 0.0) freq = 0.0;
+	float inc = freq * 4294967296.0 / AUDIO_SAMPLE_RATE_EXACT;
+	if(inc > MAX_PHASE_INC) inc = MAX_PHASE_INC;
+	_osc[channel].phaseInc = inc;
+}
+
+// Phase increments of the ranges, computed once.
+void AudioSynthOscillatorBank::rangeBase(float freq){
+	for(uint8_t i = 0; i < OSC_NUM_RANGES; ++i){
+		float inc = freq / (1 << i) * 4294967296.0 / AUDIO_SAMPLE_RATE_EXACT;
+		_rangeInc[i] = (inc > MAX_PHASE_INC) ? MAX_PHASE_INC : inc;
+	}
+}
+
+void AudioSynthOscillatorBank::range(uint8_t channel, uint8_t value){
+	if(channel >= OSC_BANK_SIZE) return;
+	if(value >= OSC_NUM_RANGES) value = OSC_NUM_RANGES - 1;
+	OscillatorVoice *osc = &_osc[channel];
+	__disable_irq();
+	if(osc->phaseInc){
+		osc->nextInc = _rangeInc[value];
+		osc->incPending = true;
+		osc->incWait = 0;
+	} else {
+		// Not started yet, there is nothing to wait for.
+		osc->phaseInc = _rangeInc[value];
+		osc->incPending = false;
+	}
+	__enable_irq();
+}
+
+void AudioSynthOscillatorBank::begin(uint8_t channel, short shape){
+	if(channel >= OSC_BANK_SIZE) return;
+	if(shape == _osc[channel].shape) return;
+	__disable_irq();
+	startFade(&_osc[channel]);
+	_osc[channel].shape = shape;
+	__enable_irq();
+}
+
+void AudioSynthOscillatorBank::amplitude(uint8_t channel, float n){
+	if(channel >= OSC_BANK_SIZE) return;
+	if(n < 0.0) n = 0.0;
+	if(n > 1.0) n = 1.0;
+	_osc[channel].magnitude = n * 65536.0;
+}
+
+void AudioSynthOscillatorBank::frequencyModulation(uint8_t channel, float octaves){
+	if(channel >= OSC_BANK_SIZE) return;
+	if(octaves > 12.0) octaves = 12.0;
+	if(octaves < 0.1) octaves = 0.1;
+	_osc[channel].octaves = octaves * 4096.0;
+}
+
+void AudioSynthOscillatorBank::wavetable(uint8_t channel, uint8_t table){
+	if(channel >= OSC_BANK_SIZE) return;
+	if(table >= WT_NUM_TABLES) table = WT_NUM_TABLES - 1;
+	if(table == _osc[channel].table) return;
+	__disable_irq();
+	if(_osc[channel].shape == WAVEFORM_WAVETABLE) startFade(&_osc[channel]);
+	_osc[channel].table = table;
+	__enable_irq();
+}
+
+// Keep the waveform playing, to fade from it to the new one.
+// When the previous change hasn't played yet (wavetable then waveform, from the same control), the waveform
+// it replaced is kept.
+// During a crossfade (blocks shorter than it), the mix playing becomes the previous waveform, with its weights
+// frozen : the output goes on from it without a jump.
+void AudioSynthOscillatorBank::startFade(OscillatorVoice *osc){
+	if(osc->fade == OSC_CROSSFADE_SAMPLES) return;
+	if(osc->fade){
+		// Only two waveforms are kept : what the older one added to the mix is frozen, at the current phase.
+		int32_t older = fadeOutput(osc, osc->phase) - sample(osc, osc->fadeShape, osc->fadeTableA, osc->fadeTableB, osc->phase);
+		osc->fadeOffset = (older * osc->fade) >> OSC_CROSSFADE_BITS;
+		osc->olderShape = osc->fadeShape;
+		osc->olderTable = osc->fadeTable;
+		osc->olderMix = osc->fade;
+	} else {
+		osc->fadeOffset = 0;
+		osc->olderMix = 0;
+	}
+	osc->fadeShape = osc->shape;
+	osc->fadeTable = osc->table;
+	osc->fade = OSC_CROSSFADE_SAMPLES;
+}
+
+void AudioSynthOscillatorBank::morph(uint8_t channel, float value){
+	if(channel >= OSC_BANK_SIZE) return;
+	if(value < 0.0) value = 0.0;
+	if(value > 1.0) value = 1.0;
+	_osc[channel].morph = value * 32767.0;
+}
+
+void AudioSynthOscillatorBank::pulseWidth(float width){
+	if(width < -1.0) width = -1.0;
+	if(width > 1.0) width = 1.0;
+	_width = width * 32767.0;
+}
+
+void AudioSynthOscillatorBank::sync(uint8_t channel, bool value){
+	// Oscillator 1 is the master, it can't be synced.
+	if((channel == 0) || (channel >= OSC_BANK_SIZE)) return;
+	_osc[channel].sync = value;
+}
+
+void AudioSynthOscillatorBank::fmAmount(float value){
+	if(value < 0.0) value = 0.0;
+	if(value > OSC_MAX_FM_AMOUNT) value = OSC_MAX_FM_AMOUNT;
+	_fmAmount = value;
+}
+
+// Mip level : level n holds WT_MAX_HARMONICS >> n harmonics, so it can be played up to
+// a fundamental of 2^n * Nyquist / WT_MAX_HARMONICS.
+void AudioSynthOscillatorBank::prepareTables(OscillatorVoice *osc, uint32_t maxInc){
+	uint32_t ratio = ((uint64_t)maxInc * (2 * WT_MAX_HARMONICS)) >> 32;
+	uint8_t level = ratio ? (32 - __builtin_clz(ratio)) : 0;
+	if(level >= WT_NUM_LEVELS) level = WT_NUM_LEVELS - 1;
+
+	uint8_t bits = WT_LEVEL_BITS[level];
+	uint32_t stride = (1 << bits) + 1;
+	const int16_t *data = WT_DATA + WT_LEVEL_OFFSET[level];
+	osc->shift = 32 - bits;
+	osc->tableA = data + osc->table * stride;
+	osc->tableB = data + ((osc->table + 1) % WT_NUM_TABLES) * stride;
+	osc->fadeTableA = data + osc->fadeTable * stride;
+	osc->fadeTableB = data + ((osc->fadeTable + 1) % WT_NUM_TABLES) * stride;
+	osc->olderTableA = data + osc->olderTable * stride;
+	osc->olderTableB = data + ((osc->olderTable + 1) % WT_NUM_TABLES) * stride;
+}
+
+// Classic waveforms are computed the same way as AudioSynthWaveformModulated does.
+template<short SHAPE> inline int32_t AudioSynthOscillatorBank::shapeSample(OscillatorVoice *osc,
+		const int16_t *tableA, const int16_t *tableB, uint32_t phase){
+	if(SHAPE == WAVEFORM_WAVETABLE){
+		uint32_t index = phase >> osc->shift;
+		// 15 bits fractions : the difference between two samples can take the full 16 bits range.
+		int32_t frac = (phase >> (osc->shift - 15)) & 0x7FFF;
+		int32_t value = tableA[index];
+		value += ((tableA[index + 1] - value) * frac) >> 15;
+		if(osc->morph){
+			int32_t valueB = tableB[index];
+			valueB += ((tableB[index + 1] - valueB) * frac) >> 15;
+			value += ((valueB - value) * osc->morph) >> 15;
+		}
+		return value;
+	}
+	if(SHAPE == WAVEFORM_SINE){
+		uint32_t index = phase >> 24;
+		int32_t value = AudioWaveformSine[index];
+		value += ((AudioWaveformSine[index + 1] - value) * (int32_t)((phase >> 8) & 0xFFFF)) >> 16;
+		return value;
+	}
+	if(SHAPE == WAVEFORM_SAWTOOTH) return (int16_t)(phase >> 16);
+	if(SHAPE == WAVEFORM_SAWTOOTH_REVERSE) return (int16_t)(0xFFFF - (phase >> 16));
+	if(SHAPE == WAVEFORM_SQUARE) return (phase & 0x80000000) ? -32767 : 32767;
+	if(SHAPE == WAVEFORM_TRIANGLE){
+		uint32_t index = phase >> 30;
+		if((index == 1) || (index == 2)){
+			return 0xFFFF - (int32_t)(phase >> 15);
+		}
+		return (int32_t)phase >> 15;
+	}
+	if(SHAPE == WAVEFORM_PULSE) return (phase < ((uint32_t)(_width + 0x8000) << 16)) ? 32767 : -32767;
+	return 0;
+}
+
+inline int32_t AudioSynthOscillatorBank::sample(OscillatorVoice *osc, short shape,
+		const int16_t *tableA, const int16_t *tableB, uint32_t phase){
+	switch(shape){
+		case WAVEFORM_WAVETABLE:
+			return shapeSample<WAVEFORM_WAVETABLE>(osc, tableA, tableB, phase);
+		case WAVEFORM_SINE:
+			return shapeSample<WAVEFORM_SINE>(osc, tableA, tableB, phase);
+		case WAVEFORM_SAWTOOTH:
+			return shapeSample<WAVEFORM_SAWTOOTH>(osc, tableA, tableB, phase);
+		case WAVEFORM_SAWTOOTH_REVERSE:
+			return shapeSample<WAVEFORM_SAWTOOTH_REVERSE>(osc, tableA, tableB, phase);
+		case WAVEFORM_SQUARE:
+			return shapeSample<WAVEFORM_SQUARE>(osc, tableA, tableB, phase);
+		case WAVEFORM_TRIANGLE:
+			return shapeSample<WAVEFORM_TRIANGLE>(osc, tableA, tableB, phase);
+		case WAVEFORM_PULSE:
+			return shapeSample<WAVEFORM_PULSE>(osc, tableA, tableB, phase);
+		default:
+			return 0;
+	}
+}
+
+// Sample of the previous waveform, mixed with the older one after a change during a crossfade.
+inline int32_t AudioSynthOscillatorBank::fadeOutput(OscillatorVoice *osc, uint32_t phase){
+	int32_t value = sample(osc, osc->fadeShape, osc->fadeTableA, osc->fadeTableB, phase);
+	if(osc->olderMix){
+		int32_t older = sample(osc, osc->olderShape, osc->olderTableA, osc->olderTableB, phase);
+		value += ((older - value) * osc->olderMix) >> OSC_CROSSFADE_BITS;
+	}
+	return value + osc->fadeOffset;
+}
+
+// Oscillator sample, crossfaded from the previous waveform after a change.
+inline int32_t AudioSynthOscillatorBank::output(OscillatorVoice *osc, uint32_t phase){
+	int32_t value = sample(osc, osc->shape, osc->tableA, osc->tableB, phase);
+	if(!osc->fade) return value;
+	int32_t previous = fadeOutput(osc, phase);
+	return value + (((previous - value) * osc->fade) >> OSC_CROSSFADE_BITS);
+}
+
+// Waveform of the loops that ask the oscillator for it at each sample : during a crossfade, or for a waveform
+// that has no loop of its own.
+static const short OSC_SHAPE_ANY = -1;
+
+template<short SHAPE> inline int32_t AudioSynthOscillatorBank::voiceSample(OscillatorVoice *osc, uint32_t phase){
+	if(SHAPE == OSC_SHAPE_ANY) return output(osc, phase);
+	return shapeSample<SHAPE>(osc, osc->tableA, osc->tableB, phase);
+}
+
+// The phase goes back to zero at the time the master wrapped.
+// The step this makes is spread over this sample and the previous one (polyBLEP),
+// the previous one is still pending so it can be corrected.
+template<short SHAPE> inline int32_t AudioSynthOscillatorBank::syncedSample(OscillatorVoice *osc, int32_t oscInc, float elapsed){
+	uint32_t resetPhase = osc->phase + (int32_t)(oscInc * (1.0 - elapsed));
+	float step = voiceSample<SHAPE>(osc, 0) - voiceSample<SHAPE>(osc, resetPhase);
+	osc->pending += step * elapsed * elapsed * 0.5;
+	osc->phase = (int32_t)(oscInc * elapsed);
+	return voiceSample<SHAPE>(osc, osc->phase) - step * (1.0 - elapsed) * (1.0 - elapsed) * 0.5;
+}
+
+// Next sample of a slave. "elapsed" is where the master wrapped in this sample, negative when it didn't.
+template<short SHAPE, bool SYNC> inline int32_t AudioSynthOscillatorBank::voiceStep(OscillatorVoice *osc, int32_t oscInc, float elapsed){
+	int32_t value;
+	if(SYNC && (elapsed >= 0.0)){
+		value = syncedSample<SHAPE>(osc, oscInc, elapsed);
+	} else {
+		osc->phase += oscInc;
+		value = voiceSample<SHAPE>(osc, osc->phase);
+	}
+	if((SHAPE == OSC_SHAPE_ANY) && osc->fade) --osc->fade;
+	return value;
+}
+
+// Master phase for one sample, modulated by oscillator 3 as oscillator 2 is.
+// Returns where in the sample it wrapped forward, or -1 when it didn't.
+inline float AudioSynthOscillatorBank::masterStep(int32_t inc[][AUDIO_BLOCK_SAMPLES], uint16_t i, float fm, uint32_t *phase){
+	if(fm){
+		inc[0][i] = modulatedInc(inc[0][i], fm);
+		inc[1][i] = modulatedInc(inc[1][i], fm);
+	}
+	uint32_t previous = *phase;
+	*phase += inc[0][i];
+	if((inc[0][i] > 0) && (*phase < previous)) return (float)*phase / inc[0][i];
+	return -1.0;
+}
+
+// Where the master wraps, for the whole block. Oscillator 3 modulates with its previous sample, given by "modulator".
+void AudioSynthOscillatorBank::masterPhase(int32_t inc[][AUDIO_BLOCK_SAMPLES], float *elapsed, const int32_t *modulator){
+	float fmScale = _fmAmount / 32768.0;
+	uint32_t phase = _osc[0].phase;
+	for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+		float fm = modulator ? modulator[i] * fmScale : 0.0;
+		elapsed[i] = masterStep(inc, i, fm, &phase);
+	}
+}
+
+// Sample sent, at the amplitude of the oscillator.
+static inline int16_t amplified(int32_t value, int32_t magnitude){
+	value = (value * magnitude) >> 16;
+	if(value > 32767) return 32767;
+	if(value < -32768) return -32768;
+	return value;
+}
+
+// One oscillator for the whole block, one sample late. "raw", when given, gets the samples before the amplitude.
+// It works on a copy of the oscillator, that the compiler can keep in registers : it can't tell the outputs from it.
+template<short SHAPE, bool SYNC> void AudioSynthOscillatorBank::renderLoop(OscillatorVoice *osc,
+		const int32_t *inc, const float *elapsed, int16_t *data, int32_t *raw){
+	OscillatorVoice voice = *osc;
+	for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+		int32_t value = voiceStep<SHAPE, SYNC>(&voice, inc[i], SYNC ? elapsed[i] : -1.0f);
+		if(raw) raw[i] = voice.pending;
+		data[i] = amplified(voice.pending, voice.magnitude);
+		voice.pending = value;
+	}
+	*osc = voice;
+}
+
+void AudioSynthOscillatorBank::render(OscillatorVoice *osc, bool sync, const int32_t *inc, const float *elapsed,
+		int16_t *data, int32_t *raw){
+	switch(osc->fade ? OSC_SHAPE_ANY : osc->shape){
+		case WAVEFORM_WAVETABLE:
+			if(sync) renderLoop<WAVEFORM_WAVETABLE, true>(osc, inc, elapsed, data, raw);
+			else renderLoop<WAVEFORM_WAVETABLE, false>(osc, inc, elapsed, data, raw);
+			break;
+		case WAVEFORM_SINE:
+			if(sync) renderLoop<WAVEFORM_SINE, true>(osc, inc, elapsed, data, raw);
+			else renderLoop<WAVEFORM_SINE, false>(osc, inc, elapsed, data, raw);
+			break;
+		case WAVEFORM_SAWTOOTH:
+			if(sync) renderLoop<WAVEFORM_SAWTOOTH, true>(osc, inc, elapsed, data, raw);
+			else renderLoop<WAVEFORM_SAWTOOTH, false>(osc, inc, elapsed, data, raw);
+			break;
+		case WAVEFORM_SAWTOOTH_REVERSE:
+			if(sync) renderLoop<WAVEFORM_SAWTOOTH_REVERSE, true>(osc, inc, elapsed, data, raw);
+			else renderLoop<WAVEFORM_SAWTOOTH_REVERSE, false>(osc, inc, elapsed, data, raw);
+			break;
+		case WAVEFORM_SQUARE:
+			if(sync) renderLoop<WAVEFORM_SQUARE, true>(osc, inc, elapsed, data, raw);
+			else renderLoop<WAVEFORM_SQUARE, false>(osc, inc, elapsed, data, raw);
+			break;
+		case WAVEFORM_TRIANGLE:
+			if(sync) renderLoop<WAVEFORM_TRIANGLE, true>(osc, inc, elapsed, data, raw);
+			else renderLoop<WAVEFORM_TRIANGLE, false>(osc, inc, elapsed, data, raw);
+			break;
+		case WAVEFORM_PULSE:
+			if(sync) renderLoop<WAVEFORM_PULSE, true>(osc, inc, elapsed, data, raw);
+			else renderLoop<WAVEFORM_PULSE, false>(osc, inc, elapsed, data, raw);
+			break;
+		default:
+			if(sync) renderLoop<OSC_SHAPE_ANY, true>(osc, inc, elapsed, data, raw);
+			else renderLoop<OSC_SHAPE_ANY, false>(osc, inc, elapsed, data, raw);
+			break;
+	}
+}
+
+// Oscillator 3, synced to the master while it modulates it : the master phase needs the previous sample
+// of oscillator 3, and oscillator 3 needs where the master wrapped, so both go sample by sample.
+// The master and oscillator 2 are then rendered from the increments modulated here.
+template<short SHAPE> void AudioSynthOscillatorBank::renderCoupled(int32_t inc[][AUDIO_BLOCK_SAMPLES], float *elapsed, int16_t *data){
+	OscillatorVoice voice = _osc[2];
+	float fmScale = _fmAmount / 32768.0;
+	uint32_t phase = _osc[0].phase;
+	for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+		elapsed[i] = masterStep(inc, i, voice.pending * fmScale, &phase);
+		int32_t value = voiceStep<SHAPE, true>(&voice, inc[2][i], elapsed[i]);
+		data[i] = amplified(voice.pending, voice.magnitude);
+		voice.pending = value;
+	}
+	_osc[2] = voice;
+}
+
+void AudioSynthOscillatorBank::renderSyncedModulator(int32_t inc[][AUDIO_BLOCK_SAMPLES], float *elapsed, int16_t *data){
+	switch(_osc[2].fade ? OSC_SHAPE_ANY : _osc[2].shape){
+		case WAVEFORM_WAVETABLE:
+			renderCoupled<WAVEFORM_WAVETABLE>(inc, elapsed, data);
+			break;
+		case WAVEFORM_SINE:
+			renderCoupled<WAVEFORM_SINE>(inc, elapsed, data);
+			break;
+		case WAVEFORM_SAWTOOTH:
+			renderCoupled<WAVEFORM_SAWTOOTH>(inc, elapsed, data);
+			break;
+		case WAVEFORM_SAWTOOTH_REVERSE:
+			renderCoupled<WAVEFORM_SAWTOOTH_REVERSE>(inc, elapsed, data);
+			break;
+		case WAVEFORM_SQUARE:
+			renderCoupled<WAVEFORM_SQUARE>(inc, elapsed, data);
+			break;
+		case WAVEFORM_TRIANGLE:
+			renderCoupled<WAVEFORM_TRIANGLE>(inc, elapsed, data);
+			break;
+		case WAVEFORM_PULSE:
+			renderCoupled<WAVEFORM_PULSE>(inc, elapsed, data);
+			break;
+		default:
+			renderCoupled<OSC_SHAPE_ANY>(inc, elapsed, data);
+			break;
+	}
+}
+
+// Oscillator 3 first when it modulates, then the master phase, that tells the slaves where to reset.
+void AudioSynthOscillatorBank::renderApart(int32_t inc[][AUDIO_BLOCK_SAMPLES], audio_block_t **block){
+	float elapsed[AUDIO_BLOCK_SAMPLES];
+	// Samples of oscillator 3 before the amplitude, for the modulation.
+	int32_t modulation[AUDIO_BLOCK_SAMPLES];
+	OscillatorVoice *modulator = &_osc[2];
+	bool fm = (_fmAmount != 0.0);
+	bool synced = _osc[1].sync || modulator->sync;
+
+	if(fm && modulator->sync){
+		renderSyncedModulator(inc, elapsed, block[2]->data);
+	} else {
+		if(fm) render(modulator, false, inc[2], NULL, block[2]->data, modulation);
+		if(fm || synced) masterPhase(inc, elapsed, fm ? modulation : NULL);
+		if(!fm) render(modulator, modulator->sync, inc[2], elapsed, block[2]->data, NULL);
+	}
+	render(&_osc[0], false, inc[0], NULL, block[0]->data, NULL);
+	render(&_osc[1], _osc[1].sync, inc[1], elapsed, block[1]->data, NULL);
+}
+
+// The three oscillators sample by sample, while a range change waits for a turn of the waveform :
+// it can change the increments of the master in the middle of the block.
+void AudioSynthOscillatorBank::renderTogether(int32_t inc[][AUDIO_BLOCK_SAMPLES], audio_block_t **block){
+	// Ratio applied to the increments of the block, from the sample where a range change happened.
+	float rangeScale[OSC_BANK_SIZE];
+	OscillatorVoice *master = &_osc[0];
+	float fmScale = _fmAmount / 32768.0;
+
+	for(uint8_t n = 0; n < OSC_BANK_SIZE; ++n){
+		rangeScale[n] = 1.0;
+	}
+
+	for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+		// Oscillator 3 modulates with its previous sample, as it can itself be synced to oscillator 1.
+		float fm = _osc[2].pending * fmScale;
+
+		// Increments, after a range change in this block.
+		for(uint8_t n = 0; n < OSC_BANK_SIZE; ++n){
+			if(rangeScale[n] == 1.0) continue;
+			float value = inc[n][i] * rangeScale[n];
+			inc[n][i] = (value > MAX_PHASE_INC) ? MAX_PHASE_INC : value;
+		}
+
+		// Master. A sync happens when it wraps forward, at a fraction of sample it gives.
+		float elapsed = masterStep(inc, i, fm, &master->phase);
+
+		for(uint8_t n = 0; n < OSC_BANK_SIZE; ++n){
+			OscillatorVoice *osc = &_osc[n];
+			int32_t value;
+			if(n){
+				value = osc->sync ? voiceStep<OSC_SHAPE_ANY, true>(osc, inc[n][i], elapsed)
+						: voiceStep<OSC_SHAPE_ANY, false>(osc, inc[n][i], elapsed);
+			} else {
+				value = output(osc, osc->phase);
+				if(osc->fade) --osc->fade;
+			}
+
+			// A range change is applied where the slope of the waveform crosses zero (a peak of a sine or triangle,
+			// the reset of a saw, the edge of a square) : the slope doesn't jump, so the change is not heard.
+			if(osc->incPending){
+				int32_t slope = value - osc->pending;
+				bool turn = osc->incWait && ((slope ^ osc->slope) < 0);
+				osc->slope = slope;
+				if(turn || (++osc->incWait >= OSC_RANGE_TIMEOUT)){
+					rangeScale[n] *= (float)osc->nextInc / osc->phaseInc;
+					osc->phaseInc = osc->nextInc;
+					osc->incPending = false;
+				}
+			}
+
+			block[n]->data[i] = amplified(osc->pending, osc->magnitude);
+			osc->pending = value;
+		}
+	}
+}
+
+void AudioSynthOscillatorBank::update(void){
+	audio_block_t *block[OSC_BANK_SIZE];
+	int32_t inc[OSC_BANK_SIZE][AUDIO_BLOCK_SAMPLES];
+	bool allocated = true;
+	bool ranging = false;
+
+	// Phase increments for the whole block first : the wavetable mode needs the highest one.
+	for(uint8_t n = 0; n < OSC_BANK_SIZE; ++n){
+		OscillatorVoice *osc = &_osc[n];
+		audio_block_t *mod = receiveReadOnly(n);
+		uint32_t maxInc = osc->phaseInc;
+		if(mod){
+			// Local copies : the compiler can't tell the increments written from the oscillator.
+			uint32_t phaseInc = osc->phaseInc;
+			int32_t octaves = osc->octaves;
+			int16_t highest = -32768;
+			for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+				inc[n][i] = octaveInc(phaseInc, mod->data[i] * octaves);
+				if(mod->data[i] > highest) highest = mod->data[i];
+			}
+			release(mod);
+			// 2^x only goes up : the highest increment is the one of the highest modulation.
+			maxInc = octaveInc(phaseInc, highest * octaves);
+		} else {
+			for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+				inc[n][i] = osc->phaseInc;
+			}
+		}
+
+		// A range change can happen during the block, the wavetable must suit the higher range.
+		if(osc->incPending){
+			ranging = true;
+			if(osc->nextInc > osc->phaseInc){
+				float value = (float)maxInc * osc->nextInc / osc->phaseInc;
+				maxInc = (value > MAX_PHASE_INC) ? MAX_PHASE_INC : value;
+			}
+		}
+
+		// Oscillators 1 and 2 can be pushed higher by the linear modulation.
+		if(n < 2){
+			float value = maxInc * (1.0 + _fmAmount);
+			maxInc = (value > MAX_PHASE_INC) ? MAX_PHASE_INC : value;
+		}
+		bool tables = (osc->shape == WAVEFORM_WAVETABLE);
+		if(osc->fade){
+			tables |= (osc->fadeShape == WAVEFORM_WAVETABLE) || (osc->olderMix && (osc->olderShape == WAVEFORM_WAVETABLE));
+		}
+		if(tables) prepareTables(osc, maxInc);
+
+		block[n] = allocate();
+		if(!block[n]) allocated = false;
+	}
+
+	if(!allocated){
+		for(uint8_t n = 0; n < OSC_BANK_SIZE; ++n){
+			if(block[n]) release(block[n]);
+			for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i) _osc[n].phase += inc[n][i];
+		}
+		return;
+	}
+
+	if(ranging){
+		renderTogether(inc, block);
+	} else {
+		renderApart(inc, block);
+	}
+
+	for(uint8_t n = 0; n < OSC_BANK_SIZE; ++n){
+		transmit(block[n], n);
+		release(block[n]);
+	}
+}
@@ -0,0 +1,208 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Oscillator bank for the synth, for use with the PJRC audio library.
+ *
+ * The three oscillators are computed together, in one node, so they can interact at audio rate
+ * without any patch cord between them :
+ *	input n		frequency modulation of oscillator n, in octaves (see frequencyModulation())
+ *	output n	oscillator n
+ *
+ * Classic waveforms are the ones of AudioSynthWaveformModulated.
+ * The wavetable mode plays band-limited wavetables, stored in flash as one mip level per octave
+ * (see wavetables.h). The level is chosen once per block, from the highest pitch reached in the block,
+ * so the oscillator never plays harmonics above Nyquist. The morph setting slides from the selected table
+ * to the next one.
+ *
+ * Oscillators 2 and 3 can be hard synced to oscillator 1. The reset is band-limited with a polyBLEP :
+ * the step is spread over the samples around the reset, which is why the outputs are one sample late.
+ * Oscillator 3 can modulate the frequency of oscillators 1 and 2 linearly. The modulation can go through zero,
+ * the phase then runs backward.
+ *
+ * Each oscillator is rendered in its own loop, made for its waveform, after the phases of the master that the others
+ * need. Only a synced oscillator 3 that modulates goes sample by sample with the master, and all three do while
+ * a range change waits.
+ *
+ * Range and waveform can be changed while a note plays, without click. A range change, from a table computed
+ * once, waits for the next turn of the waveform (where its slope crosses zero). A waveform (or wavetable) change is crossfaded
+ * from the previous one, over OSC_CROSSFADE_SAMPLES. A change during a crossfade fades from the mix playing.
+ */
+
+#ifndef SYNTH_OSCILLATOR_H
+#define SYNTH_OSCILLATOR_H
+
+#include <Arduino.h>
+#include <AudioStream.h>
+
+#include "wavetables.h"
+
+// Waveform number for the wavetable mode. Classic ones are the WAVEFORM_* of the audio library.
+#define WAVEFORM_WAVETABLE				100
+
+const uint8_t OSC_BANK_SIZE = 3;
+
+// Highest linear frequency modulation index.
+const float OSC_MAX_FM_AMOUNT = 4.0;
+
+// Ranges, from the base frequency down, one octave each.
+const uint8_t OSC_NUM_RANGES = 6;
+// Waveform crossfade length, and longest wait for a turn of the waveform before a range change is applied anyway.
+const uint8_t OSC_CROSSFADE_BITS = 6;
+const uint8_t OSC_CROSSFADE_SAMPLES = 1 << OSC_CROSSFADE_BITS;
+const uint16_t OSC_RANGE_TIMEOUT = 1024;
+
+struct OscillatorVoice{
+	uint32_t phase;
+	uint32_t phaseInc;
+	int32_t magnitude;
+	// Octaves of a full scale modulation, 12 bits fraction.
+	int32_t octaves;
+	short shape;
+	uint8_t table;
+	uint16_t morph;
+	bool sync;
+
+	// Tables for the current block, in wavetable mode.
+	const int16_t *tableA;
+	const int16_t *tableB;
+	uint8_t shift;
+
+	// Sample waiting to be sent, for the BLEP correction.
+	int32_t pending;
+
+	// Range change, waiting for the slope to cross zero.
+	uint32_t nextInc;
+	bool incPending;
+	uint16_t incWait;
+	int32_t slope;
+
+	// Previous waveform, and samples left in the crossfade from it.
+	// After a change during a crossfade, the previous waveform is the mix that was playing : the waveform that was
+	// fading out stays in it (older), at the weight it had. What was mixed before that is kept as an offset.
+	short fadeShape;
+	uint8_t fadeTable;
+	const int16_t *fadeTableA;
+	const int16_t *fadeTableB;
+	short olderShape;
+	uint8_t olderTable;
+	const int16_t *olderTableA;
+	const int16_t *olderTableB;
+	uint8_t olderMix;
+	int32_t fadeOffset;
+	uint8_t fade;
+};
+
+class AudioSynthOscillatorBank : public AudioStream{
+public:
+	AudioSynthOscillatorBank() : AudioStream(OSC_BANK_SIZE, inputQueueArray){
+		for(uint8_t i = 0; i < OSC_BANK_SIZE; ++i){
+			_osc[i].phase = 0;
+			_osc[i].phaseInc = 0;
+			_osc[i].magnitude = 0;
+			_osc[i].octaves = 4096;
+			_osc[i].shape = 0;
+			_osc[i].table = 0;
+			_osc[i].morph = 0;
+			_osc[i].sync = false;
+			_osc[i].tableA = 0;
+			_osc[i].tableB = 0;
+			_osc[i].shift = 32;
+			_osc[i].pending = 0;
+			_osc[i].nextInc = 0;
+			_osc[i].incPending = false;
+			_osc[i].incWait = 0;
+			_osc[i].slope = 0;
+			_osc[i].fadeShape = 0;
+			_osc[i].fadeTable = 0;
+			_osc[i].fadeTableA = 0;
+			_osc[i].fadeTableB = 0;
+			_osc[i].olderShape = 0;
+			_osc[i].olderTable = 0;
+			_osc[i].olderTableA = 0;
+			_osc[i].olderTableB = 0;
+			_osc[i].olderMix = 0;
+			_osc[i].fadeOffset = 0;
+			_osc[i].fade = 0;
+		}
+		_width = 0;
+		_fmAmount = 0;
+		rangeBase(1.0);
+	}
+
+	void begin(uint8_t channel, short shape);
+	void begin(uint8_t channel, float amp, float freq, short shape){
+		amplitude(channel, amp);
+		frequency(channel, freq);
+		begin(channel, shape);
+	}
+
+	// Frequency is applied right away. Range waits for a turn of the waveform, it's for changes while playing.
+	void frequency(uint8_t channel, float freq);
+	void rangeBase(float freq);
+	void range(uint8_t channel, uint8_t value);
+	void amplitude(uint8_t channel, float n);
+	void frequencyModulation(uint8_t channel, float octaves);
+
+	// Wavetable selection, from 0 to WT_NUM_TABLES - 1, and morph to the next table, from 0 to 1.
+	void wavetable(uint8_t channel, uint8_t table);
+	void morph(uint8_t channel, float value);
+
+	// Pulse width for the pulse waveform, shared by the three oscillators. From -1 to 1, 0 is square.
+	void pulseWidth(float width);
+
+	// Hard sync of oscillator 2 or 3 (channel 1 or 2) to oscillator 1.
+	void sync(uint8_t channel, bool value);
+
+	// Linear modulation of oscillators 1 and 2 by oscillator 3. Over 1 the frequency goes through zero.
+	void fmAmount(float value);
+
+	virtual void update(void);
+
+private:
+	template<short SHAPE> int32_t shapeSample(OscillatorVoice *osc, const int16_t *tableA, const int16_t *tableB, uint32_t phase);
+	int32_t sample(OscillatorVoice *osc, short shape, const int16_t *tableA, const int16_t *tableB, uint32_t phase);
+	int32_t fadeOutput(OscillatorVoice *osc, uint32_t phase);
+	int32_t output(OscillatorVoice *osc, uint32_t phase);
+	template<short SHAPE> int32_t voiceSample(OscillatorVoice *osc, uint32_t phase);
+	template<short SHAPE> int32_t syncedSample(OscillatorVoice *osc, int32_t oscInc, float elapsed);
+	template<short SHAPE, bool SYNC> int32_t voiceStep(OscillatorVoice *osc, int32_t oscInc, float elapsed);
+	void startFade(OscillatorVoice *osc);
+	void prepareTables(OscillatorVoice *osc, uint32_t maxInc);
+
+	// The block is rendered one oscillator after the other, each with a loop for its waveform. Only when a range
+	// change waits for a turn of the waveform are the three rendered together, sample by sample.
+	float masterStep(int32_t inc[][AUDIO_BLOCK_SAMPLES], uint16_t i, float fm, uint32_t *phase);
+	void masterPhase(int32_t inc[][AUDIO_BLOCK_SAMPLES], float *elapsed, const int32_t *modulator);
+	template<short SHAPE, bool SYNC> void renderLoop(OscillatorVoice *osc, const int32_t *inc, const float *elapsed,
+			int16_t *data, int32_t *raw);
+	void render(OscillatorVoice *osc, bool sync, const int32_t *inc, const float *elapsed, int16_t *data, int32_t *raw);
+	template<short SHAPE> void renderCoupled(int32_t inc[][AUDIO_BLOCK_SAMPLES], float *elapsed, int16_t *data);
+	void renderSyncedModulator(int32_t inc[][AUDIO_BLOCK_SAMPLES], float *elapsed, int16_t *data);
+	void renderApart(int32_t inc[][AUDIO_BLOCK_SAMPLES], audio_block_t **block);
+	void renderTogether(int32_t inc[][AUDIO_BLOCK_SAMPLES], audio_block_t **block);
+
+	audio_block_t *inputQueueArray[OSC_BANK_SIZE];
+
+	OscillatorVoice _osc[OSC_BANK_SIZE];
+	uint32_t _rangeInc[OSC_NUM_RANGES];
+	int16_t _width;
+	float _fmAmount;
+};
+
+#endif
@@ -0,0 +1,390 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Audio.h>
+
+#include "synth_sequencer.h"
+
+// Time of an event that is not scheduled.
+static const double NEVER = 1e300;
+// Phase-locked loop gains, applied on each clock tick : the phase follows 10% of the error, the period 0.5%.
+// This is about critically damped, and settles in around twenty ticks (less than a beat).
+static const double CLOCK_PHASE_GAIN = 0.1;
+static const double CLOCK_PERIOD_GAIN = 0.005;
+// The lock is lost when no tick came for this many periods (clock stopped, cable unplugged).
+static const double CLOCK_TIMEOUT = 4.0;
+// Longest time between two ticks, in seconds, when the period is not known yet : a tick at 20 bpm.
+static const double CLOCK_MAX_TICK = 0.125;
+
+AudioSynthSequencer::AudioSynthSequencer() : AudioStream(0, NULL){
+	_handleNoteOn = NULL;
+	_handleNoteOff = NULL;
+
+	_mode = SEQUENCER_OFF;
+	_division = 4;
+	_gate = 0.5;
+	_octaves = 1;
+	_external = false;
+	tempo(120);
+
+	_count = 0;
+	_restart = false;
+	_patternLength = 0;
+
+	_time = 0;
+	_nextStep = NEVER;
+	_nextOff = NEVER;
+	_step = 0;
+	_gateOpen = false;
+
+	_blockTime = 0;
+	_blockMicros = 0;
+	_tickCount = 0;
+	_startReceived = false;
+	_stopReceived = false;
+	_continueReceived = false;
+
+	_running = false;
+	_tickSeen = false;
+	_locked = false;
+	_tickPhase = 0;
+	_tickPeriod = 0;
+	_tickIndex = -1;
+	_stepTick = 0;
+
+	// There is no patch cord to this node, it has to be updated anyway.
+	active = true;
+}
+
+void AudioSynthSequencer::mode(sequencerMode_t value){
+	__disable_irq();
+	_mode = value;
+	_count = 0;
+	_step = 0;
+	__enable_irq();
+}
+
+void AudioSynthSequencer::tempo(float bpm){
+	if(bpm < 20.0) bpm = 20.0;
+	if(bpm > 400.0) bpm = 400.0;
+	_tempo = bpm;
+	_stepLength = AUDIO_SAMPLE_RATE_EXACT * 60.0 / (_tempo * _division);
+}
+
+// Steps per beat must divide the MIDI clock resolution : 1, 2, 3, 4, 6, 8...
+void AudioSynthSequencer::division(uint8_t stepsPerBeat){
+	if(stepsPerBeat < 1) stepsPerBeat = 1;
+	while(SEQUENCER_CLOCK_PPQN % stepsPerBeat) --stepsPerBeat;
+	_division = stepsPerBeat;
+	_stepLength = AUDIO_SAMPLE_RATE_EXACT * 60.0 / (_tempo * _division);
+}
+
+void AudioSynthSequencer::gate(float ratio){
+	if(ratio < 0.05) ratio = 0.05;
+	if(ratio > 1.0) ratio = 1.0;
+	_gate = ratio;
+}
+
+void AudioSynthSequencer::octaves(uint8_t value){
+	if(value < 1) value = 1;
+	if(value > 4) value = 4;
+	_octaves = value;
+}
+
+void AudioSynthSequencer::externalClock(bool value){
+	_external = value;
+	_restart = true;
+}
+
+void AudioSynthSequencer::noteOn(uint8_t note, uint8_t velocity){
+	__disable_irq();
+	uint8_t i = 0;
+	for(; i < _count; ++i){
+		if(_note[i] == note) break;
+	}
+	if(i == _count){
+		if(_count >= SEQUENCER_MAX_NOTES){
+			__enable_irq();
+			return;
+		}
+		if(_count == 0) _restart = true;
+		_note[i] = note;
+		++_count;
+	}
+	_velocity[i] = velocity;
+	__enable_irq();
+}
+
+void AudioSynthSequencer::noteOff(uint8_t note){
+	__disable_irq();
+	for(uint8_t i = 0; i < _count; ++i){
+		if(_note[i] != note) continue;
+		// Keep the played order.
+		for(uint8_t j = i + 1; j < _count; ++j){
+			_note[j - 1] = _note[j];
+			_velocity[j - 1] = _velocity[j];
+		}
+		--_count;
+		break;
+	}
+	__enable_irq();
+}
+
+void AudioSynthSequencer::allNotesOff(){
+	_count = 0;
+}
+
+void AudioSynthSequencer::clearPattern(){
+	_patternLength = 0;
+}
+
+bool AudioSynthSequencer::addStep(uint8_t note, uint8_t velocity){
+	if(_patternLength >= SEQUENCER_MAX_STEPS) return false;
+	_patternNote[_patternLength] = note;
+	_patternVelocity[_patternLength] = velocity;
+	++_patternLength;
+	return true;
+}
+
+// Timestamp the tick, in samples. The clock is computed in the next update.
+void AudioSynthSequencer::clock(){
+	__disable_irq();
+	double time = _blockTime + (double)(micros() - _blockMicros) * AUDIO_SAMPLE_RATE_EXACT / 1000000.0;
+	if(_tickCount < 8) _tickQueue[_tickCount++] = time;
+	__enable_irq();
+}
+
+void AudioSynthSequencer::start(){
+	_startReceived = true;
+}
+
+void AudioSynthSequencer::stop(){
+	_stopReceived = true;
+}
+
+void AudioSynthSequencer::resume(){
+	_continueReceived = true;
+}
+
+float AudioSynthSequencer::clockTempo(){
+	if(!_locked) return 0.0;
+	return AUDIO_SAMPLE_RATE_EXACT * 60.0 / (_tickPeriod * SEQUENCER_CLOCK_PPQN);
+}
+
+// One clock tick, at "time". The phase is the estimated time of the last tick, the period the estimated time
+// between two ticks : each tick corrects both by a part of the error between the tick and its prediction.
+void AudioSynthSequencer::updateClock(double time){
+	++_tickIndex;
+
+	if(_locked){
+		double predicted = _tickPhase + _tickPeriod;
+		double error = time - predicted;
+		if(fabs(error) < _tickPeriod){
+			_tickPhase = predicted + CLOCK_PHASE_GAIN * error;
+			_tickPeriod += CLOCK_PERIOD_GAIN * error;
+			return;
+		}
+		// Too far from the prediction : the tempo jumped, lock again from this tick.
+		_locked = false;
+	}
+
+	if(_tickSeen && (time > _tickPhase)){
+		_tickPeriod = time - _tickPhase;
+		_locked = true;
+	}
+	_tickPhase = time;
+	_tickSeen = true;
+}
+
+// The next step is on the next tick that is a multiple of the ticks per step, counted from the start message.
+void AudioSynthSequencer::scheduleClockStep(){
+	if(!_running || !_tickSeen){
+		_nextStep = NEVER;
+	} else if(!_locked){
+		// Only one tick is known : the step on this tick is played right now.
+		_nextStep = (_stepTick <= _tickIndex) ? _tickPhase : NEVER;
+	} else {
+		_nextStep = _tickPhase + (double)(_stepTick - _tickIndex) * _tickPeriod;
+	}
+}
+
+void AudioSynthSequencer::playStep(uint16_t offset, double time){
+	uint8_t velocity = 0;
+	int16_t note = nextNote(&velocity);
+	if(note < 0) return;
+
+	if(_handleNoteOn) _handleNoteOn(note, velocity, offset);
+	_gateOpen = true;
+
+	double length = _stepLength;
+	if(_external && _locked) length = _tickPeriod * SEQUENCER_CLOCK_PPQN / _division;
+	_nextOff = (_gate < 1.0) ? time + length * _gate : NEVER;
+}
+
+// The note of the current step, and step to the next one.
+int16_t AudioSynthSequencer::nextNote(uint8_t *velocity){
+	uint8_t count = _count;
+	if(!count) return -1;
+
+	if(_mode == SEQUENCER_PLAY){
+		if(!_patternLength) return -1;
+		uint8_t lower = 127;
+		for(uint8_t i = 0; i < count; ++i){
+			if(_note[i] < lower) lower = _note[i];
+		}
+		uint8_t index = _step++ % _patternLength;
+		int16_t note = (int16_t)_patternNote[index] + lower - _patternNote[0];
+		*velocity = _patternVelocity[index];
+		if(note < 0) note = 0;
+		if(note > 127) note = 127;
+		return note;
+	}
+
+	// Keys in played order, or sorted from lower to upper.
+	uint8_t order[SEQUENCER_MAX_NOTES];
+	for(uint8_t i = 0; i < count; ++i){
+		order[i] = i;
+	}
+	if(_mode != SEQUENCER_ARP_PLAYED){
+		for(uint8_t i = 1; i < count; ++i){
+			uint8_t index = order[i];
+			uint8_t j = i;
+			for(; (j > 0) && (_note[order[j - 1]] > _note[index]); --j){
+				order[j] = order[j - 1];
+			}
+			order[j] = index;
+		}
+	}
+
+	// Each octave repeats the keys, one octave up.
+	uint16_t length = count * _octaves;
+	uint16_t position = 0;
+	switch(_mode){
+		case SEQUENCER_ARP_DOWN:
+			position = length - 1 - (_step % length);
+			break;
+		case SEQUENCER_ARP_UP_DOWN:
+			// The ends are not repeated.
+			if(length > 1){
+				uint16_t period = 2 * length - 2;
+				position = _step % period;
+				if(position >= length) position = period - position;
+			}
+			break;
+		default:
+			position = _step % length;
+			break;
+	}
+	++_step;
+
+	uint8_t index = order[position % count];
+	*velocity = _velocity[index];
+	int16_t note = _note[index] + 12 * (position / count);
+	return (note > 127) ? 127 : note;
+}
+
+void AudioSynthSequencer::update(void){
+	double blockStart = _time;
+	double blockEnd = _time + AUDIO_BLOCK_SAMPLES;
+	double ticks[8];
+
+	// Take the clock messages received since the last update.
+	__disable_irq();
+	uint8_t tickCount = _tickCount;
+	for(uint8_t i = 0; i < tickCount; ++i){
+		ticks[i] = _tickQueue[i];
+	}
+	_tickCount = 0;
+	bool startReceived = _startReceived;
+	bool stopReceived = _stopReceived;
+	bool continueReceived = _continueReceived;
+	_startReceived = false;
+	_stopReceived = false;
+	_continueReceived = false;
+	_blockTime = blockStart;
+	_blockMicros = micros();
+	__enable_irq();
+
+	uint8_t ticksPerStep = SEQUENCER_CLOCK_PPQN / _division;
+
+	if(startReceived){
+		_running = true;
+		_tickIndex = -1;
+		_stepTick = 0;
+		_step = 0;
+	}
+	if(continueReceived) _running = true;
+	if(stopReceived){
+		_running = false;
+		if(_external && _gateOpen) _nextOff = blockStart;
+	}
+	for(uint8_t i = 0; i < tickCount; ++i){
+		updateClock(ticks[i]);
+	}
+	double timeout = _locked ? CLOCK_TIMEOUT * _tickPeriod : CLOCK_MAX_TICK * AUDIO_SAMPLE_RATE_EXACT;
+	if(_tickSeen && (blockStart > _tickPhase + timeout)){
+		_tickSeen = false;
+		_locked = false;
+	}
+
+	bool playing = isPlaying() && (_count > 0);
+
+	// The first key held starts the steps : right now on the internal clock, on the next step of the MIDI clock.
+	if(_restart){
+		_restart = false;
+		_step = 0;
+		if(!_external){
+			_nextStep = blockStart;
+		} else if(_tickIndex >= 0){
+			_stepTick = (_tickIndex / ticksPerStep + 1) * ticksPerStep;
+		}
+	}
+	if(_external) scheduleClockStep();
+
+	// When the keys are released, the note playing is stopped.
+	if(!playing && _gateOpen && (_nextOff > blockStart)) _nextOff = blockStart;
+
+	// Note on and off due in this block, in time order.
+	for(;;){
+		bool stepDue = playing && (_nextStep < blockEnd);
+		bool offDue = _gateOpen && (_nextOff < blockEnd);
+		if(!stepDue && !offDue) break;
+
+		if(offDue && (!stepDue || (_nextOff <= _nextStep))){
+			uint16_t offset = (_nextOff > blockStart) ? _nextOff - blockStart : 0;
+			if(_handleNoteOff) _handleNoteOff(offset);
+			_gateOpen = false;
+			_nextOff = NEVER;
+			continue;
+		}
+
+		uint16_t offset = (_nextStep > blockStart) ? _nextStep - blockStart : 0;
+		playStep(offset, _nextStep);
+		if(_external){
+			_stepTick += ticksPerStep;
+			while(_stepTick <= _tickIndex) _stepTick += ticksPerStep;
+			scheduleClockStep();
+		} else {
+			_nextStep += _stepLength;
+			if(_nextStep < blockStart) _nextStep = blockStart;
+		}
+	}
+
+	_time = blockEnd;
+}
@@ -0,0 +1,156 @@
+// Minimoog - Teensy
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Arpeggiator and step sequencer for the synth, for use with the PJRC audio library.
+ *
+ * It has no audio input or output : it's an audio node only to run with the audio clock.
+ * It's declared first in the graph, so it updates before any other node of the same cycle : the note on and off
+ * it sends from its update land in the block being computed, at the sample they are due.
+ * The envelopes take the sample offset, the pitch (a DC level) changes at the start of the block.
+ *
+ * Steps are timed from the internal tempo, or from MIDI clock. MIDI clock messages are only timestamped
+ * when they arrive, then a phase-locked loop estimates the tempo and phase from them, so the steps follow the
+ * clock without its jitter (USB frames, MIDI polling).
+ *
+ * Notes are played while keys are held : the arpeggiator plays the keys held, the sequencer plays the recorded
+ * pattern, transposed by the lower key held.
+ */
+
+#ifndef SYNTH_SEQUENCER_H
+#define SYNTH_SEQUENCER_H
+
+#include <Arduino.h>
+#include <AudioStream.h>
+
+const uint8_t SEQUENCER_MAX_NOTES = 16;
+const uint8_t SEQUENCER_MAX_STEPS = 16;
+// MIDI clock resolution, in ticks per quarter note.
+const uint8_t SEQUENCER_CLOCK_PPQN = 24;
+
+enum sequencerMode_t{
+	SEQUENCER_OFF = 0,
+	SEQUENCER_ARP_UP,
+	SEQUENCER_ARP_DOWN,
+	SEQUENCER_ARP_UP_DOWN,
+	SEQUENCER_ARP_PLAYED,
+	SEQUENCER_PLAY,
+	SEQUENCER_RECORD,
+};
+
+class AudioSynthSequencer : public AudioStream{
+public:
+	AudioSynthSequencer();
+
+	void mode(sequencerMode_t value);
+	sequencerMode_t mode(){return _mode;}
+	// True when the keys go to the sequencer instead of being played.
+	bool isPlaying(){return (_mode != SEQUENCER_OFF) && (_mode != SEQUENCER_RECORD);}
+
+	// Internal tempo, in beats per minute, and steps per beat.
+	void tempo(float bpm);
+	void division(uint8_t stepsPerBeat);
+	// Gate length, as a ratio of the step. At 1, notes are tied.
+	void gate(float ratio);
+	// Octave range of the arpeggiator.
+	void octaves(uint8_t value);
+	void externalClock(bool value);
+
+	// Keys held, from the main loop.
+	void noteOn(uint8_t note, uint8_t velocity);
+	void noteOff(uint8_t note);
+	void allNotesOff();
+
+	// Pattern, recorded from the keys.
+	void clearPattern();
+	bool addStep(uint8_t note, uint8_t velocity);
+	uint8_t patternLength(){return _patternLength;}
+	uint8_t patternNote(uint8_t step){return _patternNote[step];}
+	uint8_t patternVelocity(uint8_t step){return _patternVelocity[step];}
+
+	// MIDI real time messages. They can be called from an interrupt.
+	void clock();
+	void start();
+	void stop();
+	void resume();
+	// Tempo estimated from MIDI clock, 0 when not locked.
+	float clockTempo();
+
+	// Note on and off are sent with their offset, in samples, in the block being computed.
+	void setHandleNoteOn(void (*fptr)(uint8_t note, uint8_t velocity, uint16_t offset)){_handleNoteOn = fptr;}
+	void setHandleNoteOff(void (*fptr)(uint16_t offset)){_handleNoteOff = fptr;}
+
+	virtual void update(void);
+
+private:
+	void updateClock(double time);
+	void scheduleClockStep();
+	void playStep(uint16_t offset, double time);
+	int16_t nextNote(uint8_t *velocity);
+
+	void (*_handleNoteOn)(uint8_t note, uint8_t velocity, uint16_t offset);
+	void (*_handleNoteOff)(uint16_t offset);
+
+	volatile sequencerMode_t _mode;
+	float _tempo;
+	// In samples. A double, as the step times it's added to : in a float, the steps would drift from the grid.
+	double _stepLength;
+	float _gate;
+	uint8_t _division;
+	uint8_t _octaves;
+	bool _external;
+
+	// Keys held, in the order they were pressed.
+	uint8_t _note[SEQUENCER_MAX_NOTES];
+	uint8_t _velocity[SEQUENCER_MAX_NOTES];
+	volatile uint8_t _count;
+	volatile bool _restart;
+
+	uint8_t _patternNote[SEQUENCER_MAX_STEPS];
+	uint8_t _patternVelocity[SEQUENCER_MAX_STEPS];
+	uint8_t _patternLength;
+
+	// Times are in samples, counted from power up.
+	double _time;
+	double _nextStep;
+	double _nextOff;
+	uint32_t _step;
+	bool _gateOpen;
+
+	// Block start time, as seen by micros(), for timestamping MIDI clock.
+	volatile double _blockTime;
+	volatile uint32_t _blockMicros;
+
+	// MIDI clock ticks timestamped, waiting for the next update.
+	double _tickQueue[8];
+	volatile uint8_t _tickCount;
+	volatile bool _startReceived;
+	volatile bool _stopReceived;
+	volatile bool _continueReceived;
+
+	// Phase-locked loop on the MIDI clock.
+	bool _running;
+	bool _tickSeen;
+	bool _locked;
+	double _tickPhase;
+	double _tickPeriod;
+	int32_t _tickIndex;
+	int32_t _stepTick;
+};
+
+#endif
@@ -0,0 +1,922 @@
+// Minimoog - Teensy
+// Generated by tools/make_wavetables.py, do not edit.
+
+#include "wavetables.h"
+
+const uint8_t WT_LEVEL_BITS[WT_NUM_LEVELS] = {10, 9, 8, 7, 6, 6, 6, 6};
+const uint32_t WT_LEVEL_OFFSET[WT_NUM_LEVELS] = {0, 6150, 9228, 10770, 11544, 11934, 12324, 12714};
+
+const int16_t WT_DATA[13104] PROGMEM = {
+	// level 0, saw
+	0, 23677, 32000, 27758, 24373, 26673, 28715, 27031, 25444, 26635, 27795, 26738, 25680, 26466, 27272, 26499,
+	25694, 26270, 26886, 26275, 25619, 26066, 26562, 26056, 25497, 25858, 26273, 25840, 25350, 25648, 26003, 25625,
+	25187, 25437, 25747, 25410, 25012, 25225, 25500, 25197, 24830, 25014, 25260, 24983, 24643, 24802, 25024, 24770,
+	24451, 24589, 24792, 24556, 24256, 24377, 24563, 24343, 24059, 24165, 24336, 24130, 23859, 23952, 24111, 23917,
+	23658, 23740, 23887, 23704, 23456, 23527, 23664, 23491, 23252, 23314, 23443, 23278, 23048, 23102, 23222, 23066,
+	22842, 22889, 23003, 22853, 22636, 22677, 22784, 22640, 22429, 22464, 22565, 22427, 22222, 22251, 22347, 22214,
+	22015, 22039, 22129, 22001, 21807, 21826, 21912, 21789, 21598, 21613, 21695, 21576, 21390, 21400, 21478, 21363,
+	21181, 21188, 21262, 21150, 20971, 20975, 21046, 20937, 20762, 20762, 20830, 20725, 20552, 20550, 20614, 20512,
+	20343, 20337, 20398, 20299, 20133, 20124, 20183, 20086, 19922, 19911, 19968, 19873, 19712, 19699, 19752, 19661,
+	19502, 19486, 19537, 19448, 19291, 19273, 19322, 19235, 19081, 19060, 19108, 19022, 18870, 18848, 18893, 18810,
+	18659, 18635, 18678, 18597, 18448, 18422, 18464, 18384, 18237, 18209, 18249, 18171, 18026, 17997, 18035, 17959,
+	17815, 17784, 17821, 17746, 17604, 17571, 17606, 17533, 17392, 17358, 17392, 17320, 17181, 17146, 17178, 17108,
+	16970, 16933, 16964, 16895, 16758, 16720, 16750, 16682, 16547, 16507, 16536, 16469, 16335, 16295, 16322, 16256,
+	16124, 16082, 16108, 16044, 15912, 15869, 15894, 15831, 15700, 15657, 15680, 15618, 15489, 15444, 15466, 15405,
+	15277, 15231, 15253, 15193, 15065, 15018, 15039, 14980, 14853, 14806, 14825, 14767, 14642, 14593, 14611, 14554,
+	14430, 14380, 14398, 14342, 14218, 14167, 14184, 14129, 14006, 13955, 13970, 13916, 13794, 13742, 13757, 13703,
+	13582, 13529, 13543, 13491, 13370, 13316, 13330, 13278, 13158, 13104, 13116, 13065, 12946, 12891, 12903, 12852,
+	12734, 12678, 12689, 12640, 12522, 12465, 12476, 12427, 12310, 12253, 12262, 12214, 12098, 12040, 12049, 12001,
+	11886, 11827, 11835, 11789, 11674, 11614, 11622, 11576, 11462, 11402, 11408, 11363, 11250, 11189, 11195, 11150,
+	11038, 10976, 10982, 10938, 10826, 10763, 10768, 10725, 10614, 10551, 10555, 10512, 10402, 10338, 10341, 10299,
+	10190, 10125, 10128, 10087, 9977, 9912, 9915, 9874, 9765, 9700, 9701, 9661, 9553, 9487, 9488, 9448,
+	9341, 9274, 9275, 9236, 9129, 9061, 9061, 9023, 8916, 8848, 8848, 8810, 8704, 8636, 8635, 8597,
+	8492, 8423, 8422, 8385, 8280, 8210, 8208, 8172, 8068, 7997, 7995, 7959, 7855, 7785, 7782, 7746,
+	7643, 7572, 7568, 7533, 7431, 7359, 7355, 7321, 7219, 7146, 7142, 7108, 7006, 6934, 6929, 6895,
+	6794, 6721, 6716, 6682, 6582, 6508, 6502, 6470, 6370, 6295, 6289, 6257, 6157, 6083, 6076, 6044,
+	5945, 5870, 5863, 5831, 5733, 5657, 5649, 5619, 5520, 5444, 5436, 5406, 5308, 5232, 5223, 5193,
+	5096, 5019, 5010, 4980, 4884, 4806, 4797, 4768, 4671, 4593, 4583, 4555, 4459, 4381, 4370, 4342,
+	4247, 4168, 4157, 4129, 4034, 3955, 3944, 3917, 3822, 3742, 3731, 3704, 3610, 3530, 3517, 3491,
+	3397, 3317, 3304, 3278, 3185, 3104, 3091, 3066, 2973, 2891, 2878, 2853, 2760, 2679, 2665, 2640,
+	2548, 2466, 2451, 2427, 2336, 2253, 2238, 2215, 2123, 2040, 2025, 2002, 1911, 1828, 1812, 1789,
+	1699, 1615, 1599, 1576, 1486, 1402, 1386, 1364, 1274, 1189, 1172, 1151, 1062, 977, 959, 938,
+	849, 764, 746, 725, 637, 551, 533, 513, 425, 338, 320, 300, 212, 126, 107, 87,
+	0, -87, -107, -126, -212, -300, -320, -338, -425, -513, -533, -551, -637, -725, -746, -764,
+	-849, -938, -959, -977, -1062, -1151, -1172, -1189, -1274, -1364, -1386, -1402, -1486, -1576, -1599, -1615,
+	-1699, -1789, -1812, -1828, -1911, -2002, -2025, -2040, -2123, -2215, -2238, -2253, -2336, -2427, -2451, -2466,
+	-2548, -2640, -2665, -2679, -2760, -2853, -2878, -2891, -2973, -3066, -3091, -3104, -3185, -3278, -3304, -3317,
+	-3397, -3491, -3517, -3530, -3610, -3704, -3731, -3742, -3822, -3917, -3944, -3955, -4034, -4129, -4157, -4168,
+	-4247, -4342, -4370, -4381, -4459, -4555, -4583, -4593, -4671, -4768, -4797, -4806, -4884, -4980, -5010, -5019,
+	-5096, -5193, -5223, -5232, -5308, -5406, -5436, -5444, -5520, -5619, -5649, -5657, -5733, -5831, -5863, -5870,
+	-5945, -6044, -6076, -6083, -6157, -6257, -6289, -6295, -6370, -6470, -6502, -6508, -6582, -6682, -6716, -6721,
+	-6794, -6895, -6929, -6934, -7006, -7108, -7142, -7146, -7219, -7321, -7355, -7359, -7431, -7533, -7568, -7572,
+	-7643, -7746, -7782, -7785, -7855, -7959, -7995, -7997, -8068, -8172, -8208, -8210, -8280, -8385, -8422, -8423,
+	-8492, -8597, -8635, -8636, -8704, -8810, -8848, -8848, -8916, -9023, -9061, -9061, -9129, -9236, -9275, -9274,
+	-9341, -9448, -9488, -9487, -9553, -9661, -9701, -9700, -9765, -9874, -9915, -9912, -9977, -10087, -10128, -10125,
+	-10190, -10299, -10341, -10338, -10402, -10512, -10555, -10551, -10614, -10725, -10768, -10763, -10826, -10938, -10982, -10976,
+	-11038, -11150, -11195, -11189, -11250, -11363, -11408, -11402, -11462, -11576, -11622, -11614, -11674, -11789, -11835, -11827,
+	-11886, -12001, -12049, -12040, -12098, -12214, -12262, -12253, -12310, -12427, -12476, -12465, -12522, -12640, -12689, -12678,
+	-12734, -12852, -12903, -12891, -12946, -13065, -13116, -13104, -13158, -13278, -13330, -13316, -13370, -13491, -13543, -13529,
+	-13582, -13703, -13757, -13742, -13794, -13916, -13970, -13955, -14006, -14129, -14184, -14167, -14218, -14342, -14398, -14380,
+	-14430, -14554, -14611, -14593, -14642, -14767, -14825, -14806, -14853, -14980, -15039, -15018, -15065, -15193, -15253, -15231,
+	-15277, -15405, -15466, -15444, -15489, -15618, -15680, -15657, -15700, -15831, -15894, -15869, -15912, -16044, -16108, -16082,
+	-16124, -16256, -16322, -16295, -16335, -16469, -16536, -16507, -16547, -16682, -16750, -16720, -16758, -16895, -16964, -16933,
+	-16970, -17108, -17178, -17146, -17181, -17320, -17392, -17358, -17392, -17533, -17606, -17571, -17604, -17746, -17821, -17784,
+	-17815, -17959, -18035, -17997, -18026, -18171, -18249, -18209, -18237, -18384, -18464, -18422, -18448, -18597, -18678, -18635,
+	-18659, -18810, -18893, -18848, -18870, -19022, -19108, -19060, -19081, -19235, -19322, -19273, -19291, -19448, -19537, -19486,
+	-19502, -19661, -19752, -19699, -19712, -19873, -19968, -19911, -19922, -20086, -20183, -20124, -20133, -20299, -20398, -20337,
+	-20343, -20512, -20614, -20550, -20552, -20725, -20830, -20762, -20762, -20937, -21046, -20975, -20971, -21150, -21262, -21188,
+	-21181, -21363, -21478, -21400, -21390, -21576, -21695, -21613, -21598, -21789, -21912, -21826, -21807, -22001, -22129, -22039,
+	-22015, -22214, -22347, -22251, -22222, -22427, -22565, -22464, -22429, -22640, -22784, -22677, -22636, -22853, -23003, -22889,
+	-22842, -23066, -23222, -23102, -23048, -23278, -23443, -23314, -23252, -23491, -23664, -23527, -23456, -23704, -23887, -23740,
+	-23658, -23917, -24111, -23952, -23859, -24130, -24336, -24165, -24059, -24343, -24563, -24377, -24256, -24556, -24792, -24589,
+	-24451, -24770, -25024, -24802, -24643, -24983, -25260, -25014, -24830, -25197, -25500, -25225, -25012, -25410, -25747, -25437,
+	-25187, -25625, -26003, -25648, -25350, -25840, -26273, -25858, -25497, -26056, -26562, -26066, -25619, -26275, -26886, -26270,
+	-25694, -26499, -27272, -26466, -25680, -26738, -27795, -26635, -25444, -27031, -28715, -26673, -24373, -27758, -32000, -23677,
+	0,
+	// level 0, square
+	0, 21932, 29631, 25734, 22690, 24893, 26797, 25259, 23874, 25055, 26144, 25185, 24288, 25095, 25858, 25161,
+	24497, 25111, 25698, 25151, 24623, 25118, 25596, 25145, 24707, 25122, 25526, 25142, 24768, 25125, 25474, 25139,
+	24813, 25127, 25434, 25138, 24848, 25128, 25403, 25137, 24876, 25129, 25378, 25136, 24899, 25130, 25357, 25136,
+	24918, 25130, 25340, 25135, 24934, 25130, 25325, 25135, 24947, 25131, 25312, 25135, 24959, 25131, 25301, 25134,
+	24969, 25131, 25291, 25134, 24979, 25131, 25283, 25134, 24987, 25132, 25275, 25134, 24994, 25132, 25268, 25134,
+	25000, 25132, 25262, 25134, 25006, 25132, 25257, 25134, 25011, 25132, 25252, 25133, 25016, 25132, 25247, 25133,
+	25020, 25132, 25243, 25133, 25024, 25132, 25239, 25133, 25028, 25132, 25236, 25133, 25031, 25132, 25233, 25133,
+	25034, 25132, 25230, 25133, 25037, 25132, 25227, 25133, 25040, 25132, 25225, 25133, 25042, 25132, 25222, 25133,
+	25044, 25132, 25220, 25133, 25046, 25132, 25218, 25133, 25048, 25132, 25216, 25133, 25050, 25132, 25214, 25133,
+	25052, 25132, 25213, 25133, 25053, 25133, 25211, 25133, 25055, 25133, 25210, 25133, 25056, 25133, 25209, 25133,
+	25058, 25133, 25207, 25133, 25059, 25133, 25206, 25133, 25060, 25133, 25205, 25133, 25061, 25133, 25204, 25133,
+	25062, 25133, 25203, 25133, 25063, 25133, 25202, 25133, 25064, 25133, 25201, 25133, 25064, 25133, 25201, 25133,
+	25065, 25133, 25200, 25133, 25066, 25133, 25199, 25133, 25066, 25133, 25199, 25133, 25067, 25133, 25198, 25133,
+	25067, 25133, 25198, 25133, 25068, 25133, 25197, 25133, 25068, 25133, 25197, 25133, 25069, 25133, 25197, 25133,
+	25069, 25133, 25196, 25133, 25069, 25133, 25196, 25133, 25070, 25133, 25196, 25133, 25070, 25133, 25196, 25133,
+	25070, 25133, 25195, 25133, 25070, 25133, 25195, 25133, 25070, 25133, 25195, 25133, 25070, 25133, 25195, 25133,
+	25070, 25133, 25195, 25133, 25070, 25133, 25195, 25133, 25070, 25133, 25195, 25133, 25070, 25133, 25195, 25133,
+	25070, 25133, 25196, 25133, 25070, 25133, 25196, 25133, 25070, 25133, 25196, 25133, 25069, 25133, 25196, 25133,
+	25069, 25133, 25197, 25133, 25069, 25133, 25197, 25133, 25068, 25133, 25197, 25133, 25068, 25133, 25198, 25133,
+	25067, 25133, 25198, 25133, 25067, 25133, 25199, 25133, 25066, 25133, 25199, 25133, 25066, 25133, 25200, 25133,
+	25065, 25133, 25201, 25133, 25064, 25133, 25201, 25133, 25064, 25133, 25202, 25133, 25063, 25133, 25203, 25133,
+	25062, 25133, 25204, 25133, 25061, 25133, 25205, 25133, 25060, 25133, 25206, 25133, 25059, 25133, 25207, 25133,
+	25058, 25133, 25209, 25133, 25056, 25133, 25210, 25133, 25055, 25133, 25211, 25133, 25053, 25133, 25213, 25132,
+	25052, 25133, 25214, 25132, 25050, 25133, 25216, 25132, 25048, 25133, 25218, 25132, 25046, 25133, 25220, 25132,
+	25044, 25133, 25222, 25132, 25042, 25133, 25225, 25132, 25040, 25133, 25227, 25132, 25037, 25133, 25230, 25132,
+	25034, 25133, 25233, 25132, 25031, 25133, 25236, 25132, 25028, 25133, 25239, 25132, 25024, 25133, 25243, 25132,
+	25020, 25133, 25247, 25132, 25016, 25133, 25252, 25132, 25011, 25134, 25257, 25132, 25006, 25134, 25262, 25132,
+	25000, 25134, 25268, 25132, 24994, 25134, 25275, 25132, 24987, 25134, 25283, 25131, 24979, 25134, 25291, 25131,
+	24969, 25134, 25301, 25131, 24959, 25135, 25312, 25131, 24947, 25135, 25325, 25130, 24934, 25135, 25340, 25130,
+	24918, 25136, 25357, 25130, 24899, 25136, 25378, 25129, 24876, 25137, 25403, 25128, 24848, 25138, 25434, 25127,
+	24813, 25139, 25474, 25125, 24768, 25142, 25526, 25122, 24707, 25145, 25596, 25118, 24623, 25151, 25698, 25111,
+	24497, 25161, 25858, 25095, 24288, 25185, 26144, 25055, 23874, 25259, 26797, 24893, 22690, 25734, 29631, 21932,
+	0, -21932, -29631, -25734, -22690, -24893, -26797, -25259, -23874, -25055, -26144, -25185, -24288, -25095, -25858, -25161,
+	-24497, -25111, -25698, -25151, -24623, -25118, -25596, -25145, -24707, -25122, -25526, -25142, -24768, -25125, -25474, -25139,
+	-24813, -25127, -25434, -25138, -24848, -25128, -25403, -25137, -24876, -25129, -25378, -25136, -24899, -25130, -25357, -25136,
+	-24918, -25130, -25340, -25135, -24934, -25130, -25325, -25135, -24947, -25131, -25312, -25135, -24959, -25131, -25301, -25134,
+	-24969, -25131, -25291, -25134, -24979, -25131, -25283, -25134, -24987, -25132, -25275, -25134, -24994, -25132, -25268, -25134,
+	-25000, -25132, -25262, -25134, -25006, -25132, -25257, -25134, -25011, -25132, -25252, -25133, -25016, -25132, -25247, -25133,
+	-25020, -25132, -25243, -25133, -25024, -25132, -25239, -25133, -25028, -25132, -25236, -25133, -25031, -25132, -25233, -25133,
+	-25034, -25132, -25230, -25133, -25037, -25132, -25227, -25133, -25040, -25132, -25225, -25133, -25042, -25132, -25222, -25133,
+	-25044, -25132, -25220, -25133, -25046, -25132, -25218, -25133, -25048, -25132, -25216, -25133, -25050, -25132, -25214, -25133,
+	-25052, -25132, -25213, -25133, -25053, -25133, -25211, -25133, -25055, -25133, -25210, -25133, -25056, -25133, -25209, -25133,
+	-25058, -25133, -25207, -25133, -25059, -25133, -25206, -25133, -25060, -25133, -25205, -25133, -25061, -25133, -25204, -25133,
+	-25062, -25133, -25203, -25133, -25063, -25133, -25202, -25133, -25064, -25133, -25201, -25133, -25064, -25133, -25201, -25133,
+	-25065, -25133, -25200, -25133, -25066, -25133, -25199, -25133, -25066, -25133, -25199, -25133, -25067, -25133, -25198, -25133,
+	-25067, -25133, -25198, -25133, -25068, -25133, -25197, -25133, -25068, -25133, -25197, -25133, -25069, -25133, -25197, -25133,
+	-25069, -25133, -25196, -25133, -25069, -25133, -25196, -25133, -25070, -25133, -25196, -25133, -25070, -25133, -25196, -25133,
+	-25070, -25133, -25195, -25133, -25070, -25133, -25195, -25133, -25070, -25133, -25195, -25133, -25070, -25133, -25195, -25133,
+	-25070, -25133, -25195, -25133, -25070, -25133, -25195, -25133, -25070, -25133, -25195, -25133, -25070, -25133, -25195, -25133,
+	-25070, -25133, -25196, -25133, -25070, -25133, -25196, -25133, -25070, -25133, -25196, -25133, -25069, -25133, -25196, -25133,
+	-25069, -25133, -25197, -25133, -25069, -25133, -25197, -25133, -25068, -25133, -25197, -25133, -25068, -25133, -25198, -25133,
+	-25067, -25133, -25198, -25133, -25067, -25133, -25199, -25133, -25066, -25133, -25199, -25133, -25066, -25133, -25200, -25133,
+	-25065, -25133, -25201, -25133, -25064, -25133, -25201, -25133, -25064, -25133, -25202, -25133, -25063, -25133, -25203, -25133,
+	-25062, -25133, -25204, -25133, -25061, -25133, -25205, -25133, -25060, -25133, -25206, -25133, -25059, -25133, -25207, -25133,
+	-25058, -25133, -25209, -25133, -25056, -25133, -25210, -25133, -25055, -25133, -25211, -25133, -25053, -25133, -25213, -25132,
+	-25052, -25133, -25214, -25132, -25050, -25133, -25216, -25132, -25048, -25133, -25218, -25132, -25046, -25133, -25220, -25132,
+	-25044, -25133, -25222, -25132, -25042, -25133, -25225, -25132, -25040, -25133, -25227, -25132, -25037, -25133, -25230, -25132,
+	-25034, -25133, -25233, -25132, -25031, -25133, -25236, -25132, -25028, -25133, -25239, -25132, -25024, -25133, -25243, -25132,
+	-25020, -25133, -25247, -25132, -25016, -25133, -25252, -25132, -25011, -25134, -25257, -25132, -25006, -25134, -25262, -25132,
+	-25000, -25134, -25268, -25132, -24994, -25134, -25275, -25132, -24987, -25134, -25283, -25131, -24979, -25134, -25291, -25131,
+	-24969, -25134, -25301, -25131, -24959, -25135, -25312, -25131, -24947, -25135, -25325, -25130, -24934, -25135, -25340, -25130,
+	-24918, -25136, -25357, -25130, -24899, -25136, -25378, -25129, -24876, -25137, -25403, -25128, -24848, -25138, -25434, -25127,
+	-24813, -25139, -25474, -25125, -24768, -25142, -25526, -25122, -24707, -25145, -25596, -25118, -24623, -25151, -25698, -25111,
+	-24497, -25161, -25858, -25095, -24288, -25185, -26144, -25055, -23874, -25259, -26797, -24893, -22690, -25734, -29631, -21932,
+	0,
+	// level 0, organ
+	0, 1331, 2659, 3980, 5291, 6589, 7871, 9134, 10374, 11590, 12778, 13935, 15061, 16151, 17205, 18221,
+	19196, 20131, 21023, 21872, 22677, 23437, 24153, 24824, 25450, 26032, 26571, 27066, 27520, 27933, 28306, 28642,
+	28940, 29203, 29433, 29631, 29800, 29940, 30055, 30145, 30214, 30262, 30292, 30305, 30304, 30290, 30264, 30229,
+	30185, 30135, 30079, 30018, 29953, 29886, 29818, 29748, 29677, 29606, 29535, 29464, 29394, 29324, 29254, 29185,
+	29115, 29045, 28974, 28902, 28828, 28752, 28674, 28593, 28508, 28420, 28327, 28230, 28129, 28022, 27909, 27791,
+	27668, 27539, 27405, 27265, 27121, 26971, 26817, 26659, 26498, 26333, 26167, 25998, 25829, 25660, 25491, 25324,
+	25159, 24997, 24839, 24686, 24537, 24396, 24261, 24133, 24013, 23902, 23800, 23708, 23624, 23551, 23487, 23433,
+	23389, 23354, 23329, 23312, 23303, 23302, 23307, 23319, 23336, 23357, 23382, 23409, 23437, 23466, 23493, 23519,
+	23541, 23559, 23571, 23577, 23575, 23564, 23544, 23514, 23472, 23419, 23353, 23274, 23182, 23076, 22957, 22823,
+	22677, 22516, 22343, 22156, 21958, 21747, 21527, 21296, 21056, 20807, 20552, 20291, 20026, 19757, 19486, 19214,
+	18942, 18672, 18404, 18141, 17883, 17631, 17387, 17151, 16924, 16707, 16501, 16305, 16122, 15950, 15791, 15644,
+	15509, 15385, 15274, 15174, 15085, 15006, 14936, 14874, 14820, 14772, 14730, 14691, 14656, 14621, 14588, 14553,
+	14515, 14474, 14428, 14376, 14316, 14247, 14169, 14080, 13980, 13867, 13741, 13602, 13449, 13281, 13099, 12903,
+	12692, 12468, 12230, 11979, 11716, 11441, 11156, 10861, 10558, 10249, 9933, 9614, 9291, 8968, 8645, 8324,
+	8007, 7696, 7391, 7095, 6809, 6534, 6273, 6025, 5793, 5577, 5379, 5199, 5039, 4897, 4776, 4675,
+	4595, 4535, 4495, 4474, 4473, 4491, 4527, 4579, 4647, 4730, 4826, 4934, 5053, 5180, 5315, 5456,
+	5600, 5747, 5895, 6041, 6185, 6325, 6458, 6584, 6702, 6809, 6905, 6989, 7060, 7116, 7158, 7184,
+	7195, 7189, 7168, 7130, 7077, 7009, 6926, 6829, 6718, 6595, 6460, 6316, 6162, 6001, 5834, 5662,
+	5487, 5310, 5133, 4958, 4785, 4617, 4455, 4301, 4156, 4020, 3896, 3785, 3687, 3603, 3535, 3482,
+	3445, 3425, 3422, 3436, 3466, 3513, 3576, 3654, 3748, 3856, 3977, 4111, 4256, 4411, 4575, 4747,
+	4926, 5109, 5296, 5485, 5674, 5863, 6050, 6233, 6411, 6584, 6750, 6907, 7055, 7193, 7321, 7436,
+	7540, 7632, 7711, 7777, 7830, 7871, 7899, 7915, 7919, 7912, 7894, 7867, 7831, 7787, 7737, 7680,
+	7619, 7554, 7487, 7418, 7349, 7282, 7216, 7154, 7096, 7044, 6997, 6958, 6926, 6903, 6889, 6884,
+	6890, 6905, 6930, 6965, 7010, 7065, 7130, 7203, 7285, 7374, 7470, 7573, 7680, 7791, 7906, 8022,
+	8140, 8257, 8372, 8485, 8593, 8697, 8794, 8883, 8964, 9035, 9096, 9145, 9182, 9206, 9216, 9212,
+	9193, 9159, 9109, 9044, 8963, 8867, 8755, 8628, 8487, 8330, 8160, 7976, 7779, 7570, 7349, 7118,
+	6877, 6626, 6367, 6100, 5827, 5547, 5262, 4973, 4679, 4383, 4083, 3781, 3478, 3173, 2867, 2560,
+	2252, 1944, 1635, 1326, 1015, 704, 392, 78, -238, -556, -877, -1200, -1527, -1858, -2193, -2532,
+	-2877, -3226, -3581, -3942, -4309, -4681, -5059, -5443, -5832, -6226, -6625, -7027, -7433, -7841, -8251, -8660,
+	-9069, -9476, -9879, -10276, -10667, -11050, -11421, -11781, -12127, -12456, -12768, -13059, -13328, -13573, -13791, -13982,
+	-14143, -14272, -14367, -14428, -14452, -14438, -14385, -14292, -14158, -13982, -13764, -13505, -13202, -12857, -12471, -12043,
+	-11575, -11067, -10521, -9938, -9319, -8668, -7985, -7273, -6535, -5772, -4989, -4186, -3368, -2537, -1697, -850,
+	0, 850, 1697, 2537, 3368, 4186, 4989, 5772, 6535, 7273, 7985, 8668, 9319, 9938, 10521, 11067,
+	11575, 12043, 12471, 12857, 13202, 13505, 13764, 13982, 14158, 14292, 14385, 14438, 14452, 14428, 14367, 14272,
+	14143, 13982, 13791, 13573, 13328, 13059, 12768, 12456, 12127, 11781, 11421, 11050, 10667, 10276, 9879, 9476,
+	9069, 8660, 8251, 7841, 7433, 7027, 6625, 6226, 5832, 5443, 5059, 4681, 4309, 3942, 3581, 3226,
+	2877, 2532, 2193, 1858, 1527, 1200, 877, 556, 238, -78, -392, -704, -1015, -1326, -1635, -1944,
+	-2252, -2560, -2867, -3173, -3478, -3781, -4083, -4383, -4679, -4973, -5262, -5547, -5827, -6100, -6367, -6626,
+	-6877, -7118, -7349, -7570, -7779, -7976, -8160, -8330, -8487, -8628, -8755, -8867, -8963, -9044, -9109, -9159,
+	-9193, -9212, -9216, -9206, -9182, -9145, -9096, -9035, -8964, -8883, -8794, -8697, -8593, -8485, -8372, -8257,
+	-8140, -8022, -7906, -7791, -7680, -7573, -7470, -7374, -7285, -7203, -7130, -7065, -7010, -6965, -6930, -6905,
+	-6890, -6884, -6889, -6903, -6926, -6958, -6997, -7044, -7096, -7154, -7216, -7282, -7349, -7418, -7487, -7554,
+	-7619, -7680, -7737, -7787, -7831, -7867, -7894, -7912, -7919, -7915, -7899, -7871, -7830, -7777, -7711, -7632,
+	-7540, -7436, -7321, -7193, -7055, -6907, -6750, -6584, -6411, -6233, -6050, -5863, -5674, -5485, -5296, -5109,
+	-4926, -4747, -4575, -4411, -4256, -4111, -3977, -3856, -3748, -3654, -3576, -3513, -3466, -3436, -3422, -3425,
+	-3445, -3482, -3535, -3603, -3687, -3785, -3896, -4020, -4156, -4301, -4455, -4617, -4785, -4958, -5133, -5310,
+	-5487, -5662, -5834, -6001, -6162, -6316, -6460, -6595, -6718, -6829, -6926, -7009, -7077, -7130, -7168, -7189,
+	-7195, -7184, -7158, -7116, -7060, -6989, -6905, -6809, -6702, -6584, -6458, -6325, -6185, -6041, -5895, -5747,
+	-5600, -5456, -5315, -5180, -5053, -4934, -4826, -4730, -4647, -4579, -4527, -4491, -4473, -4474, -4495, -4535,
+	-4595, -4675, -4776, -4897, -5039, -5199, -5379, -5577, -5793, -6025, -6273, -6534, -6809, -7095, -7391, -7696,
+	-8007, -8324, -8645, -8968, -9291, -9614, -9933, -10249, -10558, -10861, -11156, -11441, -11716, -11979, -12230, -12468,
+	-12692, -12903, -13099, -13281, -13449, -13602, -13741, -13867, -13980, -14080, -14169, -14247, -14316, -14376, -14428, -14474,
+	-14515, -14553, -14588, -14621, -14656, -14691, -14730, -14772, -14820, -14874, -14936, -15006, -15085, -15174, -15274, -15385,
+	-15509, -15644, -15791, -15950, -16122, -16305, -16501, -16707, -16924, -17151, -17387, -17631, -17883, -18141, -18404, -18672,
+	-18942, -19214, -19486, -19757, -20026, -20291, -20552, -20807, -21056, -21296, -21527, -21747, -21958, -22156, -22343, -22516,
+	-22677, -22823, -22957, -23076, -23182, -23274, -23353, -23419, -23472, -23514, -23544, -23564, -23575, -23577, -23571, -23559,
+	-23541, -23519, -23493, -23466, -23437, -23409, -23382, -23357, -23336, -23319, -23307, -23302, -23303, -23312, -23329, -23354,
+	-23389, -23433, -23487, -23551, -23624, -23708, -23800, -23902, -24013, -24133, -24261, -24396, -24537, -24686, -24839, -24997,
+	-25159, -25324, -25491, -25660, -25829, -25998, -26167, -26333, -26498, -26659, -26817, -26971, -27121, -27265, -27405, -27539,
+	-27668, -27791, -27909, -28022, -28129, -28230, -28327, -28420, -28508, -28593, -28674, -28752, -28828, -28902, -28974, -29045,
+	-29115, -29185, -29254, -29324, -29394, -29464, -29535, -29606, -29677, -29748, -29818, -29886, -29953, -30018, -30079, -30135,
+	-30185, -30229, -30264, -30290, -30304, -30305, -30292, -30262, -30214, -30145, -30055, -29940, -29800, -29631, -29433, -29203,
+	-28940, -28642, -28306, -27933, -27520, -27066, -26571, -26032, -25450, -24824, -24153, -23437, -22677, -21872, -21023, -20131,
+	-19196, -18221, -17205, -16151, -15061, -13935, -12778, -11590, -10374, -9134, -7871, -6589, -5291, -3980, -2659, -1331,
+	0,
+	// level 0, vocal
+	0, 11224, 16031, 15578, 15465, 17701, 19799, 20305, 20811, 22431, 23986, 24561, 25076, 26298, 27464, 27901,
+	28255, 29113, 29914, 30130, 30252, 30761, 31217, 31183, 31057, 31247, 31394, 31124, 30771, 30691, 30584, 30121,
+	29590, 29308, 29015, 28423, 27779, 27370, 26971, 26319, 25634, 25176, 24746, 24103, 23443, 23005, 22609, 22033,
+	21452, 21085, 20771, 20302, 19833, 19570, 19363, 19017, 18673, 18521, 18424, 18196, 17967, 17913, 17907, 17774,
+	17631, 17644, 17697, 17620, 17522, 17561, 17627, 17562, 17463, 17482, 17518, 17418, 17274, 17232, 17197, 17024,
+	16800, 16664, 16530, 16259, 15932, 15685, 15437, 15057, 14621, 14261, 13902, 13418, 12883, 12423, 11970, 11403,
+	10792, 10260, 9743, 9125, 8472, 7903, 7360, 6729, 6074, 5509, 4980, 4377, 3759, 3237, 2761, 2222,
+	1677, 1233, 841, 397, -48, -389, -673, -1003, -1330, -1554, -1719, -1925, -2129, -2232, -2277, -2362,
+	-2447, -2435, -2369, -2345, -2324, -2213, -2053, -1936, -1829, -1640, -1407, -1221, -1051, -806, -524, -293,
+	-82, 195, 504, 758, 987, 1275, 1591, 1850, 2079, 2361, 2669, 2917, 3132, 3397, 3684, 3912,
+	4105, 4345, 4606, 4808, 4975, 5186, 5418, 5593, 5733, 5915, 6120, 6269, 6383, 6540, 6719, 6845,
+	6937, 7072, 7229, 7335, 7409, 7524, 7664, 7754, 7812, 7912, 8035, 8112, 8157, 8242, 8353, 8417,
+	8450, 8522, 8620, 8672, 8693, 8752, 8837, 8877, 8885, 8931, 9001, 9028, 9023, 9054, 9109, 9121,
+	9102, 9117, 9156, 9153, 9119, 9117, 9140, 9122, 9072, 9054, 9060, 9027, 8962, 8928, 8919, 8871,
+	8792, 8744, 8721, 8661, 8570, 8510, 8475, 8405, 8304, 8234, 8190, 8111, 8003, 7926, 7875, 7792,
+	7679, 7597, 7543, 7457, 7342, 7258, 7202, 7116, 7002, 6918, 6863, 6779, 6668, 6586, 6534, 6454,
+	6346, 6268, 6220, 6145, 6043, 5970, 5927, 5857, 5762, 5694, 5657, 5594, 5505, 5443, 5412, 5356,
+	5273, 5218, 5192, 5143, 5067, 5017, 4997, 4954, 4885, 4841, 4826, 4789, 4725, 4686, 4677, 4645,
+	4587, 4553, 4548, 4521, 4467, 4437, 4436, 4413, 4363, 4337, 4339, 4320, 4274, 4250, 4255, 4239,
+	4196, 4174, 4181, 4168, 4127, 4107, 4116, 4105, 4066, 4047, 4057, 4048, 4010, 3992, 4003, 3994,
+	3958, 3940, 3951, 3943, 3907, 3889, 3900, 3893, 3857, 3839, 3849, 3842, 3806, 3788, 3797, 3790,
+	3754, 3734, 3743, 3735, 3699, 3678, 3686, 3678, 3641, 3619, 3626, 3617, 3579, 3557, 3563, 3553,
+	3514, 3491, 3495, 3485, 3446, 3421, 3425, 3413, 3374, 3348, 3350, 3338, 3298, 3271, 3273, 3260,
+	3219, 3192, 3192, 3179, 3138, 3109, 3109, 3096, 3054, 3025, 3023, 3010, 2968, 2938, 2936, 2922,
+	2880, 2849, 2847, 2833, 2790, 2759, 2756, 2742, 2700, 2668, 2665, 2651, 2609, 2577, 2573, 2559,
+	2517, 2485, 2481, 2467, 2424, 2392, 2388, 2374, 2332, 2299, 2295, 2281, 2240, 2207, 2202, 2189,
+	2147, 2114, 2110, 2097, 2055, 2022, 2017, 2005, 1964, 1930, 1925, 1913, 1872, 1839, 1834, 1821,
+	1781, 1748, 1742, 1730, 1690, 1657, 1651, 1640, 1600, 1566, 1561, 1549, 1510, 1476, 1471, 1459,
+	1420, 1386, 1380, 1369, 1330, 1296, 1291, 1280, 1241, 1207, 1201, 1191, 1152, 1118, 1112, 1101,
+	1063, 1029, 1022, 1012, 974, 940, 933, 923, 885, 851, 844, 835, 797, 762, 755, 746,
+	708, 673, 666, 657, 619, 584, 577, 568, 531, 496, 489, 480, 442, 407, 400, 391,
+	354, 318, 311, 302, 265, 230, 222, 214, 177, 141, 133, 125, 88, 52, 44, 36,
+	0, -36, -44, -52, -88, -125, -133, -141, -177, -214, -222, -230, -265, -302, -311, -318,
+	-354, -391, -400, -407, -442, -480, -489, -496, -531, -568, -577, -584, -619, -657, -666, -673,
+	-708, -746, -755, -762, -797, -835, -844, -851, -885, -923, -933, -940, -974, -1012, -1022, -1029,
+	-1063, -1101, -1112, -1118, -1152, -1191, -1201, -1207, -1241, -1280, -1291, -1296, -1330, -1369, -1380, -1386,
+	-1420, -1459, -1471, -1476, -1510, -1549, -1561, -1566, -1600, -1640, -1651, -1657, -1690, -1730, -1742, -1748,
+	-1781, -1821, -1834, -1839, -1872, -1913, -1925, -1930, -1964, -2005, -2017, -2022, -2055, -2097, -2110, -2114,
+	-2147, -2189, -2202, -2207, -2240, -2281, -2295, -2299, -2332, -2374, -2388, -2392, -2424, -2467, -2481, -2485,
+	-2517, -2559, -2573, -2577, -2609, -2651, -2665, -2668, -2700, -2742, -2756, -2759, -2790, -2833, -2847, -2849,
+	-2880, -2922, -2936, -2938, -2968, -3010, -3023, -3025, -3054, -3096, -3109, -3109, -3138, -3179, -3192, -3192,
+	-3219, -3260, -3273, -3271, -3298, -3338, -3350, -3348, -3374, -3413, -3425, -3421, -3446, -3485, -3495, -3491,
+	-3514, -3553, -3563, -3557, -3579, -3617, -3626, -3619, -3641, -3678, -3686, -3678, -3699, -3735, -3743, -3734,
+	-3754, -3790, -3797, -3788, -3806, -3842, -3849, -3839, -3857, -3893, -3900, -3889, -3907, -3943, -3951, -3940,
+	-3958, -3994, -4003, -3992, -4010, -4048, -4057, -4047, -4066, -4105, -4116, -4107, -4127, -4168, -4181, -4174,
+	-4196, -4239, -4255, -4250, -4274, -4320, -4339, -4337, -4363, -4413, -4436, -4437, -4467, -4521, -4548, -4553,
+	-4587, -4645, -4677, -4686, -4725, -4789, -4826, -4841, -4885, -4954, -4997, -5017, -5067, -5143, -5192, -5218,
+	-5273, -5356, -5412, -5443, -5505, -5594, -5657, -5694, -5762, -5857, -5927, -5970, -6043, -6145, -6220, -6268,
+	-6346, -6454, -6534, -6586, -6668, -6779, -6863, -6918, -7002, -7116, -7202, -7258, -7342, -7457, -7543, -7597,
+	-7679, -7792, -7875, -7926, -8003, -8111, -8190, -8234, -8304, -8405, -8475, -8510, -8570, -8661, -8721, -8744,
+	-8792, -8871, -8919, -8928, -8962, -9027, -9060, -9054, -9072, -9122, -9140, -9117, -9119, -9153, -9156, -9117,
+	-9102, -9121, -9109, -9054, -9023, -9028, -9001, -8931, -8885, -8877, -8837, -8752, -8693, -8672, -8620, -8522,
+	-8450, -8417, -8353, -8242, -8157, -8112, -8035, -7912, -7812, -7754, -7664, -7524, -7409, -7335, -7229, -7072,
+	-6937, -6845, -6719, -6540, -6383, -6269, -6120, -5915, -5733, -5593, -5418, -5186, -4975, -4808, -4606, -4345,
+	-4105, -3912, -3684, -3397, -3132, -2917, -2669, -2361, -2079, -1850, -1591, -1275, -987, -758, -504, -195,
+	82, 293, 524, 806, 1051, 1221, 1407, 1640, 1829, 1936, 2053, 2213, 2324, 2345, 2369, 2435,
+	2447, 2362, 2277, 2232, 2129, 1925, 1719, 1554, 1330, 1003, 673, 389, 48, -397, -841, -1233,
+	-1677, -2222, -2761, -3237, -3759, -4377, -4980, -5509, -6074, -6729, -7360, -7903, -8472, -9125, -9743, -10260,
+	-10792, -11403, -11970, -12423, -12883, -13418, -13902, -14261, -14621, -15057, -15437, -15685, -15932, -16259, -16530, -16664,
+	-16800, -17024, -17197, -17232, -17274, -17418, -17518, -17482, -17463, -17562, -17627, -17561, -17522, -17620, -17697, -17644,
+	-17631, -17774, -17907, -17913, -17967, -18196, -18424, -18521, -18673, -19017, -19363, -19570, -19833, -20302, -20771, -21085,
+	-21452, -22033, -22609, -23005, -23443, -24103, -24746, -25176, -25634, -26319, -26971, -27370, -27779, -28423, -29015, -29308,
+	-29590, -30121, -30584, -30691, -30771, -31124, -31394, -31247, -31057, -31183, -31217, -30761, -30252, -30130, -29914, -29113,
+	-28255, -27901, -27464, -26298, -25076, -24561, -23986, -22431, -20811, -20305, -19799, -17701, -15465, -15578, -16031, -11224,
+	0,
+	// level 0, buzz
+	0, 27719, 32000, 18988, 10876, 13857, 16262, 12152, 8676, 10403, 12010, 9644, 7443, 8659, 9874, 8237,
+	6625, 7561, 8545, 7304, 6030, 6787, 7618, 6625, 5571, 6204, 6925, 6103, 5201, 5743, 6382, 5683,
+	4894, 5367, 5941, 5337, 4634, 5051, 5574, 5043, 4409, 4781, 5263, 4790, 4212, 4546, 4993, 4570,
+	4036, 4340, 4757, 4374, 3879, 4156, 4547, 4199, 3737, 3990, 4360, 4041, 3608, 3840, 4190, 3898,
+	3489, 3704, 4036, 3766, 3379, 3578, 3895, 3645, 3278, 3462, 3765, 3533, 3183, 3354, 3645, 3429,
+	3094, 3254, 3534, 3332, 3011, 3160, 3429, 3241, 2932, 3072, 3332, 3155, 2858, 2989, 3240, 3074,
+	2788, 2910, 3153, 2997, 2721, 2836, 3071, 2925, 2657, 2765, 2994, 2856, 2596, 2697, 2920, 2790,
+	2538, 2633, 2849, 2727, 2482, 2571, 2782, 2666, 2429, 2512, 2718, 2608, 2377, 2456, 2656, 2553,
+	2327, 2401, 2597, 2499, 2279, 2349, 2540, 2448, 2233, 2298, 2485, 2398, 2188, 2249, 2432, 2350,
+	2145, 2202, 2381, 2303, 2103, 2156, 2332, 2258, 2062, 2111, 2284, 2214, 2022, 2068, 2237, 2171,
+	1983, 2026, 2192, 2130, 1945, 1986, 2149, 2090, 1909, 1946, 2106, 2051, 1873, 1907, 2065, 2012,
+	1838, 1869, 2024, 1975, 1803, 1833, 1985, 1939, 1770, 1797, 1946, 1903, 1737, 1761, 1909, 1868,
+	1705, 1727, 1872, 1834, 1674, 1693, 1836, 1801, 1643, 1660, 1801, 1768, 1612, 1628, 1767, 1736,
+	1583, 1596, 1733, 1705, 1554, 1565, 1700, 1674, 1525, 1534, 1667, 1644, 1497, 1504, 1635, 1614,
+	1469, 1475, 1604, 1584, 1441, 1446, 1573, 1556, 1415, 1417, 1543, 1527, 1388, 1389, 1513, 1499,
+	1362, 1361, 1484, 1472, 1336, 1334, 1455, 1445, 1311, 1307, 1427, 1418, 1286, 1280, 1399, 1391,
+	1261, 1254, 1371, 1365, 1236, 1228, 1344, 1340, 1212, 1203, 1317, 1314, 1188, 1178, 1290, 1289,
+	1165, 1153, 1264, 1264, 1141, 1128, 1238, 1240, 1118, 1104, 1212, 1215, 1095, 1079, 1187, 1192,
+	1073, 1056, 1162, 1168, 1050, 1032, 1137, 1144, 1028, 1009, 1113, 1121, 1006, 985, 1088, 1098,
+	984, 963, 1064, 1075, 963, 940, 1040, 1053, 941, 917, 1017, 1030, 920, 895, 993, 1008,
+	899, 873, 970, 986, 878, 851, 947, 964, 857, 829, 924, 942, 837, 808, 902, 921,
+	816, 786, 879, 899, 796, 765, 857, 878, 776, 744, 835, 857, 756, 723, 813, 836,
+	736, 702, 791, 815, 716, 681, 770, 795, 696, 660, 748, 774, 677, 640, 727, 754,
+	657, 620, 705, 733, 638, 599, 684, 713, 619, 579, 663, 693, 600, 559, 642, 673,
+	581, 539, 621, 653, 562, 519, 601, 633, 543, 500, 580, 614, 524, 480, 560, 594,
+	505, 460, 539, 575, 486, 441, 519, 555, 468, 421, 499, 536, 449, 402, 478, 516,
+	431, 383, 458, 497, 412, 364, 438, 478, 394, 345, 418, 459, 376, 325, 399, 440,
+	358, 306, 379, 421, 339, 287, 359, 402, 321, 269, 339, 383, 303, 250, 320, 364,
+	285, 231, 300, 345, 267, 212, 280, 327, 249, 193, 261, 308, 231, 175, 241, 289,
+	213, 156, 222, 271, 195, 137, 203, 252, 178, 119, 183, 233, 160, 100, 164, 215,
+	142, 81, 145, 196, 124, 63, 125, 178, 106, 44, 106, 159, 89, 26, 87, 141,
+	71, 7, 67, 122, 53, -11, 48, 104, 35, -30, 29, 85, 18, -48, 10, 67,
+	0, -67, -10, 48, -18, -85, -29, 30, -35, -104, -48, 11, -53, -122, -67, -7,
+	-71, -141, -87, -26, -89, -159, -106, -44, -106, -178, -125, -63, -124, -196, -145, -81,
+	-142, -215, -164, -100, -160, -233, -183, -119, -178, -252, -203, -137, -195, -271, -222, -156,
+	-213, -289, -241, -175, -231, -308, -261, -193, -249, -327, -280, -212, -267, -345, -300, -231,
+	-285, -364, -320, -250, -303, -383, -339, -269, -321, -402, -359, -287, -339, -421, -379, -306,
+	-358, -440, -399, -325, -376, -459, -418, -345, -394, -478, -438, -364, -412, -497, -458, -383,
+	-431, -516, -478, -402, -449, -536, -499, -421, -468, -555, -519, -441, -486, -575, -539, -460,
+	-505, -594, -560, -480, -524, -614, -580, -500, -543, -633, -601, -519, -562, -653, -621, -539,
+	-581, -673, -642, -559, -600, -693, -663, -579, -619, -713, -684, -599, -638, -733, -705, -620,
+	-657, -754, -727, -640, -677, -774, -748, -660, -696, -795, -770, -681, -716, -815, -791, -702,
+	-736, -836, -813, -723, -756, -857, -835, -744, -776, -878, -857, -765, -796, -899, -879, -786,
+	-816, -921, -902, -808, -837, -942, -924, -829, -857, -964, -947, -851, -878, -986, -970, -873,
+	-899, -1008, -993, -895, -920, -1030, -1017, -917, -941, -1053, -1040, -940, -963, -1075, -1064, -963,
+	-984, -1098, -1088, -985, -1006, -1121, -1113, -1009, -1028, -1144, -1137, -1032, -1050, -1168, -1162, -1056,
+	-1073, -1192, -1187, -1079, -1095, -1215, -1212, -1104, -1118, -1240, -1238, -1128, -1141, -1264, -1264, -1153,
+	-1165, -1289, -1290, -1178, -1188, -1314, -1317, -1203, -1212, -1340, -1344, -1228, -1236, -1365, -1371, -1254,
+	-1261, -1391, -1399, -1280, -1286, -1418, -1427, -1307, -1311, -1445, -1455, -1334, -1336, -1472, -1484, -1361,
+	-1362, -1499, -1513, -1389, -1388, -1527, -1543, -1417, -1415, -1556, -1573, -1446, -1441, -1584, -1604, -1475,
+	-1469, -1614, -1635, -1504, -1497, -1644, -1667, -1534, -1525, -1674, -1700, -1565, -1554, -1705, -1733, -1596,
+	-1583, -1736, -1767, -1628, -1612, -1768, -1801, -1660, -1643, -1801, -1836, -1693, -1674, -1834, -1872, -1727,
+	-1705, -1868, -1909, -1761, -1737, -1903, -1946, -1797, -1770, -1939, -1985, -1833, -1803, -1975, -2024, -1869,
+	-1838, -2012, -2065, -1907, -1873, -2051, -2106, -1946, -1909, -2090, -2149, -1986, -1945, -2130, -2192, -2026,
+	-1983, -2171, -2237, -2068, -2022, -2214, -2284, -2111, -2062, -2258, -2332, -2156, -2103, -2303, -2381, -2202,
+	-2145, -2350, -2432, -2249, -2188, -2398, -2485, -2298, -2233, -2448, -2540, -2349, -2279, -2499, -2597, -2401,
+	-2327, -2553, -2656, -2456, -2377, -2608, -2718, -2512, -2429, -2666, -2782, -2571, -2482, -2727, -2849, -2633,
+	-2538, -2790, -2920, -2697, -2596, -2856, -2994, -2765, -2657, -2925, -3071, -2836, -2721, -2997, -3153, -2910,
+	-2788, -3074, -3240, -2989, -2858, -3155, -3332, -3072, -2932, -3241, -3429, -3160, -3011, -3332, -3534, -3254,
+	-3094, -3429, -3645, -3354, -3183, -3533, -3765, -3462, -3278, -3645, -3895, -3578, -3379, -3766, -4036, -3704,
+	-3489, -3898, -4190, -3840, -3608, -4041, -4360, -3990, -3737, -4199, -4547, -4156, -3879, -4374, -4757, -4340,
+	-4036, -4570, -4993, -4546, -4212, -4790, -5263, -4781, -4409, -5043, -5574, -5051, -4634, -5337, -5941, -5367,
+	-4894, -5683, -6382, -5743, -5201, -6103, -6925, -6204, -5571, -6625, -7618, -6787, -6030, -7304, -8545, -7561,
+	-6625, -8237, -9874, -8659, -7443, -9644, -12010, -10403, -8676, -12152, -16262, -13857, -10876, -18988, -32000, -27719,
+	0,
+	// level 0, bell
+	0, 2013, 4012, 5983, 7910, 9781, 11583, 13305, 14936, 16466, 17888, 19195, 20382, 21444, 22381, 23191,
+	23876, 24438, 24881, 25209, 25430, 25551, 25579, 25525, 25397, 25206, 24961, 24674, 24354, 24011, 23656, 23296,
+	22940, 22595, 22269, 21966, 21692, 21450, 21242, 21071, 20935, 20836, 20770, 20737, 20733, 20754, 20796, 20855,
+	20925, 21002, 21081, 21157, 21225, 21280, 21320, 21339, 21336, 21308, 21253, 21171, 21061, 20924, 20761, 20573,
+	20364, 20134, 19889, 19631, 19364, 19092, 18818, 18548, 18284, 18031, 17790, 17566, 17360, 17174, 17009, 16867,
+	16747, 16648, 16570, 16510, 16467, 16439, 16421, 16411, 16406, 16401, 16392, 16378, 16353, 16315, 16261, 16188,
+	16094, 15979, 15841, 15680, 15497, 15293, 15069, 14827, 14572, 14306, 14034, 13759, 13486, 13220, 12967, 12730,
+	12514, 12324, 12165, 12039, 11949, 11899, 11889, 11920, 11993, 12107, 12260, 12450, 12673, 12924, 13200, 13494,
+	13801, 14113, 14424, 14726, 15013, 15277, 15511, 15708, 15862, 15968, 16021, 16016, 15952, 15824, 15634, 15381,
+	15066, 14691, 14262, 13782, 13258, 12695, 12103, 11489, 10863, 10234, 9612, 9007, 8430, 7890, 7396, 6958,
+	6584, 6281, 6055, 5912, 5856, 5889, 6013, 6227, 6530, 6920, 7391, 7937, 8552, 9228, 9955, 10722,
+	11519, 12334, 13155, 13969, 14765, 15530, 16252, 16920, 17523, 18051, 18495, 18849, 19104, 19257, 19303, 19241,
+	19070, 18790, 18404, 17915, 17329, 16652, 15892, 15056, 14155, 13199, 12198, 11164, 10107, 9041, 7975, 6922,
+	5891, 4893, 3938, 3035, 2190, 1411, 704, 73, -478, -946, -1331, -1631, -1849, -1984, -2039, -2019,
+	-1925, -1764, -1539, -1257, -921, -537, -112, 351, 845, 1367, 1913, 2477, 3057, 3650, 4254, 4866,
+	5486, 6111, 6743, 7380, 8022, 8671, 9326, 9987, 10656, 11333, 12018, 12710, 13410, 14117, 14830, 15546,
+	16264, 16982, 17696, 18403, 19099, 19779, 20439, 21074, 21680, 22250, 22779, 23264, 23698, 24078, 24399, 24658,
+	24852, 24978, 25035, 25023, 24940, 24788, 24569, 24285, 23940, 23538, 23084, 22583, 22042, 21468, 20866, 20246,
+	19613, 18976, 18342, 17717, 17108, 16522, 15964, 15439, 14950, 14500, 14092, 13727, 13405, 13124, 12883, 12678,
+	12507, 12364, 12244, 12142, 12049, 11960, 11867, 11764, 11643, 11497, 11319, 11104, 10846, 10541, 10185, 9776,
+	9311, 8791, 8216, 7588, 6910, 6187, 5424, 4629, 3807, 2968, 2121, 1276, 442, -370, -1149, -1884,
+	-2566, -3185, -3732, -4198, -4575, -4858, -5040, -5118, -5090, -4953, -4708, -4356, -3901, -3347, -2699, -1966,
+	-1154, -273, 667, 1655, 2680, 3730, 4793, 5857, 6910, 7942, 8940, 9895, 10798, 11640, 12413, 13112,
+	13731, 14267, 14718, 15083, 15363, 15559, 15674, 15714, 15682, 15587, 15434, 15232, 14990, 14717, 14421, 14113,
+	13801, 13495, 13203, 12934, 12696, 12495, 12337, 12229, 12173, 12175, 12235, 12356, 12538, 12780, 13081, 13438,
+	13849, 14310, 14816, 15363, 15945, 16558, 17196, 17854, 18525, 19205, 19888, 20570, 21247, 21915, 22571, 23210,
+	23832, 24434, 25015, 25574, 26109, 26622, 27113, 27580, 28026, 28449, 28852, 29234, 29595, 29936, 30256, 30555,
+	30832, 31085, 31312, 31513, 31683, 31820, 31921, 31982, 32000, 31970, 31889, 31753, 31558, 31300, 30977, 30585,
+	30122, 29587, 28979, 28298, 27544, 26719, 25826, 24867, 23848, 22774, 21650, 20484, 19283, 18056, 16812, 15560,
+	14309, 13070, 11852, 10665, 9518, 8421, 7382, 6408, 5508, 4686, 3947, 3296, 2735, 2266, 1888, 1601,
+	1401, 1286, 1250, 1287, 1391, 1553, 1765, 2018, 2302, 2607, 2923, 3240, 3547, 3837, 4099, 4326,
+	4510, 4644, 4725, 4746, 4706, 4602, 4434, 4204, 3912, 3564, 3162, 2712, 2221, 1697, 1146, 577,
+	0, -577, -1146, -1697, -2221, -2712, -3162, -3564, -3912, -4204, -4434, -4602, -4706, -4746, -4725, -4644,
+	-4510, -4326, -4099, -3837, -3547, -3240, -2923, -2607, -2302, -2018, -1765, -1553, -1391, -1287, -1250, -1286,
+	-1401, -1601, -1888, -2266, -2735, -3296, -3947, -4686, -5508, -6408, -7382, -8421, -9518, -10665, -11852, -13070,
+	-14309, -15560, -16812, -18056, -19283, -20484, -21650, -22774, -23848, -24867, -25826, -26719, -27544, -28298, -28979, -29587,
+	-30122, -30585, -30977, -31300, -31558, -31753, -31889, -31970, -32000, -31982, -31921, -31820, -31683, -31513, -31312, -31085,
+	-30832, -30555, -30256, -29936, -29595, -29234, -28852, -28449, -28026, -27580, -27113, -26622, -26109, -25574, -25015, -24434,
+	-23832, -23210, -22571, -21915, -21247, -20570, -19888, -19205, -18525, -17854, -17196, -16558, -15945, -15363, -14816, -14310,
+	-13849, -13438, -13081, -12780, -12538, -12356, -12235, -12175, -12173, -12229, -12337, -12495, -12696, -12934, -13203, -13495,
+	-13801, -14113, -14421, -14717, -14990, -15232, -15434, -15587, -15682, -15714, -15674, -15559, -15363, -15083, -14718, -14267,
+	-13731, -13112, -12413, -11640, -10798, -9895, -8940, -7942, -6910, -5857, -4793, -3730, -2680, -1655, -667, 273,
+	1154, 1966, 2699, 3347, 3901, 4356, 4708, 4953, 5090, 5118, 5040, 4858, 4575, 4198, 3732, 3185,
+	2566, 1884, 1149, 370, -442, -1276, -2121, -2968, -3807, -4629, -5424, -6187, -6910, -7588, -8216, -8791,
+	-9311, -9776, -10185, -10541, -10846, -11104, -11319, -11497, -11643, -11764, -11867, -11960, -12049, -12142, -12244, -12364,
+	-12507, -12678, -12883, -13124, -13405, -13727, -14092, -14500, -14950, -15439, -15964, -16522, -17108, -17717, -18342, -18976,
+	-19613, -20246, -20866, -21468, -22042, -22583, -23084, -23538, -23940, -24285, -24569, -24788, -24940, -25023, -25035, -24978,
+	-24852, -24658, -24399, -24078, -23698, -23264, -22779, -22250, -21680, -21074, -20439, -19779, -19099, -18403, -17696, -16982,
+	-16264, -15546, -14830, -14117, -13410, -12710, -12018, -11333, -10656, -9987, -9326, -8671, -8022, -7380, -6743, -6111,
+	-5486, -4866, -4254, -3650, -3057, -2477, -1913, -1367, -845, -351, 112, 537, 921, 1257, 1539, 1764,
+	1925, 2019, 2039, 1984, 1849, 1631, 1331, 946, 478, -73, -704, -1411, -2190, -3035, -3938, -4893,
+	-5891, -6922, -7975, -9041, -10107, -11164, -12198, -13199, -14155, -15056, -15892, -16652, -17329, -17915, -18404, -18790,
+	-19070, -19241, -19303, -19257, -19104, -18849, -18495, -18051, -17523, -16920, -16252, -15530, -14765, -13969, -13155, -12334,
+	-11519, -10722, -9955, -9228, -8552, -7937, -7391, -6920, -6530, -6227, -6013, -5889, -5856, -5912, -6055, -6281,
+	-6584, -6958, -7396, -7890, -8430, -9007, -9612, -10234, -10863, -11489, -12103, -12695, -13258, -13782, -14262, -14691,
+	-15066, -15381, -15634, -15824, -15952, -16016, -16021, -15968, -15862, -15708, -15511, -15277, -15013, -14726, -14424, -14113,
+	-13801, -13494, -13200, -12924, -12673, -12450, -12260, -12107, -11993, -11920, -11889, -11899, -11949, -12039, -12165, -12324,
+	-12514, -12730, -12967, -13220, -13486, -13759, -14034, -14306, -14572, -14827, -15069, -15293, -15497, -15680, -15841, -15979,
+	-16094, -16188, -16261, -16315, -16353, -16378, -16392, -16401, -16406, -16411, -16421, -16439, -16467, -16510, -16570, -16648,
+	-16747, -16867, -17009, -17174, -17360, -17566, -17790, -18031, -18284, -18548, -18818, -19092, -19364, -19631, -19889, -20134,
+	-20364, -20573, -20761, -20924, -21061, -21171, -21253, -21308, -21336, -21339, -21320, -21280, -21225, -21157, -21081, -21002,
+	-20925, -20855, -20796, -20754, -20733, -20737, -20770, -20836, -20935, -21071, -21242, -21450, -21692, -21966, -22269, -22595,
+	-22940, -23296, -23656, -24011, -24354, -24674, -24961, -25206, -25397, -25525, -25579, -25551, -25430, -25209, -24881, -24438,
+	-23876, -23191, -22381, -21444, -20382, -19195, -17888, -16466, -14936, -13305, -11583, -9781, -7910, -5983, -4012, -2013,
+	0,
+	// level 1, saw
+	0, 23590, 31893, 27633, 24161, 26373, 28396, 26693, 25019, 26123, 27262, 26187, 25043, 25741, 26526, 25735,
+	24845, 25332, 25927, 25298, 24557, 24915, 25390, 24867, 24223, 24494, 24887, 24438, 23864, 24071, 24405, 24010,
+	23488, 23648, 23935, 23583, 23101, 23224, 23475, 23156, 22707, 22799, 23021, 22730, 22307, 22374, 22573, 22304,
+	21903, 21949, 22127, 21878, 21496, 21524, 21685, 21452, 21086, 21099, 21245, 21026, 20674, 20674, 20806, 20600,
+	20261, 20248, 20369, 20175, 19846, 19823, 19934, 19749, 19430, 19398, 19499, 19323, 19013, 18972, 19066, 18898,
+	18596, 18547, 18633, 18472, 18177, 18122, 18200, 18046, 17758, 17696, 17768, 17621, 17339, 17271, 17337, 17195,
+	16919, 16845, 16906, 16770, 16499, 16420, 16476, 16344, 16078, 15994, 16045, 15919, 15657, 15569, 15616, 15493,
+	15236, 15143, 15186, 15067, 14814, 14718, 14757, 14642, 14392, 14293, 14327, 14216, 13971, 13867, 13898, 13791,
+	13548, 13442, 13470, 13365, 13126, 13016, 13041, 12940, 12704, 12591, 12612, 12514, 12281, 12165, 12184, 12089,
+	11859, 11740, 11756, 11663, 11436, 11314, 11327, 11238, 11013, 10889, 10899, 10812, 10590, 10463, 10471, 10387,
+	10167, 10038, 10043, 9961, 9744, 9612, 9616, 9536, 9321, 9187, 9188, 9110, 8897, 8761, 8760, 8685,
+	8474, 8336, 8333, 8259, 8051, 7910, 7905, 7834, 7627, 7485, 7477, 7408, 7204, 7059, 7050, 6983,
+	6780, 6634, 6622, 6557, 6356, 6208, 6195, 6131, 5933, 5783, 5768, 5706, 5509, 5357, 5340, 5280,
+	5086, 4932, 4913, 4855, 4662, 4506, 4486, 4429, 4238, 4081, 4058, 4004, 3814, 3655, 3631, 3578,
+	3391, 3230, 3204, 3153, 2967, 2804, 2777, 2727, 2543, 2379, 2349, 2302, 2119, 1953, 1922, 1876,
+	1695, 1528, 1495, 1451, 1272, 1102, 1068, 1025, 848, 677, 641, 600, 424, 251, 214, 174,
+	0, -174, -214, -251, -424, -600, -641, -677, -848, -1025, -1068, -1102, -1272, -1451, -1495, -1528,
+	-1695, -1876, -1922, -1953, -2119, -2302, -2349, -2379, -2543, -2727, -2777, -2804, -2967, -3153, -3204, -3230,
+	-3391, -3578, -3631, -3655, -3814, -4004, -4058, -4081, -4238, -4429, -4486, -4506, -4662, -4855, -4913, -4932,
+	-5086, -5280, -5340, -5357, -5509, -5706, -5768, -5783, -5933, -6131, -6195, -6208, -6356, -6557, -6622, -6634,
+	-6780, -6983, -7050, -7059, -7204, -7408, -7477, -7485, -7627, -7834, -7905, -7910, -8051, -8259, -8333, -8336,
+	-8474, -8685, -8760, -8761, -8897, -9110, -9188, -9187, -9321, -9536, -9616, -9612, -9744, -9961, -10043, -10038,
+	-10167, -10387, -10471, -10463, -10590, -10812, -10899, -10889, -11013, -11238, -11327, -11314, -11436, -11663, -11756, -11740,
+	-11859, -12089, -12184, -12165, -12281, -12514, -12612, -12591, -12704, -12940, -13041, -13016, -13126, -13365, -13470, -13442,
+	-13548, -13791, -13898, -13867, -13971, -14216, -14327, -14293, -14392, -14642, -14757, -14718, -14814, -15067, -15186, -15143,
+	-15236, -15493, -15616, -15569, -15657, -15919, -16045, -15994, -16078, -16344, -16476, -16420, -16499, -16770, -16906, -16845,
+	-16919, -17195, -17337, -17271, -17339, -17621, -17768, -17696, -17758, -18046, -18200, -18122, -18177, -18472, -18633, -18547,
+	-18596, -18898, -19066, -18972, -19013, -19323, -19499, -19398, -19430, -19749, -19934, -19823, -19846, -20175, -20369, -20248,
+	-20261, -20600, -20806, -20674, -20674, -21026, -21245, -21099, -21086, -21452, -21685, -21524, -21496, -21878, -22127, -21949,
+	-21903, -22304, -22573, -22374, -22307, -22730, -23021, -22799, -22707, -23156, -23475, -23224, -23101, -23583, -23935, -23648,
+	-23488, -24010, -24405, -24071, -23864, -24438, -24887, -24494, -24223, -24867, -25390, -24915, -24557, -25298, -25927, -25332,
+	-24845, -25735, -26526, -25741, -25043, -26187, -27262, -26123, -25019, -26693, -28396, -26373, -24161, -27633, -31893, -23590,
+	0,
+	// level 1, square
+	0, 21932, 29632, 25734, 22689, 24893, 26798, 25259, 23873, 25055, 26146, 25185, 24285, 25095, 25861, 25161,
+	24494, 25111, 25702, 25150, 24619, 25118, 25601, 25145, 24703, 25123, 25531, 25141, 24762, 25125, 25480, 25139,
+	24806, 25127, 25441, 25138, 24841, 25128, 25411, 25137, 24868, 25129, 25386, 25136, 24890, 25130, 25366, 25135,
+	24908, 25130, 25350, 25135, 24923, 25131, 25336, 25135, 24936, 25131, 25324, 25134, 24947, 25131, 25314, 25134,
+	24956, 25131, 25305, 25134, 24964, 25132, 25298, 25134, 24971, 25132, 25291, 25134, 24977, 25132, 25286, 25134,
+	24982, 25132, 25281, 25133, 24987, 25132, 25276, 25133, 24991, 25132, 25273, 25133, 24994, 25132, 25269, 25133,
+	24997, 25132, 25267, 25133, 25000, 25132, 25264, 25133, 25002, 25132, 25262, 25133, 25004, 25133, 25261, 25133,
+	25005, 25133, 25260, 25133, 25006, 25133, 25259, 25133, 25007, 25133, 25258, 25133, 25008, 25133, 25258, 25133,
+	25008, 25133, 25258, 25133, 25008, 25133, 25258, 25133, 25007, 25133, 25259, 25133, 25006, 25133, 25260, 25133,
+	25005, 25133, 25261, 25133, 25004, 25133, 25262, 25132, 25002, 25133, 25264, 25132, 25000, 25133, 25267, 25132,
+	24997, 25133, 25269, 25132, 24994, 25133, 25273, 25132, 24991, 25133, 25276, 25132, 24987, 25133, 25281, 25132,
+	24982, 25134, 25286, 25132, 24977, 25134, 25291, 25132, 24971, 25134, 25298, 25132, 24964, 25134, 25305, 25131,
+	24956, 25134, 25314, 25131, 24947, 25134, 25324, 25131, 24936, 25135, 25336, 25131, 24923, 25135, 25350, 25130,
+	24908, 25135, 25366, 25130, 24890, 25136, 25386, 25129, 24868, 25137, 25411, 25128, 24841, 25138, 25441, 25127,
+	24806, 25139, 25480, 25125, 24762, 25141, 25531, 25123, 24703, 25145, 25601, 25118, 24619, 25150, 25702, 25111,
+	24494, 25161, 25861, 25095, 24285, 25185, 26146, 25055, 23873, 25259, 26798, 24893, 22689, 25734, 29632, 21932,
+	0, -21932, -29632, -25734, -22689, -24893, -26798, -25259, -23873, -25055, -26146, -25185, -24285, -25095, -25861, -25161,
+	-24494, -25111, -25702, -25150, -24619, -25118, -25601, -25145, -24703, -25123, -25531, -25141, -24762, -25125, -25480, -25139,
+	-24806, -25127, -25441, -25138, -24841, -25128, -25411, -25137, -24868, -25129, -25386, -25136, -24890, -25130, -25366, -25135,
+	-24908, -25130, -25350, -25135, -24923, -25131, -25336, -25135, -24936, -25131, -25324, -25134, -24947, -25131, -25314, -25134,
+	-24956, -25131, -25305, -25134, -24964, -25132, -25298, -25134, -24971, -25132, -25291, -25134, -24977, -25132, -25286, -25134,
+	-24982, -25132, -25281, -25133, -24987, -25132, -25276, -25133, -24991, -25132, -25273, -25133, -24994, -25132, -25269, -25133,
+	-24997, -25132, -25267, -25133, -25000, -25132, -25264, -25133, -25002, -25132, -25262, -25133, -25004, -25133, -25261, -25133,
+	-25005, -25133, -25260, -25133, -25006, -25133, -25259, -25133, -25007, -25133, -25258, -25133, -25008, -25133, -25258, -25133,
+	-25008, -25133, -25258, -25133, -25008, -25133, -25258, -25133, -25007, -25133, -25259, -25133, -25006, -25133, -25260, -25133,
+	-25005, -25133, -25261, -25133, -25004, -25133, -25262, -25132, -25002, -25133, -25264, -25132, -25000, -25133, -25267, -25132,
+	-24997, -25133, -25269, -25132, -24994, -25133, -25273, -25132, -24991, -25133, -25276, -25132, -24987, -25133, -25281, -25132,
+	-24982, -25134, -25286, -25132, -24977, -25134, -25291, -25132, -24971, -25134, -25298, -25132, -24964, -25134, -25305, -25131,
+	-24956, -25134, -25314, -25131, -24947, -25134, -25324, -25131, -24936, -25135, -25336, -25131, -24923, -25135, -25350, -25130,
+	-24908, -25135, -25366, -25130, -24890, -25136, -25386, -25129, -24868, -25137, -25411, -25128, -24841, -25138, -25441, -25127,
+	-24806, -25139, -25480, -25125, -24762, -25141, -25531, -25123, -24703, -25145, -25601, -25118, -24619, -25150, -25702, -25111,
+	-24494, -25161, -25861, -25095, -24285, -25185, -26146, -25055, -23873, -25259, -26798, -24893, -22689, -25734, -29632, -21932,
+	0,
+	// level 1, organ
+	0, 2659, 5291, 7871, 10374, 12778, 15061, 17205, 19196, 21023, 22677, 24153, 25450, 26571, 27520, 28306,
+	28940, 29433, 29800, 30055, 30214, 30292, 30304, 30264, 30185, 30079, 29953, 29818, 29677, 29535, 29394, 29254,
+	29115, 28974, 28828, 28674, 28508, 28327, 28129, 27909, 27668, 27405, 27121, 26817, 26498, 26167, 25829, 25491,
+	25159, 24839, 24537, 24261, 24013, 23800, 23624, 23487, 23389, 23329, 23303, 23307, 23336, 23382, 23437, 23493,
+	23541, 23571, 23575, 23544, 23472, 23353, 23182, 22957, 22677, 22343, 21958, 21527, 21056, 20552, 20026, 19486,
+	18942, 18404, 17883, 17387, 16924, 16501, 16122, 15791, 15509, 15274, 15085, 14936, 14820, 14730, 14656, 14588,
+	14515, 14428, 14316, 14169, 13980, 13741, 13449, 13099, 12692, 12230, 11716, 11156, 10558, 9933, 9291, 8645,
+	8007, 7391, 6809, 6273, 5793, 5379, 5039, 4776, 4595, 4495, 4473, 4527, 4647, 4826, 5053, 5315,
+	5600, 5895, 6185, 6458, 6702, 6905, 7060, 7158, 7195, 7168, 7077, 6926, 6718, 6460, 6162, 5834,
+	5487, 5133, 4785, 4455, 4156, 3896, 3687, 3535, 3445, 3422, 3466, 3576, 3748, 3977, 4256, 4575,
+	4926, 5296, 5674, 6050, 6411, 6750, 7055, 7321, 7540, 7711, 7830, 7899, 7919, 7894, 7831, 7737,
+	7619, 7487, 7349, 7216, 7096, 6997, 6926, 6889, 6890, 6930, 7010, 7130, 7285, 7470, 7680, 7906,
+	8140, 8372, 8593, 8794, 8964, 9096, 9182, 9216, 9193, 9109, 8963, 8755, 8487, 8160, 7779, 7349,
+	6877, 6367, 5827, 5262, 4679, 4083, 3478, 2867, 2252, 1635, 1015, 392, -238, -877, -1527, -2193,
+	-2877, -3581, -4309, -5059, -5832, -6625, -7433, -8251, -9069, -9879, -10667, -11421, -12127, -12768, -13328, -13791,
+	-14143, -14367, -14452, -14385, -14158, -13764, -13202, -12471, -11575, -10521, -9319, -7985, -6535, -4989, -3368, -1697,
+	0, 1697, 3368, 4989, 6535, 7985, 9319, 10521, 11575, 12471, 13202, 13764, 14158, 14385, 14452, 14367,
+	14143, 13791, 13328, 12768, 12127, 11421, 10667, 9879, 9069, 8251, 7433, 6625, 5832, 5059, 4309, 3581,
+	2877, 2193, 1527, 877, 238, -392, -1015, -1635, -2252, -2867, -3478, -4083, -4679, -5262, -5827, -6367,
+	-6877, -7349, -7779, -8160, -8487, -8755, -8963, -9109, -9193, -9216, -9182, -9096, -8964, -8794, -8593, -8372,
+	-8140, -7906, -7680, -7470, -7285, -7130, -7010, -6930, -6890, -6889, -6926, -6997, -7096, -7216, -7349, -7487,
+	-7619, -7737, -7831, -7894, -7919, -7899, -7830, -7711, -7540, -7321, -7055, -6750, -6411, -6050, -5674, -5296,
+	-4926, -4575, -4256, -3977, -3748, -3576, -3466, -3422, -3445, -3535, -3687, -3896, -4156, -4455, -4785, -5133,
+	-5487, -5834, -6162, -6460, -6718, -6926, -7077, -7168, -7195, -7158, -7060, -6905, -6702, -6458, -6185, -5895,
+	-5600, -5315, -5053, -4826, -4647, -4527, -4473, -4495, -4595, -4776, -5039, -5379, -5793, -6273, -6809, -7391,
+	-8007, -8645, -9291, -9933, -10558, -11156, -11716, -12230, -12692, -13099, -13449, -13741, -13980, -14169, -14316, -14428,
+	-14515, -14588, -14656, -14730, -14820, -14936, -15085, -15274, -15509, -15791, -16122, -16501, -16924, -17387, -17883, -18404,
+	-18942, -19486, -20026, -20552, -21056, -21527, -21958, -22343, -22677, -22957, -23182, -23353, -23472, -23544, -23575, -23571,
+	-23541, -23493, -23437, -23382, -23336, -23307, -23303, -23329, -23389, -23487, -23624, -23800, -24013, -24261, -24537, -24839,
+	-25159, -25491, -25829, -26167, -26498, -26817, -27121, -27405, -27668, -27909, -28129, -28327, -28508, -28674, -28828, -28974,
+	-29115, -29254, -29394, -29535, -29677, -29818, -29953, -30079, -30185, -30264, -30304, -30292, -30214, -30055, -29800, -29433,
+	-28940, -28306, -27520, -26571, -25450, -24153, -22677, -21023, -19196, -17205, -15061, -12778, -10374, -7871, -5291, -2659,
+	0,
+	// level 1, vocal
+	0, 12519, 18605, 19347, 20275, 23392, 26210, 27222, 27973, 29596, 30938, 31061, 30867, 31172, 31263, 30472,
+	29448, 28842, 28161, 26887, 25520, 24602, 23755, 22543, 21357, 20647, 20097, 19311, 18591, 18313, 18194, 17865,
+	17560, 17597, 17722, 17593, 17400, 17426, 17453, 17169, 16744, 16445, 16093, 15415, 14570, 13822, 13029, 11952,
+	10745, 9668, 8606, 7345, 6031, 4908, 3882, 2750, 1637, 773, 66, -681, -1367, -1784, -2023, -2283,
+	-2481, -2432, -2225, -2056, -1861, -1467, -958, -525, -112, 446, 1074, 1592, 2051, 2612, 3214, 3686,
+	4079, 4551, 5052, 5422, 5708, 6067, 6456, 6724, 6914, 7177, 7478, 7670, 7790, 7985, 8222, 8360,
+	8429, 8570, 8755, 8845, 8865, 8953, 9082, 9118, 9083, 9109, 9174, 9150, 9053, 9014, 9015, 8930,
+	8775, 8676, 8621, 8487, 8287, 8145, 8051, 7888, 7664, 7499, 7388, 7216, 6987, 6820, 6711, 6548,
+	6332, 6178, 6084, 5941, 5748, 5615, 5544, 5427, 5260, 5151, 5104, 5013, 4872, 4786, 4761, 4694,
+	4575, 4508, 4501, 4453, 4352, 4300, 4306, 4273, 4185, 4143, 4158, 4135, 4056, 4019, 4039, 4022,
+	3948, 3913, 3935, 3919, 3848, 3812, 3832, 3817, 3745, 3706, 3723, 3707, 3633, 3590, 3603, 3583,
+	3507, 3460, 3468, 3446, 3367, 3315, 3319, 3294, 3213, 3157, 3157, 3131, 3048, 2989, 2986, 2958,
+	2874, 2813, 2807, 2779, 2695, 2631, 2624, 2596, 2512, 2447, 2439, 2411, 2327, 2262, 2253, 2226,
+	2143, 2077, 2068, 2042, 1960, 1893, 1883, 1859, 1777, 1711, 1700, 1677, 1597, 1529, 1519, 1496,
+	1417, 1349, 1338, 1317, 1239, 1170, 1159, 1138, 1061, 992, 980, 960, 884, 814, 801, 782,
+	707, 637, 623, 605, 530, 459, 445, 427, 353, 282, 267, 250, 177, 105, 89, 73,
+	0, -73, -89, -105, -177, -250, -267, -282, -353, -427, -445, -459, -530, -605, -623, -637,
+	-707, -782, -801, -814, -884, -960, -980, -992, -1061, -1138, -1159, -1170, -1239, -1317, -1338, -1349,
+	-1417, -1496, -1519, -1529, -1597, -1677, -1700, -1711, -1777, -1859, -1883, -1893, -1960, -2042, -2068, -2077,
+	-2143, -2226, -2253, -2262, -2327, -2411, -2439, -2447, -2512, -2596, -2624, -2631, -2695, -2779, -2807, -2813,
+	-2874, -2958, -2986, -2989, -3048, -3131, -3157, -3157, -3213, -3294, -3319, -3315, -3367, -3446, -3468, -3460,
+	-3507, -3583, -3603, -3590, -3633, -3707, -3723, -3706, -3745, -3817, -3832, -3812, -3848, -3919, -3935, -3913,
+	-3948, -4022, -4039, -4019, -4056, -4135, -4158, -4143, -4185, -4273, -4306, -4300, -4352, -4453, -4501, -4508,
+	-4575, -4694, -4761, -4786, -4872, -5013, -5104, -5151, -5260, -5427, -5544, -5615, -5748, -5941, -6084, -6178,
+	-6332, -6548, -6711, -6820, -6987, -7216, -7388, -7499, -7664, -7888, -8051, -8145, -8287, -8487, -8621, -8676,
+	-8775, -8930, -9015, -9014, -9053, -9150, -9174, -9109, -9083, -9118, -9082, -8953, -8865, -8845, -8755, -8570,
+	-8429, -8360, -8222, -7985, -7790, -7670, -7478, -7177, -6914, -6724, -6456, -6067, -5708, -5422, -5052, -4551,
+	-4079, -3686, -3214, -2612, -2051, -1592, -1074, -446, 112, 525, 958, 1467, 1861, 2056, 2225, 2432,
+	2481, 2283, 2023, 1784, 1367, 681, -66, -773, -1637, -2750, -3882, -4908, -6031, -7345, -8606, -9668,
+	-10745, -11952, -13029, -13822, -14570, -15415, -16093, -16445, -16744, -17169, -17453, -17426, -17400, -17593, -17722, -17597,
+	-17560, -17865, -18194, -18313, -18591, -19311, -20097, -20647, -21357, -22543, -23755, -24602, -25520, -26887, -28161, -28842,
+	-29448, -30472, -31263, -31172, -30867, -31061, -30938, -29596, -27973, -27222, -26210, -23392, -20275, -19347, -18605, -12519,
+	0,
+	// level 1, buzz
+	0, 19553, 22621, 13461, 7678, 9738, 11479, 8614, 6110, 7283, 8458, 6827, 5225, 6036, 6935, 5819,
+	4635, 5247, 5981, 5146, 4201, 4687, 5312, 4653, 3864, 4261, 4808, 4271, 3590, 3922, 4410, 3961,
+	3360, 3643, 4085, 3703, 3164, 3407, 3812, 3482, 2992, 3203, 3578, 3290, 2840, 3023, 3374, 3121,
+	2703, 2864, 3193, 2969, 2580, 2721, 3031, 2832, 2467, 2591, 2884, 2708, 2362, 2471, 2751, 2593,
+	2265, 2361, 2628, 2487, 2175, 2259, 2514, 2388, 2090, 2164, 2409, 2295, 2011, 2074, 2310, 2208,
+	1935, 1990, 2217, 2126, 1863, 1910, 2129, 2048, 1795, 1834, 2046, 1974, 1729, 1762, 1967, 1903,
+	1667, 1693, 1891, 1835, 1606, 1626, 1819, 1770, 1548, 1562, 1750, 1707, 1492, 1501, 1683, 1647,
+	1438, 1442, 1619, 1589, 1385, 1384, 1557, 1532, 1334, 1329, 1497, 1477, 1284, 1274, 1439, 1424,
+	1235, 1222, 1382, 1372, 1188, 1171, 1327, 1321, 1141, 1121, 1274, 1272, 1096, 1072, 1221, 1223,
+	1052, 1024, 1170, 1176, 1008, 977, 1120, 1130, 965, 931, 1071, 1084, 923, 886, 1023, 1039,
+	882, 842, 975, 995, 841, 798, 929, 952, 801, 755, 883, 909, 761, 713, 838, 867,
+	722, 671, 794, 826, 683, 630, 750, 785, 645, 589, 706, 744, 607, 548, 664, 704,
+	570, 508, 621, 664, 533, 469, 579, 625, 496, 430, 538, 586, 459, 391, 497, 547,
+	423, 352, 456, 509, 387, 314, 415, 470, 351, 276, 375, 432, 316, 238, 335, 395,
+	280, 200, 295, 357, 245, 163, 255, 320, 210, 125, 216, 282, 174, 88, 176, 245,
+	139, 51, 137, 208, 105, 14, 98, 171, 70, -23, 59, 134, 35, -60, 20, 97,
+	0, -97, -20, 60, -35, -134, -59, 23, -70, -171, -98, -14, -105, -208, -137, -51,
+	-139, -245, -176, -88, -174, -282, -216, -125, -210, -320, -255, -163, -245, -357, -295, -200,
+	-280, -395, -335, -238, -316, -432, -375, -276, -351, -470, -415, -314, -387, -509, -456, -352,
+	-423, -547, -497, -391, -459, -586, -538, -430, -496, -625, -579, -469, -533, -664, -621, -508,
+	-570, -704, -664, -548, -607, -744, -706, -589, -645, -785, -750, -630, -683, -826, -794, -671,
+	-722, -867, -838, -713, -761, -909, -883, -755, -801, -952, -929, -798, -841, -995, -975, -842,
+	-882, -1039, -1023, -886, -923, -1084, -1071, -931, -965, -1130, -1120, -977, -1008, -1176, -1170, -1024,
+	-1052, -1223, -1221, -1072, -1096, -1272, -1274, -1121, -1141, -1321, -1327, -1171, -1188, -1372, -1382, -1222,
+	-1235, -1424, -1439, -1274, -1284, -1477, -1497, -1329, -1334, -1532, -1557, -1384, -1385, -1589, -1619, -1442,
+	-1438, -1647, -1683, -1501, -1492, -1707, -1750, -1562, -1548, -1770, -1819, -1626, -1606, -1835, -1891, -1693,
+	-1667, -1903, -1967, -1762, -1729, -1974, -2046, -1834, -1795, -2048, -2129, -1910, -1863, -2126, -2217, -1990,
+	-1935, -2208, -2310, -2074, -2011, -2295, -2409, -2164, -2090, -2388, -2514, -2259, -2175, -2487, -2628, -2361,
+	-2265, -2593, -2751, -2471, -2362, -2708, -2884, -2591, -2467, -2832, -3031, -2721, -2580, -2969, -3193, -2864,
+	-2703, -3121, -3374, -3023, -2840, -3290, -3578, -3203, -2992, -3482, -3812, -3407, -3164, -3703, -4085, -3643,
+	-3360, -3961, -4410, -3922, -3590, -4271, -4808, -4261, -3864, -4653, -5312, -4687, -4201, -5146, -5981, -5247,
+	-4635, -5819, -6935, -6036, -5225, -6827, -8458, -7283, -6110, -8614, -11479, -9738, -7678, -13461, -22621, -19553,
+	0,
+	// level 1, bell
+	0, 4012, 7910, 11583, 14936, 17888, 20382, 22381, 23876, 24881, 25430, 25579, 25397, 24961, 24354, 23656,
+	22940, 22269, 21692, 21242, 20935, 20770, 20733, 20796, 20925, 21081, 21225, 21320, 21336, 21253, 21061, 20761,
+	20364, 19889, 19364, 18818, 18284, 17790, 17360, 17009, 16747, 16570, 16467, 16421, 16406, 16392, 16353, 16261,
+	16094, 15841, 15497, 15069, 14572, 14034, 13486, 12967, 12514, 12165, 11949, 11889, 11993, 12260, 12673, 13200,
+	13801, 14424, 15013, 15511, 15862, 16021, 15952, 15634, 15066, 14262, 13258, 12103, 10863, 9612, 8430, 7396,
+	6584, 6055, 5856, 6013, 6530, 7391, 8552, 9955, 11519, 13155, 14765, 16252, 17523, 18495, 19104, 19303,
+	19070, 18404, 17329, 15892, 14155, 12198, 10107, 7975, 5891, 3938, 2190, 704, -478, -1331, -1849, -2039,
+	-1925, -1539, -921, -112, 845, 1913, 3057, 4254, 5486, 6743, 8022, 9326, 10656, 12018, 13410, 14830,
+	16264, 17696, 19099, 20439, 21680, 22779, 23698, 24399, 24852, 25035, 24940, 24569, 23940, 23084, 22042, 20866,
+	19613, 18342, 17108, 15964, 14950, 14092, 13405, 12883, 12507, 12244, 12049, 11867, 11643, 11319, 10846, 10185,
+	9311, 8216, 6910, 5424, 3807, 2121, 442, -1149, -2566, -3732, -4575, -5040, -5090, -4708, -3901, -2699,
+	-1154, 667, 2680, 4793, 6910, 8940, 10798, 12413, 13731, 14718, 15363, 15674, 15682, 15434, 14990, 14421,
+	13801, 13203, 12696, 12337, 12173, 12235, 12538, 13081, 13849, 14816, 15945, 17196, 18525, 19888, 21247, 22571,
+	23832, 25015, 26109, 27113, 28026, 28852, 29595, 30256, 30832, 31312, 31683, 31921, 32000, 31889, 31558, 30977,
+	30122, 28979, 27544, 25826, 23848, 21650, 19283, 16812, 14309, 11852, 9518, 7382, 5508, 3947, 2735, 1888,
+	1401, 1250, 1391, 1765, 2302, 2923, 3547, 4099, 4510, 4725, 4706, 4434, 3912, 3162, 2221, 1146,
+	0, -1146, -2221, -3162, -3912, -4434, -4706, -4725, -4510, -4099, -3547, -2923, -2302, -1765, -1391, -1250,
+	-1401, -1888, -2735, -3947, -5508, -7382, -9518, -11852, -14309, -16812, -19283, -21650, -23848, -25826, -27544, -28979,
+	-30122, -30977, -31558, -31889, -32000, -31921, -31683, -31312, -30832, -30256, -29595, -28852, -28026, -27113, -26109, -25015,
+	-23832, -22571, -21247, -19888, -18525, -17196, -15945, -14816, -13849, -13081, -12538, -12235, -12173, -12337, -12696, -13203,
+	-13801, -14421, -14990, -15434, -15682, -15674, -15363, -14718, -13731, -12413, -10798, -8940, -6910, -4793, -2680, -667,
+	1154, 2699, 3901, 4708, 5090, 5040, 4575, 3732, 2566, 1149, -442, -2121, -3807, -5424, -6910, -8216,
+	-9311, -10185, -10846, -11319, -11643, -11867, -12049, -12244, -12507, -12883, -13405, -14092, -14950, -15964, -17108, -18342,
+	-19613, -20866, -22042, -23084, -23940, -24569, -24940, -25035, -24852, -24399, -23698, -22779, -21680, -20439, -19099, -17696,
+	-16264, -14830, -13410, -12018, -10656, -9326, -8022, -6743, -5486, -4254, -3057, -1913, -845, 112, 921, 1539,
+	1925, 2039, 1849, 1331, 478, -704, -2190, -3938, -5891, -7975, -10107, -12198, -14155, -15892, -17329, -18404,
+	-19070, -19303, -19104, -18495, -17523, -16252, -14765, -13155, -11519, -9955, -8552, -7391, -6530, -6013, -5856, -6055,
+	-6584, -7396, -8430, -9612, -10863, -12103, -13258, -14262, -15066, -15634, -15952, -16021, -15862, -15511, -15013, -14424,
+	-13801, -13200, -12673, -12260, -11993, -11889, -11949, -12165, -12514, -12967, -13486, -14034, -14572, -15069, -15497, -15841,
+	-16094, -16261, -16353, -16392, -16406, -16421, -16467, -16570, -16747, -17009, -17360, -17790, -18284, -18818, -19364, -19889,
+	-20364, -20761, -21061, -21253, -21336, -21320, -21225, -21081, -20925, -20796, -20733, -20770, -20935, -21242, -21692, -22269,
+	-22940, -23656, -24354, -24961, -25397, -25579, -25430, -24881, -23876, -22381, -20382, -17888, -14936, -11583, -7910, -4012,
+	0,
+	// level 2, saw
+	0, 23416, 31680, 27381, 23737, 25773, 27755, 26016, 24172, 25097, 26194, 25085, 23771, 24290, 25031, 24208,
+	23150, 23456, 24004, 23345, 22438, 22613, 23040, 22488, 21680, 21767, 22110, 21633, 20897, 20918, 21201, 20780,
+	20098, 20069, 20304, 19928, 19287, 19220, 19417, 19075, 18469, 18370, 18536, 18224, 17645, 17519, 17660, 17372,
+	16818, 16669, 16787, 16521, 15987, 15818, 15917, 15669, 15153, 14967, 15050, 14818, 14318, 14117, 14184, 13967,
+	13481, 13266, 13320, 13115, 12642, 12415, 12456, 12264, 11803, 11564, 11594, 11413, 10963, 10713, 10733, 10562,
+	10122, 9862, 9872, 9711, 9280, 9012, 9012, 8860, 8438, 8161, 8153, 8009, 7595, 7310, 7294, 7158,
+	6752, 6459, 6435, 6306, 5909, 5608, 5576, 5455, 5065, 4757, 4718, 4604, 4221, 3906, 3860, 3753,
+	3377, 3055, 3002, 2902, 2533, 2204, 2144, 2051, 1689, 1353, 1287, 1200, 844, 502, 429, 349,
+	0, -349, -429, -502, -844, -1200, -1287, -1353, -1689, -2051, -2144, -2204, -2533, -2902, -3002, -3055,
+	-3377, -3753, -3860, -3906, -4221, -4604, -4718, -4757, -5065, -5455, -5576, -5608, -5909, -6306, -6435, -6459,
+	-6752, -7158, -7294, -7310, -7595, -8009, -8153, -8161, -8438, -8860, -9012, -9012, -9280, -9711, -9872, -9862,
+	-10122, -10562, -10733, -10713, -10963, -11413, -11594, -11564, -11803, -12264, -12456, -12415, -12642, -13115, -13320, -13266,
+	-13481, -13967, -14184, -14117, -14318, -14818, -15050, -14967, -15153, -15669, -15917, -15818, -15987, -16521, -16787, -16669,
+	-16818, -17372, -17660, -17519, -17645, -18224, -18536, -18370, -18469, -19075, -19417, -19220, -19287, -19928, -20304, -20069,
+	-20098, -20780, -21201, -20918, -20897, -21633, -22110, -21767, -21680, -22488, -23040, -22613, -22438, -23345, -24004, -23456,
+	-23150, -24208, -25031, -24290, -23771, -25085, -26194, -25097, -24172, -26016, -27755, -25773, -23737, -27381, -31680, -23416,
+	0,
+	// level 2, square
+	0, 21933, 29633, 25733, 22686, 24894, 26802, 25259, 23866, 25056, 26154, 25185, 24276, 25096, 25872, 25161,
+	24481, 25111, 25716, 25150, 24603, 25119, 25618, 25144, 24683, 25123, 25552, 25141, 24739, 25126, 25505, 25139,
+	24779, 25128, 25470, 25137, 24810, 25129, 25444, 25136, 24832, 25130, 25424, 25135, 24849, 25131, 25409, 25135,
+	24862, 25131, 25398, 25134, 24872, 25132, 25390, 25134, 24878, 25132, 25385, 25133, 24882, 25132, 25383, 25133,
+	24883, 25133, 25383, 25132, 24882, 25133, 25385, 25132, 24878, 25134, 25390, 25132, 24872, 25134, 25398, 25131,
+	24862, 25135, 25409, 25131, 24849, 25135, 25424, 25130, 24832, 25136, 25444, 25129, 24810, 25137, 25470, 25128,
+	24779, 25139, 25505, 25126, 24739, 25141, 25552, 25123, 24683, 25144, 25618, 25119, 24603, 25150, 25716, 25111,
+	24481, 25161, 25872, 25096, 24276, 25185, 26154, 25056, 23866, 25259, 26802, 24894, 22686, 25733, 29633, 21933,
+	0, -21933, -29633, -25733, -22686, -24894, -26802, -25259, -23866, -25056, -26154, -25185, -24276, -25096, -25872, -25161,
+	-24481, -25111, -25716, -25150, -24603, -25119, -25618, -25144, -24683, -25123, -25552, -25141, -24739, -25126, -25505, -25139,
+	-24779, -25128, -25470, -25137, -24810, -25129, -25444, -25136, -24832, -25130, -25424, -25135, -24849, -25131, -25409, -25135,
+	-24862, -25131, -25398, -25134, -24872, -25132, -25390, -25134, -24878, -25132, -25385, -25133, -24882, -25132, -25383, -25133,
+	-24883, -25133, -25383, -25132, -24882, -25133, -25385, -25132, -24878, -25134, -25390, -25132, -24872, -25134, -25398, -25131,
+	-24862, -25135, -25409, -25131, -24849, -25135, -25424, -25130, -24832, -25136, -25444, -25129, -24810, -25137, -25470, -25128,
+	-24779, -25139, -25505, -25126, -24739, -25141, -25552, -25123, -24683, -25144, -25618, -25119, -24603, -25150, -25716, -25111,
+	-24481, -25161, -25872, -25096, -24276, -25185, -26154, -25056, -23866, -25259, -26802, -24894, -22686, -25733, -29633, -21933,
+	0,
+	// level 2, organ
+	0, 5291, 10374, 15061, 19196, 22677, 25450, 27520, 28940, 29800, 30214, 30304, 30185, 29953, 29677, 29394,
+	29115, 28828, 28508, 28129, 27668, 27121, 26498, 25829, 25159, 24537, 24013, 23624, 23389, 23303, 23336, 23437,
+	23541, 23575, 23472, 23182, 22677, 21958, 21056, 20026, 18942, 17883, 16924, 16122, 15509, 15085, 14820, 14656,
+	14515, 14316, 13980, 13449, 12692, 11716, 10558, 9291, 8007, 6809, 5793, 5039, 4595, 4473, 4647, 5053,
+	5600, 6185, 6702, 7060, 7195, 7077, 6718, 6162, 5487, 4785, 4156, 3687, 3445, 3466, 3748, 4256,
+	4926, 5674, 6411, 7055, 7540, 7830, 7919, 7831, 7619, 7349, 7096, 6926, 6890, 7010, 7285, 7680,
+	8140, 8593, 8964, 9182, 9193, 8963, 8487, 7779, 6877, 5827, 4679, 3478, 2252, 1015, -238, -1527,
+	-2877, -4309, -5832, -7433, -9069, -10667, -12127, -13328, -14143, -14452, -14158, -13202, -11575, -9319, -6535, -3368,
+	0, 3368, 6535, 9319, 11575, 13202, 14158, 14452, 14143, 13328, 12127, 10667, 9069, 7433, 5832, 4309,
+	2877, 1527, 238, -1015, -2252, -3478, -4679, -5827, -6877, -7779, -8487, -8963, -9193, -9182, -8964, -8593,
+	-8140, -7680, -7285, -7010, -6890, -6926, -7096, -7349, -7619, -7831, -7919, -7830, -7540, -7055, -6411, -5674,
+	-4926, -4256, -3748, -3466, -3445, -3687, -4156, -4785, -5487, -6162, -6718, -7077, -7195, -7060, -6702, -6185,
+	-5600, -5053, -4647, -4473, -4595, -5039, -5793, -6809, -8007, -9291, -10558, -11716, -12692, -13449, -13980, -14316,
+	-14515, -14656, -14820, -15085, -15509, -16122, -16924, -17883, -18942, -20026, -21056, -21958, -22677, -23182, -23472, -23575,
+	-23541, -23437, -23336, -23303, -23389, -23624, -24013, -24537, -25159, -25829, -26498, -27121, -27668, -28129, -28508, -28828,
+	-29115, -29394, -29677, -29953, -30185, -30304, -30214, -29800, -28940, -27520, -25450, -22677, -19196, -15061, -10374, -5291,
+	0,
+	// level 2, vocal
+	0, 15065, 23415, 25786, 27437, 30316, 32000, 31049, 29166, 27815, 26204, 23628, 21168, 19847, 19079, 18112,
+	17419, 17522, 17777, 17399, 16632, 15923, 14876, 12994, 10652, 8455, 6287, 3860, 1558, -70, -1147, -2034,
+	-2549, -2350, -1670, -961, -172, 957, 2219, 3218, 4026, 4942, 5857, 6466, 6867, 7374, 7924, 8237,
+	8387, 8656, 8986, 9100, 9045, 9080, 9162, 9037, 8741, 8529, 8386, 8077, 7632, 7300, 7076, 6740,
+	6304, 5999, 5829, 5575, 5235, 5022, 4946, 4794, 4552, 4421, 4419, 4342, 4165, 4080, 4116, 4077,
+	3929, 3859, 3902, 3872, 3728, 3650, 3681, 3644, 3492, 3396, 3409, 3362, 3199, 3087, 3085, 3031,
+	2862, 2739, 2727, 2671, 2502, 2372, 2355, 2301, 2135, 2002, 1983, 1933, 1770, 1637, 1616, 1570,
+	1411, 1276, 1253, 1211, 1057, 919, 894, 855, 704, 564, 536, 500, 352, 209, 179, 146,
+	0, -146, -179, -209, -352, -500, -536, -564, -704, -855, -894, -919, -1057, -1211, -1253, -1276,
+	-1411, -1570, -1616, -1637, -1770, -1933, -1983, -2002, -2135, -2301, -2355, -2372, -2502, -2671, -2727, -2739,
+	-2862, -3031, -3085, -3087, -3199, -3362, -3409, -3396, -3492, -3644, -3681, -3650, -3728, -3872, -3902, -3859,
+	-3929, -4077, -4116, -4080, -4165, -4342, -4419, -4421, -4552, -4794, -4946, -5022, -5235, -5575, -5829, -5999,
+	-6304, -6740, -7076, -7300, -7632, -8077, -8386, -8529, -8741, -9037, -9162, -9080, -9045, -9100, -8986, -8656,
+	-8387, -8237, -7924, -7374, -6867, -6466, -5857, -4942, -4026, -3218, -2219, -957, 172, 961, 1670, 2350,
+	2549, 2034, 1147, 70, -1558, -3860, -6287, -8455, -10652, -12994, -14876, -15923, -16632, -17399, -17777, -17522,
+	-17419, -18112, -19079, -19847, -21168, -23628, -26204, -27815, -29166, -31049, -32000, -30316, -27437, -25786, -23415, -15065,
+	0,
+	// level 2, buzz
+	0, 13758, 15981, 9561, 5404, 6791, 8075, 6107, 4271, 5029, 5912, 4818, 3621, 4121, 4807, 4079,
+	3179, 3537, 4104, 3576, 2847, 3115, 3603, 3202, 2584, 2787, 3219, 2905, 2365, 2521, 2910, 2659,
+	2178, 2297, 2652, 2450, 2014, 2103, 2431, 2267, 1867, 1932, 2236, 2105, 1734, 1778, 2063, 1958,
+	1612, 1638, 1906, 1823, 1499, 1510, 1763, 1699, 1393, 1390, 1630, 1583, 1294, 1278, 1506, 1474,
+	1199, 1172, 1389, 1371, 1109, 1071, 1278, 1272, 1022, 975, 1173, 1178, 938, 883, 1072, 1087,
+	858, 794, 975, 999, 779, 708, 881, 914, 703, 624, 790, 831, 628, 542, 701, 751,
+	555, 462, 614, 671, 483, 383, 529, 593, 412, 306, 446, 517, 342, 230, 363, 441,
+	273, 154, 281, 366, 204, 80, 201, 291, 136, 5, 120, 217, 68, -69, 40, 143,
+	0, -143, -40, 69, -68, -217, -120, -5, -136, -291, -201, -80, -204, -366, -281, -154,
+	-273, -441, -363, -230, -342, -517, -446, -306, -412, -593, -529, -383, -483, -671, -614, -462,
+	-555, -751, -701, -542, -628, -831, -790, -624, -703, -914, -881, -708, -779, -999, -975, -794,
+	-858, -1087, -1072, -883, -938, -1178, -1173, -975, -1022, -1272, -1278, -1071, -1109, -1371, -1389, -1172,
+	-1199, -1474, -1506, -1278, -1294, -1583, -1630, -1390, -1393, -1699, -1763, -1510, -1499, -1823, -1906, -1638,
+	-1612, -1958, -2063, -1778, -1734, -2105, -2236, -1932, -1867, -2267, -2431, -2103, -2014, -2450, -2652, -2297,
+	-2178, -2659, -2910, -2521, -2365, -2905, -3219, -2787, -2584, -3202, -3603, -3115, -2847, -3576, -4104, -3537,
+	-3179, -4079, -4807, -4121, -3621, -4818, -5912, -5029, -4271, -6107, -8075, -6791, -5404, -9561, -15981, -13758,
+	0,
+	// level 2, bell
+	0, 7910, 14936, 20382, 23876, 25430, 25397, 24354, 22940, 21692, 20935, 20733, 20925, 21225, 21336, 21061,
+	20364, 19364, 18284, 17360, 16747, 16467, 16406, 16353, 16094, 15497, 14572, 13486, 12514, 11949, 11993, 12673,
+	13801, 15013, 15862, 15952, 15066, 13258, 10863, 8430, 6584, 5856, 6530, 8552, 11519, 14765, 17523, 19104,
+	19070, 17329, 14155, 10107, 5891, 2190, -478, -1849, -1925, -921, 845, 3057, 5486, 8022, 10656, 13410,
+	16264, 19099, 21680, 23698, 24852, 24940, 23940, 22042, 19613, 17108, 14950, 13405, 12507, 12049, 11643, 10846,
+	9311, 6910, 3807, 442, -2566, -4575, -5090, -3901, -1154, 2680, 6910, 10798, 13731, 15363, 15682, 14990,
+	13801, 12696, 12173, 12538, 13849, 15945, 18525, 21247, 23832, 26109, 28026, 29595, 30832, 31683, 32000, 31558,
+	30122, 27544, 23848, 19283, 14309, 9518, 5508, 2735, 1401, 1391, 2302, 3547, 4510, 4706, 3912, 2221,
+	0, -2221, -3912, -4706, -4510, -3547, -2302, -1391, -1401, -2735, -5508, -9518, -14309, -19283, -23848, -27544,
+	-30122, -31558, -32000, -31683, -30832, -29595, -28026, -26109, -23832, -21247, -18525, -15945, -13849, -12538, -12173, -12696,
+	-13801, -14990, -15682, -15363, -13731, -10798, -6910, -2680, 1154, 3901, 5090, 4575, 2566, -442, -3807, -6910,
+	-9311, -10846, -11643, -12049, -12507, -13405, -14950, -17108, -19613, -22042, -23940, -24940, -24852, -23698, -21680, -19099,
+	-16264, -13410, -10656, -8022, -5486, -3057, -845, 921, 1925, 1849, 478, -2190, -5891, -10107, -14155, -17329,
+	-19070, -19104, -17523, -14765, -11519, -8552, -6530, -5856, -6584, -8430, -10863, -13258, -15066, -15952, -15862, -15013,
+	-13801, -12673, -11993, -11949, -12514, -13486, -14572, -15497, -16094, -16353, -16406, -16467, -16747, -17360, -18284, -19364,
+	-20364, -21061, -21336, -21225, -20925, -20733, -20935, -21692, -22940, -24354, -25397, -25430, -23876, -20382, -14936, -7910,
+	0,
+	// level 3, saw
+	0, 23067, 31251, 26880, 22893, 24573, 26468, 24663, 22483, 23046, 24050, 22881, 21238, 21387, 22029, 21153,
+	19772, 19702, 20145, 19439, 18217, 18009, 18322, 17731, 16615, 16311, 16534, 16026, 14989, 14612, 14766, 14321,
+	13346, 12912, 13010, 12618, 11692, 11211, 11264, 10915, 10031, 9510, 9523, 9212, 8365, 7808, 7787, 7510,
+	6696, 6107, 6054, 5807, 5024, 4405, 4323, 4105, 3350, 2703, 2593, 2403, 1675, 1001, 864, 701,
+	0, -701, -864, -1001, -1675, -2403, -2593, -2703, -3350, -4105, -4323, -4405, -5024, -5807, -6054, -6107,
+	-6696, -7510, -7787, -7808, -8365, -9212, -9523, -9510, -10031, -10915, -11264, -11211, -11692, -12618, -13010, -12912,
+	-13346, -14321, -14766, -14612, -14989, -16026, -16534, -16311, -16615, -17731, -18322, -18009, -18217, -19439, -20145, -19702,
+	-19772, -21153, -22029, -21387, -21238, -22881, -24050, -23046, -22483, -24663, -26468, -24573, -22893, -26880, -31251, -23067,
+	0,
+	// level 3, square
+	0, 21935, 29639, 25731, 22674, 24896, 26821, 25257, 23841, 25058, 26185, 25182, 24237, 25098, 25918, 25158,
+	24428, 25114, 25778, 25147, 24532, 25122, 25699, 25141, 24592, 25127, 25655, 25137, 24623, 25130, 25635, 25134,
+	24633, 25134, 25635, 25130, 24623, 25137, 25655, 25127, 24592, 25141, 25699, 25122, 24532, 25147, 25778, 25114,
+	24428, 25158, 25918, 25098, 24237, 25182, 26185, 25058, 23841, 25257, 26821, 24896, 22674, 25731, 29639, 21935,
+	0, -21935, -29639, -25731, -22674, -24896, -26821, -25257, -23841, -25058, -26185, -25182, -24237, -25098, -25918, -25158,
+	-24428, -25114, -25778, -25147, -24532, -25122, -25699, -25141, -24592, -25127, -25655, -25137, -24623, -25130, -25635, -25134,
+	-24633, -25134, -25635, -25130, -24623, -25137, -25655, -25127, -24592, -25141, -25699, -25122, -24532, -25147, -25778, -25114,
+	-24428, -25158, -25918, -25098, -24237, -25182, -26185, -25058, -23841, -25257, -26821, -24896, -22674, -25731, -29639, -21935,
+	0,
+	// level 3, organ
+	0, 10374, 19196, 25450, 28940, 30214, 30185, 29677, 29115, 28508, 27668, 26498, 25159, 24013, 23389, 23336,
+	23541, 23472, 22677, 21056, 18942, 16924, 15509, 14820, 14515, 13980, 12692, 10558, 8007, 5793, 4595, 4647,
+	5600, 6702, 7195, 6718, 5487, 4156, 3445, 3748, 4926, 6411, 7540, 7919, 7619, 7096, 6890, 7285,
+	8140, 8964, 9193, 8487, 6877, 4679, 2252, -238, -2877, -5832, -9069, -12127, -14143, -14158, -11575, -6535,
+	0, 6535, 11575, 14158, 14143, 12127, 9069, 5832, 2877, 238, -2252, -4679, -6877, -8487, -9193, -8964,
+	-8140, -7285, -6890, -7096, -7619, -7919, -7540, -6411, -4926, -3748, -3445, -4156, -5487, -6718, -7195, -6702,
+	-5600, -4647, -4595, -5793, -8007, -10558, -12692, -13980, -14515, -14820, -15509, -16924, -18942, -21056, -22677, -23472,
+	-23541, -23336, -23389, -24013, -25159, -26498, -27668, -28508, -29115, -29677, -30185, -30214, -28940, -25450, -19196, -10374,
+	0,
+	// level 3, vocal
+	0, 19818, 30575, 31634, 28633, 25527, 22294, 18925, 17140, 17377, 17305, 14810, 10468, 5986, 2031, -1167,
+	-2685, -1921, 186, 2229, 3920, 5637, 7149, 7954, 8302, 8787, 9273, 9207, 8672, 8203, 7819, 7134,
+	6247, 5659, 5388, 5013, 4506, 4259, 4290, 4192, 3892, 3750, 3830, 3764, 3461, 3265, 3280, 3175,
+	2839, 2590, 2562, 2452, 2117, 1852, 1813, 1718, 1400, 1128, 1082, 1002, 698, 417, 360, 292,
+	0, -292, -360, -417, -698, -1002, -1082, -1128, -1400, -1718, -1813, -1852, -2117, -2452, -2562, -2590,
+	-2839, -3175, -3280, -3265, -3461, -3764, -3830, -3750, -3892, -4192, -4290, -4259, -4506, -5013, -5388, -5659,
+	-6247, -7134, -7819, -8203, -8672, -9207, -9273, -8787, -8302, -7954, -7149, -5637, -3920, -2229, -186, 1921,
+	2685, 1167, -2031, -5986, -10468, -14810, -17305, -17377, -17140, -18925, -22294, -25527, -28633, -31634, -30575, -19818,
+	0,
+	// level 3, buzz
+	0, 9627, 11272, 6809, 3773, 4649, 5625, 4315, 2924, 3350, 4038, 3350, 2416, 2656, 3200, 2775,
+	2055, 2189, 2645, 2366, 1772, 1837, 2233, 2048, 1536, 1551, 1902, 1783, 1331, 1308, 1623, 1554,
+	1148, 1093, 1379, 1349, 980, 899, 1160, 1162, 823, 720, 958, 988, 675, 551, 769, 823,
+	534, 390, 590, 665, 397, 235, 417, 512, 263, 83, 248, 362, 131, -65, 83, 213,
+	0, -213, -83, 65, -131, -362, -248, -83, -263, -512, -417, -235, -397, -665, -590, -390,
+	-534, -823, -769, -551, -675, -988, -958, -720, -823, -1162, -1160, -899, -980, -1349, -1379, -1093,
+	-1148, -1554, -1623, -1308, -1331, -1783, -1902, -1551, -1536, -2048, -2233, -1837, -1772, -2366, -2645, -2189,
+	-2055, -2775, -3200, -2656, -2416, -3350, -4038, -3350, -2924, -4315, -5625, -4649, -3773, -6809, -11272, -9627,
+	0,
+	// level 3, bell
+	0, 14936, 23876, 25397, 22940, 20935, 20925, 21336, 20364, 18284, 16747, 16406, 16094, 14572, 12514, 11993,
+	13801, 15862, 15066, 10863, 6584, 6530, 11519, 17523, 19070, 14155, 5891, -478, -1925, 845, 5486, 10656,
+	16264, 21680, 24852, 23940, 19613, 14950, 12507, 11643, 9311, 3807, -2566, -5090, -1154, 6910, 13731, 15682,
+	13801, 12173, 13849, 18525, 23832, 28026, 30832, 32000, 30122, 23848, 14309, 5508, 1401, 2302, 4510, 3912,
+	0, -3912, -4510, -2302, -1401, -5508, -14309, -23848, -30122, -32000, -30832, -28026, -23832, -18525, -13849, -12173,
+	-13801, -15682, -13731, -6910, 1154, 5090, 2566, -3807, -9311, -11643, -12507, -14950, -19613, -23940, -24852, -21680,
+	-16264, -10656, -5486, -845, 1925, 478, -5891, -14155, -19070, -17523, -11519, -6530, -6584, -10863, -15066, -15862,
+	-13801, -11993, -12514, -14572, -16094, -16406, -16747, -18284, -20364, -21336, -20925, -20935, -22940, -25397, -23876, -14936,
+	0,
+	// level 4, saw
+	0, 22366, 30387, 25878, 21218, 22170, 23875, 21960, 19133, 18941, 19727, 18476, 16214, 15580, 15975, 15046,
+	13077, 12193, 12357, 11631, 9851, 8796, 8799, 8222, 6584, 5396, 5270, 4815, 3297, 1994, 1755, 1410,
+	0, -1410, -1755, -1994, -3297, -4815, -5270, -5396, -6584, -8222, -8799, -8796, -9851, -11631, -12357, -12193,
+	-13077, -15046, -15975, -15580, -16214, -18476, -19727, -18941, -19133, -21960, -23875, -22170, -21218, -25878, -30387, -22366,
+	0,
+	// level 4, square
+	0, 21943, 29664, 25723, 22624, 24905, 26898, 25247, 23734, 25069, 26327, 25170, 24056, 25113, 26148, 25139,
+	24137, 25139, 26148, 25113, 24056, 25170, 26327, 25069, 23734, 25247, 26898, 24905, 22624, 25723, 29664, 21943,
+	0, -21943, -29664, -25723, -22624, -24905, -26898, -25247, -23734, -25069, -26327, -25170, -24056, -25113, -26148, -25139,
+	-24137, -25139, -26148, -25113, -24056, -25170, -26327, -25069, -23734, -25247, -26898, -24905, -22624, -25723, -29664, -21943,
+	0,
+	// level 4, organ
+	0, 17796, 28940, 31585, 29115, 26268, 25159, 24789, 23541, 21276, 18942, 16909, 14515, 11292, 8007, 5995,
+	5600, 5795, 5487, 4845, 4926, 6140, 7619, 8290, 8140, 7793, 6877, 3653, -2877, -10469, -14143, -10175,
+	0, 10175, 14143, 10469, 2877, -3653, -6877, -7793, -8140, -8290, -7619, -6140, -4926, -4845, -5487, -5795,
+	-5600, -5995, -8007, -11292, -14515, -16909, -18942, -21276, -23541, -24789, -25159, -26268, -29115, -31585, -28940, -17796,
+	0,
+	// level 4, vocal
+	0, 25236, 31990, 23591, 16198, 15127, 12103, 3219, -3534, -1363, 5126, 8117, 7604, 8081, 9553, 8652,
+	5732, 4386, 5123, 5066, 3536, 2930, 3869, 4039, 2616, 1722, 2350, 2576, 1293, 279, 774, 1138,
+	0, -1138, -774, -279, -1293, -2576, -2350, -1722, -2616, -4039, -3869, -2930, -3536, -5066, -5123, -4386,
+	-5732, -8652, -9553, -8081, -7604, -8117, -5126, 1363, 3534, -3219, -12103, -15127, -16198, -23591, -31990, -25236,
+	0,
+	// level 4, buzz
+	0, 6656, 7912, 4861, 2576, 3031, 3802, 2992, 1882, 2007, 2561, 2203, 1428, 1408, 1845, 1686,
+	1075, 966, 1327, 1284, 775, 601, 901, 939, 504, 275, 525, 625, 248, -29, 172, 325,
+	0, -325, -172, 29, -248, -625, -525, -275, -504, -939, -901, -601, -775, -1284, -1327, -966,
+	-1075, -1686, -1845, -1408, -1428, -2203, -2561, -2007, -1882, -2992, -3802, -3031, -2576, -4861, -7912, -6656,
+	0,
+	// level 4, bell
+	0, 17944, 26126, 23666, 17874, 15495, 16325, 15896, 12651, 10058, 11320, 14144, 13059, 6862, 1587, 4336,
+	14638, 23703, 23125, 13478, 3301, 59, 3582, 8723, 12651, 17231, 24063, 29580, 27633, 17050, 4587, -1423,
+	0, 1423, -4587, -17050, -27633, -29580, -24063, -17231, -12651, -8723, -3582, -59, -3301, -13478, -23125, -23703,
+	-14638, -4336, -1587, -6862, -13059, -14144, -11320, -10058, -12651, -15896, -16325, -15495, -17874, -23666, -26126, -17944,
+	0,
+	// level 5, saw
+	0, 11538, 20956, 26789, 28631, 27180, 23884, 20381, 17921, 17005, 17356, 18180, 18605, 18077, 16564, 14504,
+	12548, 11229, 10720, 10786, 10928, 10646, 9680, 8124, 6363, 4866, 3949, 3629, 3618, 3481, 2853, 1627,
+	0, -1627, -2853, -3481, -3618, -3629, -3949, -4866, -6363, -8124, -9680, -10646, -10928, -10786, -10720, -11229,
+	-12548, -14504, -16564, -18077, -18605, -18180, -17356, -17005, -17921, -20381, -23884, -27180, -28631, -26789, -20956, -11538,
+	0,
+	// level 5, square
+	0, 12150, 21974, 27935, 29763, 28433, 25688, 23301, 22412, 23192, 24951, 26603, 27256, 26637, 25180, 23749,
+	23162, 23749, 25180, 26637, 27256, 26603, 24951, 23192, 22412, 23301, 25688, 28433, 29763, 27935, 21974, 12150,
+	0, -12150, -21974, -27935, -29763, -28433, -25688, -23301, -22412, -23192, -24951, -26603, -27256, -26637, -25180, -23749,
+	-23162, -23749, -25180, -26637, -27256, -26603, -24951, -23192, -22412, -23301, -25688, -28433, -29763, -27935, -21974, -12150,
+	0,
+	// level 5, organ
+	0, 11787, 21809, 28741, 32000, 31834, 29173, 25299, 21441, 18433, 16535, 15463, 14600, 13317, 11258, 8512,
+	5600, 3277, 2237, 2821, 4841, 7586, 10025, 11133, 10240, 7283, 2863, -1913, -5762, -7625, -7012, -4165,
+	0, 4165, 7012, 7625, 5762, 1913, -2863, -7283, -10240, -11133, -10025, -7586, -4841, -2821, -2237, -3277,
+	-5600, -8512, -11258, -13317, -14600, -15463, -16535, -18433, -21441, -25299, -29173, -31834, -32000, -28741, -21809, -11787,
+	0,
+	// level 5, vocal
+	0, 13051, 22697, 26675, 24588, 17934, 9473, 2178, -1799, -1784, 1379, 5852, 9633, 11347, 10680, 8332,
+	5554, 3533, 2880, 3456, 4549, 5302, 5146, 4056, 2503, 1171, 588, 854, 1612, 2254, 2245, 1405,
+	0, -1405, -2245, -2254, -1612, -854, -588, -1171, -2503, -4056, -5146, -5302, -4549, -3456, -2880, -3533,
+	-5554, -8332, -10680, -11347, -9633, -5852, -1379, 1784, 1799, -2178, -9473, -17934, -24588, -26675, -22697, -13051,
+	0,
+	// level 5, buzz
+	0, 2521, 4477, 5488, 5473, 4655, 3458, 2344, 1646, 1472, 1702, 2074, 2317, 2266, 1921, 1423,
+	974, 736, 755, 954, 1173, 1259, 1133, 827, 462, 183, 88, 179, 367, 515, 509, 317,
+	0, -317, -509, -515, -367, -179, -88, -183, -462, -827, -1133, -1259, -1173, -954, -755, -736,
+	-974, -1423, -1921, -2266, -2317, -2074, -1702, -1472, -1646, -2344, -3458, -4655, -5473, -5488, -4477, -2521,
+	0,
+	// level 5, bell
+	0, 8261, 15356, 20358, 22753, 22538, 20194, 16564, 12651, 9391, 7451, 7101, 8180, 10170, 12356, 14020,
+	14638, 14020, 12356, 10170, 8180, 7101, 7451, 9391, 12651, 16564, 20194, 22538, 22753, 20358, 15356, 8261,
+	0, -8261, -15356, -20358, -22753, -22538, -20194, -16564, -12651, -9391, -7451, -7101, -8180, -10170, -12356, -14020,
+	-14638, -14020, -12356, -10170, -8180, -7101, -7451, -9391, -12651, -16564, -20194, -22538, -22753, -20358, -15356, -8261,
+	0,
+	// level 6, saw
+	0, 5068, 9910, 14316, 18103, 21131, 23308, 24597, 25014, 24627, 23551, 21931, 19935, 17740, 15516, 13414,
+	11558, 10032, 8881, 8108, 7676, 7516, 7534, 7624, 7677, 7593, 7291, 6716, 5844, 4684, 3276, 1686,
+	0, -1686, -3276, -4684, -5844, -6716, -7291, -7593, -7677, -7624, -7534, -7516, -7676, -8108, -8881, -10032,
+	-11558, -13414, -15516, -17740, -19935, -21931, -23551, -24627, -25014, -24597, -23308, -21131, -18103, -14316, -9910, -5068,
+	0,
+	// level 6, square
+	0, 6233, 12169, 17535, 22101, 25700, 28240, 29708, 30170, 29765, 28688, 27176, 25482, 23855, 22516, 21639,
+	21333, 21639, 22516, 23855, 25482, 27176, 28688, 29765, 30170, 29708, 28240, 25700, 22101, 17535, 12169, 6233,
+	0, -6233, -12169, -17535, -22101, -25700, -28240, -29708, -30170, -29765, -28688, -27176, -25482, -23855, -22516, -21639,
+	-21333, -21639, -22516, -23855, -25482, -27176, -28688, -29765, -30170, -29708, -28240, -25700, -22101, -17535, -12169, -6233,
+	0,
+	// level 6, organ
+	0, 5996, 11685, 16781, 21039, 24273, 26366, 27277, 27041, 25769, 23629, 20838, 17641, 14292, 11034, 8080,
+	5600, 3710, 2461, 1846, 1800, 2211, 2932, 3797, 4640, 5305, 5670, 5647, 5199, 4335, 3112, 1626,
+	0, -1626, -3112, -4335, -5199, -5647, -5670, -5305, -4640, -3797, -2932, -2211, -1800, -1846, -2461, -3710,
+	-5600, -8080, -11034, -14292, -17641, -20838, -23629, -25769, -27041, -27277, -26366, -24273, -21039, -16781, -11685, -5996,
+	0,
+	// level 6, vocal
+	0, 2469, 4816, 6928, 8708, 10083, 11007, 11464, 11469, 11067, 10324, 9328, 8174, 6963, 5789, 4735,
+	3865, 3219, 2816, 2647, 2680, 2867, 3146, 3446, 3699, 3843, 3828, 3623, 3214, 2611, 1842, 953,
+	0, -953, -1842, -2611, -3214, -3623, -3828, -3843, -3699, -3446, -3146, -2867, -2680, -2647, -2816, -3219,
+	-3865, -4735, -5789, -6963, -8174, -9328, -10324, -11067, -11469, -11464, -11007, -10083, -8708, -6928, -4816, -2469,
+	0,
+	// level 6, buzz
+	0, 799, 1558, 2238, 2805, 3237, 3517, 3639, 3610, 3445, 3165, 2800, 2383, 1948, 1528, 1150,
+	837, 604, 456, 392, 402, 470, 576, 697, 809, 892, 928, 907, 824, 681, 486, 253,
+	0, -253, -486, -681, -824, -907, -928, -892, -809, -697, -576, -470, -402, -392, -456, -604,
+	-837, -1150, -1528, -1948, -2383, -2800, -3165, -3445, -3610, -3639, -3517, -3237, -2805, -2238, -1558, -799,
+	0,
+	// level 6, bell
+	0, 4427, 8595, 12265, 15240, 17379, 18607, 18924, 18401, 17173, 15427, 13387, 11292, 9373, 7838, 6848,
+	6506, 6848, 7838, 9373, 11292, 13387, 15427, 17173, 18401, 18924, 18607, 17379, 15240, 12265, 8595, 4427,
+	0, -4427, -8595, -12265, -15240, -17379, -18607, -18924, -18401, -17173, -15427, -13387, -11292, -9373, -7838, -6848,
+	-6506, -6848, -7838, -9373, -11292, -13387, -15427, -17173, -18401, -18924, -18607, -17379, -15240, -12265, -8595, -4427,
+	0,
+	// level 7, saw
+	0, 1699, 3382, 5033, 6634, 8172, 9632, 10998, 12259, 13401, 14415, 15290, 16017, 16590, 17004, 17253,
+	17337, 17253, 17004, 16590, 16017, 15290, 14415, 13401, 12259, 10998, 9632, 8172, 6634, 5033, 3382, 1699,
+	0, -1699, -3382, -5033, -6634, -8172, -9632, -10998, -12259, -13401, -14415, -15290, -16017, -16590, -17004, -17253,
+	-17337, -17253, -17004, -16590, -16017, -15290, -14415, -13401, -12259, -10998, -9632, -8172, -6634, -5033, -3382, -1699,
+	0,
+	// level 7, square
+	0, 3137, 6243, 9289, 12246, 15085, 17778, 20301, 22627, 24736, 26607, 28221, 29564, 30622, 31385, 31846,
+	32000, 31846, 31385, 30622, 29564, 28221, 26607, 24736, 22627, 20301, 17778, 15085, 12246, 9289, 6243, 3137,
+	0, -3137, -6243, -9289, -12246, -15085, -17778, -20301, -22627, -24736, -26607, -28221, -29564, -30622, -31385, -31846,
+	-32000, -31846, -31385, -30622, -29564, -28221, -26607, -24736, -22627, -20301, -17778, -15085, -12246, -9289, -6243, -3137,
+	0,
+	// level 7, organ
+	0, 1372, 2731, 4064, 5358, 6600, 7779, 8882, 9900, 10823, 11641, 12348, 12935, 13398, 13732, 13934,
+	14001, 13934, 13732, 13398, 12935, 12348, 11641, 10823, 9900, 8882, 7779, 6600, 5358, 4064, 2731, 1372,
+	0, -1372, -2731, -4064, -5358, -6600, -7779, -8882, -9900, -10823, -11641, -12348, -12935, -13398, -13732, -13934,
+	-14001, -13934, -13732, -13398, -12935, -12348, -11641, -10823, -9900, -8882, -7779, -6600, -5358, -4064, -2731, -1372,
+	0,
+	// level 7, vocal
+	0, 715, 1423, 2118, 2792, 3439, 4053, 4628, 5158, 5639, 6066, 6434, 6740, 6981, 7155, 7260,
+	7295, 7260, 7155, 6981, 6740, 6434, 6066, 5639, 5158, 4628, 4053, 3439, 2792, 2118, 1423, 715,
+	0, -715, -1423, -2118, -2792, -3439, -4053, -4628, -5158, -5639, -6066, -6434, -6740, -6981, -7155, -7260,
+	-7295, -7260, -7155, -6981, -6740, -6434, -6066, -5639, -5158, -4628, -4053, -3439, -2792, -2118, -1423, -715,
+	0,
+	// level 7, buzz
+	0, 194, 386, 575, 758, 934, 1101, 1257, 1401, 1531, 1647, 1747, 1830, 1896, 1943, 1972,
+	1981, 1972, 1943, 1896, 1830, 1747, 1647, 1531, 1401, 1257, 1101, 934, 758, 575, 386, 194,
+	0, -194, -386, -575, -758, -934, -1101, -1257, -1401, -1531, -1647, -1747, -1830, -1896, -1943, -1972,
+	-1981, -1972, -1943, -1896, -1830, -1747, -1647, -1531, -1401, -1257, -1101, -934, -758, -575, -386, -194,
+	0,
+	// level 7, bell
+	0, 1594, 3173, 4721, 6224, 7667, 9036, 10318, 11501, 12573, 13523, 14344, 15026, 15564, 15952, 16186,
+	16264, 16186, 15952, 15564, 15026, 14344, 13523, 12573, 11501, 10318, 9036, 7667, 6224, 4721, 3173, 1594,
+	0, -1594, -3173, -4721, -6224, -7667, -9036, -10318, -11501, -12573, -13523, -14344, -15026, -15564, -15952, -16186,
+	-16264, -16186, -15952, -15564, -15026, -14344, -13523, -12573, -11501, -10318, -9036, -7667, -6224, -4721, -3173, -1594,
+	0,
+};
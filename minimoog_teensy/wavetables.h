@@ -0,0 +1,21 @@
+// Minimoog - Teensy
+// Generated by tools/make_wavetables.py, do not edit.
+
+#ifndef WAVETABLES_H
+#define WAVETABLES_H
+
+#include <Arduino.h>
+
+const uint8_t WT_NUM_TABLES = 6;
+const uint8_t WT_NUM_LEVELS = 8;
+// Number of harmonics of level 0. Level n holds WT_MAX_HARMONICS >> n harmonics.
+const uint16_t WT_MAX_HARMONICS = 255;
+
+// Table names : saw, square, organ, vocal, buzz, bell
+
+// Size of a table on each level is 1 << WT_LEVEL_BITS[level], plus one guard sample.
+extern const uint8_t WT_LEVEL_BITS[WT_NUM_LEVELS];
+extern const uint32_t WT_LEVEL_OFFSET[WT_NUM_LEVELS];
+extern const int16_t WT_DATA[13104];
+
+#endif
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+# Minimoog - wavetable generator
+#
+# This program is part of a minimoog-like synthesizer based on teensy 4.0
+# Copyright (C) 2020  Pierre-Loup Martin
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# Computes the band-limited wavetables used by the oscillators, and writes them as C source.
+# Usage : python3 tools/make_wavetables.py
+# It writes minimoog_teensy/wavetables.h and minimoog_teensy/wavetables.cpp
+#
+# Each table is stored as mip levels, one per octave.
+# Level 0 holds 255 harmonics, and each level above holds half the harmonics of the previous one,
+# so a level can be played up to one octave above the previous one without aliasing.
+# As there are less harmonics, upper levels also need less samples : the size halves down to a minimum.
+# Levels are stored one after the other, and for a given level all the tables are next to each other,
+# so morphing between two tables reads two close memory areas.
+# Each table has a guard sample at its end (copy of the first one), for interpolation without wrapping.
+
+import math
+import os
+
+NUM_LEVELS = 8
+MAX_HARMONICS = 255
+BASE_SIZE_BITS = 10
+MIN_SIZE_BITS = 6
+PEAK = 32000
+
+
+def formant(n):
+	return (1.0 + 4.0 * math.exp(-((n - 6) / 2.0) ** 2) + 3.0 * math.exp(-((n - 14) / 3.0) ** 2)) / n
+
+
+BELL = {1: 1.0, 3: 0.6, 5: 0.5, 8: 0.45, 12: 0.3, 17: 0.25, 23: 0.15}
+ORGAN = {1: 1.0, 2: 0.8, 3: 0.6, 4: 0.5, 6: 0.4, 8: 0.3, 10: 0.15, 12: 0.1, 16: 0.1}
+
+# Harmonic amplitudes for each table, given as a function of the harmonic rank.
+TABLES = [
+	('saw', lambda n: 1.0 / n),
+	('square', lambda n: 1.0 / n if n % 2 else 0.0),
+	('organ', lambda n: ORGAN.get(n, 0.0)),
+	('vocal', formant),
+	('buzz', lambda n: 1.0 / math.sqrt(n)),
+	('bell', lambda n: BELL.get(n, 0.0)),
+]
+
+
+def level_bits(level):
+	return max(BASE_SIZE_BITS - level, MIN_SIZE_BITS)
+
+
+def render(amplitude, harmonics, size):
+	amps = [(n, amplitude(n)) for n in range(1, harmonics + 1)]
+	amps = [(n, a) for n, a in amps if a != 0.0]
+	out = []
+	for i in range(size):
+		x = 2.0 * math.pi * i / size
+		out.append(sum(a * math.sin(n * x) for n, a in amps))
+	return out
+
+
+def main():
+	root = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'minimoog_teensy')
+
+	levels = []
+	offsets = []
+	offset = 0
+	for level in range(NUM_LEVELS):
+		size = 1 << level_bits(level)
+		harmonics = MAX_HARMONICS >> level
+		offsets.append(offset)
+		tables = []
+		for name, amplitude in TABLES:
+			tables.append(render(amplitude, harmonics, size))
+		levels.append(tables)
+		offset += len(TABLES) * (size + 1)
+
+	# Each table is normalised once for all its levels, so the volume doesn't jump from one octave to the next.
+	for t in range(len(TABLES)):
+		peak = max(max(abs(v) for v in levels[l][t]) for l in range(NUM_LEVELS))
+		for l in range(NUM_LEVELS):
+			levels[l][t] = [int(round(v * PEAK / peak)) for v in levels[l][t]]
+
+	with open(os.path.join(root, 'wavetables.h'), 'w') as f:
+		f.write('// Minimoog - Teensy\n')
+		f.write('// Generated by tools/make_wavetables.py, do not edit.\n\n')
+		f.write('#ifndef WAVETABLES_H\n#define WAVETABLES_H\n\n#include <Arduino.h>\n\n')
+		f.write('const uint8_t WT_NUM_TABLES = %d;\n' % len(TABLES))
+		f.write('const uint8_t WT_NUM_LEVELS = %d;\n' % NUM_LEVELS)
+		f.write('// Number of harmonics of level 0. Level n holds WT_MAX_HARMONICS >> n harmonics.\n')
+		f.write('const uint16_t WT_MAX_HARMONICS = %d;\n\n' % MAX_HARMONICS)
+		f.write('// Table names : %s\n\n' % ', '.join(name for name, _ in TABLES))
+		f.write('// Size of a table on each level is 1 << WT_LEVEL_BITS[level], plus one guard sample.\n')
+		f.write('extern const uint8_t WT_LEVEL_BITS[WT_NUM_LEVELS];\n')
+		f.write('extern const uint32_t WT_LEVEL_OFFSET[WT_NUM_LEVELS];\n')
+		f.write('extern const int16_t WT_DATA[%d];\n\n' % offset)
+		f.write('#endif\n')
+
+	with open(os.path.join(root, 'wavetables.cpp'), 'w') as f:
+		f.write('// Minimoog - Teensy\n')
+		f.write('// Generated by tools/make_wavetables.py, do not edit.\n\n')
+		f.write('#include "wavetables.h"\n\n')
+		f.write('const uint8_t WT_LEVEL_BITS[WT_NUM_LEVELS] = {%s};\n' %
+				', '.join(str(level_bits(l)) for l in range(NUM_LEVELS)))
+		f.write('const uint32_t WT_LEVEL_OFFSET[WT_NUM_LEVELS] = {%s};\n\n' % ', '.join(str(o) for o in offsets))
+		f.write('const int16_t WT_DATA[%d] PROGMEM = {\n' % offset)
+		for l in range(NUM_LEVELS):
+			for t, (name, _) in enumerate(TABLES):
+				data = levels[l][t] + [levels[l][t][0]]
+				f.write('\t// level %d, %s\n' % (l, name))
+				for i in range(0, len(data), 16):
+					f.write('\t' + ', '.join(str(v) for v in data[i:i + 16]) + ',\n')
+		f.write('};\n')
+
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,147 @@
+// Minimoog - patch renderer
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Audio benchmark, for one block size and sample rate.
+ *
+ * Runs the Teensy sketch on the computer, with a note playing through three oscillators, the filter, the envelopes
+ * and the effect bus, and measures the time spent in the audio update. It prints one line :
+ *	block_size sample_rate nanoseconds_per_block
+ * benchmark.py builds it for each setting and compares them. The times are the computer's, not the Teensy's :
+ * they tell how the settings compare, not how much of the Teensy they take.
+ * With "stereo" as argument, the right filter is offset, so both sides are computed : by default the patch is mono.
+ * With "oscillators" as argument, it times the oscillator bank alone, with both slaves synced and oscillator 3
+ * modulating the others, against three AudioSynthWaveformModulated, and prints both times :
+ *	block_size sample_rate bank_nanoseconds_per_block library_nanoseconds_per_block
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "Audio.h"
+#include "defs.h"
+#include "synth_oscillator.h"
+
+// From the sketch.
+void setup();
+void handleControlChange(uint8_t channel, uint8_t command, uint8_t value);
+void handleNoteOn(uint8_t channel, uint8_t note, uint8_t velocity);
+
+// Audio time measured, and number of measures : the fastest is kept, the others had the computer busy.
+const float MEASURE_TIME = 5.0;
+const uint8_t MEASURES = 5;
+
+void sendPot(uint8_t cc, uint16_t value){
+	handleControlChange(1, cc, value >> 7);
+	handleControlChange(1, cc + 32, value & 0x7F);
+}
+
+void render(uint32_t blocks){
+	for(uint32_t i = 0; i < blocks; ++i){
+		AudioStream::update_all();
+	}
+}
+
+// Once through first, so the envelopes are on sustain and every buffer is in use.
+template<typename Render> double measure(uint32_t blocks, Render run){
+	run(blocks / 4);
+
+	double best = 0;
+	for(uint8_t i = 0; i < MEASURES; ++i){
+		auto start = std::chrono::steady_clock::now();
+		run(blocks);
+		auto end = std::chrono::steady_clock::now();
+		double ns = std::chrono::duration<double, std::nano>(end - start).count() / blocks;
+		if(!i || (ns < best)) best = ns;
+	}
+	return best;
+}
+
+// Three sawtooth, with the same pitch modulation : in the bank, oscillators 2 and 3 are synced to 1,
+// and 3 modulates 1 and 2. Only these nodes are updated.
+void oscillators(uint32_t blocks){
+	const float frequencies[OSC_BANK_SIZE] = {110.0, 166.3, 247.1};
+	AudioSynthWaveformDc pitch;
+	AudioSynthOscillatorBank bank;
+	AudioSynthWaveformModulated library[OSC_BANK_SIZE];
+	AudioConnection bank0(pitch, 0, bank, 0);
+	AudioConnection bank1(pitch, 0, bank, 1);
+	AudioConnection bank2(pitch, 0, bank, 2);
+	AudioConnection library0(pitch, 0, library[0], 0);
+	AudioConnection library1(pitch, 0, library[1], 0);
+	AudioConnection library2(pitch, 0, library[2], 0);
+
+	pitch.amplitude(0.1);
+	for(uint8_t i = 0; i < OSC_BANK_SIZE; ++i){
+		bank.begin(i, 0.8, frequencies[i], WAVEFORM_SAWTOOTH);
+		bank.frequencyModulation(i, 10);
+		library[i].begin(0.8, frequencies[i], WAVEFORM_SAWTOOTH);
+		library[i].frequencyModulation(10);
+	}
+	bank.sync(1, true);
+	bank.sync(2, true);
+	bank.fmAmount(1.0);
+
+	double bankTime = measure(blocks, [&](uint32_t count){
+		for(uint32_t i = 0; i < count; ++i){
+			pitch.update();
+			bank.update();
+		}
+	});
+	double libraryTime = measure(blocks, [&](uint32_t count){
+		for(uint32_t i = 0; i < count; ++i){
+			pitch.update();
+			for(uint8_t n = 0; n < OSC_BANK_SIZE; ++n){
+				library[n].update();
+			}
+		}
+	});
+
+	printf("%d %.0f %.1f %.1f\n", AUDIO_BLOCK_SAMPLES, (double)AUDIO_SAMPLE_RATE_EXACT, bankTime, libraryTime);
+}
+
+int main(int argc, char **argv){
+	uint32_t blocks = MEASURE_TIME * AUDIO_SAMPLE_RATE_EXACT / AUDIO_BLOCK_SAMPLES;
+	if((argc > 1) && !strcmp(argv[1], "oscillators")){
+		oscillators(blocks);
+		return 0;
+	}
+
+	setup();
+	sendPot(CC_CHANNEL_VOL, 3300);
+	sendPot(CC_OSC1_MIX, 3000);
+	sendPot(CC_OSC2_MIX, 3000);
+	sendPot(CC_OSC3_MIX, 3000);
+	sendPot(CC_FILTER_CUTOFF_FREQ, 2500);
+	sendPot(CC_FILTER_EMPHASIS, 1500);
+	sendPot(CC_FILTER_CONTOUR, 2000);
+	sendPot(CC_EG_SUSTAIN, 4095);
+	sendPot(CC_FILTER_SUSTAIN, 3000);
+	handleControlChange(1, CC_FX_ON_OFF, 127);
+	handleControlChange(1, CC_FX_DELAY_MIX, 40);
+	handleControlChange(1, CC_FX_CHORUS_MIX, 40);
+	handleControlChange(1, CC_FX_REVERB_MIX, 40);
+	if((argc > 1) && !strcmp(argv[1], "stereo")) handleControlChange(1, CC_STEREO_FILTER_OFFSET, 80);
+	handleNoteOn(1, 48, 100);
+
+	printf("%d %.0f %.1f\n", AUDIO_BLOCK_SAMPLES, (double)AUDIO_SAMPLE_RATE_EXACT, measure(blocks, render));
+	return 0;
+}
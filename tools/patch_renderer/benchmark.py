@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+# Minimoog - patch renderer
+#
+# This program is part of a minimoog-like synthesizer based on teensy 4.0
+# Copyright (C) 2020  Pierre-Loup Martin
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# Compares the audio block sizes and sample rates : builds the benchmark for each setting, runs it,
+# and prints the time per block and per sample. The time per block is a fixed part, that every node spends
+# on each block whatever its size, plus a part for each sample : both are fitted on all the settings.
+# Times are the computer's, not the Teensy's : they tell how the settings compare.
+# The first setting is run again with the right side computed too, to tell what the stereo costs, and the oscillator
+# bank, with sync and FM on, is timed against three oscillators of the audio library.
+# Usage : make benchmark, or python3 benchmark.py
+
+import os
+import subprocess
+import sys
+
+# Block size and sample rate.
+SETTINGS = (
+	(128, 44100), (64, 44100), (32, 44100), (16, 44100),
+	(128, 48000), (32, 48000),
+	(128, 96000), (16, 96000),
+)
+
+
+def run(block, rate, args=()):
+	build = 'build/benchmark_%d_%d' % (block, rate)
+	defines = '-DAUDIO_BLOCK_SAMPLES=%d -DAUDIO_SAMPLE_RATE_EXACT=%d.0f' % (block, rate)
+	subprocess.run(['make', '-s', 'BUILD=' + build, 'DEFINES=' + defines, build + '/benchmark'], check=True)
+	output = subprocess.run([build + '/benchmark'] + list(args), check=True, capture_output=True, text=True).stdout
+	return [float(value) for value in output.split()[2:]]
+
+
+def main():
+	os.chdir(os.path.dirname(os.path.abspath(__file__)))
+	results = []
+	for block, rate in SETTINGS:
+		results.append((block, rate, run(block, rate)[0]))
+
+	# Least squares : time per block = overhead + block * time per sample.
+	n = len(results)
+	sx = sum(block for block, rate, ns in results)
+	sy = sum(ns for block, rate, ns in results)
+	sxx = sum(block * block for block, rate, ns in results)
+	sxy = sum(block * ns for block, rate, ns in results)
+	perSample = (n * sxy - sx * sy) / (n * sxx - sx * sx)
+	overhead = (sy - perSample * sx) / n
+
+	print('block  rate    latency   per block   per sample   real time   fixed part')
+	for block, rate, ns in results:
+		latency = block * 1000.0 / rate
+		load = ns / (block * 1e9 / rate) * 100
+		fixed = min(overhead / ns * 100, 100)
+		print('%5d  %5d  %6.2fms  %8.2fus  %9.1fns  %9.2f%%  %10.0f%%' % (block, rate, latency, ns / 1000, ns / block, load, fixed))
+	print('fitted : %.2fus per block, plus %.1fns per sample' % (overhead / 1000, perSample))
+
+	# The right side only runs when a stereo control is off center.
+	block, rate, mono = results[0]
+	stereo = run(block, rate, ('stereo',))[0]
+	print('stereo : %.2fus per block, %.0f%% more than mono' % (stereo / 1000, (stereo / mono - 1) * 100))
+
+	bank, library = run(block, rate, ('oscillators',))
+	print('oscillators, sync and FM on : %.2fus per block, three AudioSynthWaveformModulated %.2fus (%+.0f%%)'
+		% (bank / 1000, library / 1000, (bank / library - 1) * 100))
+
+
+if __name__ == '__main__':
+	sys.exit(main())
@@ -0,0 +1,560 @@
+// Minimoog - patch renderer
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Batch patch renderer.
+ *
+ * Runs the Teensy sketch on the computer : the audio graph of audio_setup.h, and the control changes handled
+ * by handleControlChange(), as the panel sends them. Each patch is a set of panel controls, it plays one note,
+ * and is written as a WAV file, along with a line of spectral statistics in stats.csv.
+ *
+ * Patches are rendered in parallel, each in its own process forked from a synth that has just started :
+ * every patch starts from the same state, and nothing is shared, so it scales with the number of cores.
+ *
+ * Usage : patch_renderer [options]
+ *	-n count		random patches to render (default 16)
+ *	-g steps		grid instead of random : every combination of steps values of the varied controls
+ *	-p name,name	controls that vary (default all, see PARAMETERS), the others keep their default value
+ *	-s seed			random seed (default 1). Patch n is the same for a seed, whatever the number of jobs.
+ *	-j jobs			processes rendering at the same time (default : number of cores)
+ *	-k note			MIDI note played (default 48)
+ *	-t seconds		note length (default 1.0), followed by one second of release
+ *	-o directory	where files are written (default "renders", must exist)
+ *	-l				list the controls and exit
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include <string>
+#include <vector>
+
+#include "Audio.h"
+#include "defs.h"
+
+// From the sketch.
+extern AudioOutputI2S i2s;
+void setup();
+void handleControlChange(uint8_t channel, uint8_t command, uint8_t value);
+void handleNoteOn(uint8_t channel, uint8_t note, uint8_t velocity);
+void handleNoteOff(uint8_t channel, uint8_t note, uint8_t velocity);
+
+// Panel resolution, as sent by the Megas.
+const uint16_t POT_MAX = 4095;
+// The master volume is not part of a patch.
+const uint16_t VOLUME = 3300;
+// Time between the patch being set and the note, so that every control has settled.
+const float SETTLE_TIME = 0.1;
+const float RELEASE_TIME = 1.0;
+
+// Spectral analysis.
+const uint16_t FFT_SIZE = 2048;
+const uint16_t FFT_HOP = FFT_SIZE / 2;
+const float ROLLOFF = 0.85;
+
+enum parameter_t{
+	PARAM_POT = 0,			// 14 bits control change, from 0 to POT_MAX
+	PARAM_SWITCH,			// 0 or 127
+	PARAM_SELECTOR,			// from 0 to positions - 1
+	PARAM_VALUE,			// 7 bits control change
+};
+
+struct Parameter{
+	const char *name;
+	uint8_t cc;
+	parameter_t type;
+	uint8_t positions;
+	uint16_t initial;
+};
+
+// Panel controls, in the order they are sent. Defaults are a plain sawtooth through an open filter.
+const Parameter PARAMETERS[] = {
+	{"tune",			CC_OSC_TUNE,			PARAM_POT,		0,	2048},
+	{"glide",			CC_PORTAMENTO_TIME,		PARAM_POT,		0,	0},
+	{"mod_mix",			CC_MODULATION_MIX,		PARAM_POT,		0,	0},
+	{"mod_wheel",		CC_MOD_WHEEL,			PARAM_POT,		0,	0},
+	{"lfo_rate",		CC_LFO_RATE,			PARAM_POT,		0,	1500},
+	{"osc2_tune",		CC_OSC2_TUNE,			PARAM_POT,		0,	2048},
+	{"osc3_tune",		CC_OSC3_TUNE,			PARAM_POT,		0,	2048},
+	{"osc1_mix",		CC_OSC1_MIX,			PARAM_POT,		0,	3000},
+	{"osc2_mix",		CC_OSC2_MIX,			PARAM_POT,		0,	0},
+	{"osc3_mix",		CC_OSC3_MIX,			PARAM_POT,		0,	0},
+	{"noise_mix",		CC_NOISE_MIX,			PARAM_POT,		0,	0},
+	{"feedback_mix",	CC_FEEDBACK_MIX,		PARAM_POT,		0,	0},
+	{"filter_band",		CC_FILTER_BAND,			PARAM_POT,		0,	0},
+	{"cutoff",			CC_FILTER_CUTOFF_FREQ,	PARAM_POT,		0,	3000},
+	{"emphasis",		CC_FILTER_EMPHASIS,		PARAM_POT,		0,	0},
+	{"contour",			CC_FILTER_CONTOUR,		PARAM_POT,		0,	0},
+	{"filter_attack",	CC_FILTER_ATTACK,		PARAM_POT,		0,	0},
+	{"filter_decay",	CC_FILTER_DECAY,		PARAM_POT,		0,	1500},
+	{"filter_sustain",	CC_FILTER_SUSTAIN,		PARAM_POT,		0,	4095},
+	{"filter_release",	CC_FILTER_RELEASE,		PARAM_POT,		0,	1000},
+	{"attack",			CC_EG_ATTACK,			PARAM_POT,		0,	0},
+	{"decay",			CC_EG_DECAY,			PARAM_POT,		0,	1500},
+	{"sustain",			CC_EG_SUSTAIN,			PARAM_POT,		0,	4095},
+	{"release",			CC_EG_RELEASE,			PARAM_POT,		0,	1000},
+	{"osc1_range",		CC_OSC1_RANGE,			PARAM_SELECTOR,	6,	2},
+	{"osc2_range",		CC_OSC2_RANGE,			PARAM_SELECTOR,	6,	2},
+	{"osc3_range",		CC_OSC3_RANGE,			PARAM_SELECTOR,	6,	2},
+	{"osc1_wave",		CC_OSC1_WAVEFORM,		PARAM_SELECTOR,	6,	2},
+	{"osc2_wave",		CC_OSC2_WAVEFORM,		PARAM_SELECTOR,	6,	2},
+	{"osc3_wave",		CC_OSC3_WAVEFORM,		PARAM_SELECTOR,	6,	2},
+	{"glide_on",		CC_PORTAMENTO_ON_OFF,	PARAM_SWITCH,	0,	127},
+	{"osc3_ctrl",		CC_OSC3_CTRL,			PARAM_SWITCH,	0,	127},
+	{"filter_mod",		CC_FILTER_MOD,			PARAM_SWITCH,	0,	0},
+	{"keytrack_1",		CC_FILTER_KEYTRACK_1,	PARAM_SWITCH,	0,	0},
+	{"keytrack_2",		CC_FILTER_KEYTRACK_2,	PARAM_SWITCH,	0,	0},
+	{"noise_color",		CC_NOISE_COLOR,			PARAM_SWITCH,	0,	0},
+	{"osc_mod",			CC_OSC_MOD,				PARAM_SWITCH,	0,	0},
+	{"decay_sw",		CC_DECAY_SW,			PARAM_SWITCH,	0,	0},
+	{"mod_mix_1",		CC_MOD_MIX_1,			PARAM_SWITCH,	0,	0},
+	{"mod_mix_2",		CC_MOD_MIX_2,			PARAM_SWITCH,	0,	0},
+	{"lfo_shape",		CC_LFO_SHAPE,			PARAM_SWITCH,	0,	0},
+	{"osc2_sync",		CC_OSC2_SYNC,			PARAM_SWITCH,	0,	0},
+	{"osc3_sync",		CC_OSC3_SYNC,			PARAM_SWITCH,	0,	0},
+	{"fm_amount",		CC_OSC_FM_AMOUNT,		PARAM_VALUE,	0,	0},
+	{"morph",			CC_WAVETABLE_MORPH,		PARAM_VALUE,	0,	0},
+	{"osc1_pan",		CC_OSC1_PAN,			PARAM_VALUE,	0,	64},
+	{"osc2_pan",		CC_OSC2_PAN,			PARAM_VALUE,	0,	64},
+	{"osc3_pan",		CC_OSC3_PAN,			PARAM_VALUE,	0,	64},
+	{"noise_pan",		CC_NOISE_PAN,			PARAM_VALUE,	0,	64},
+	{"stereo_filter",	CC_STEREO_FILTER_OFFSET,	PARAM_VALUE,	0,	64},
+	{"stereo_envelope",	CC_STEREO_ENVELOPE_OFFSET,	PARAM_VALUE,	0,	0},
+};
+const uint8_t NUM_PARAMETERS = sizeof(PARAMETERS) / sizeof(Parameter);
+
+struct Stats{
+	float rms;
+	float peak;
+	float centroid;
+	float rolloff;
+	float flatness;
+	bool done;
+};
+
+struct Options{
+	uint32_t count;
+	uint8_t steps;
+	uint32_t seed;
+	uint16_t jobs;
+	uint8_t note;
+	float length;
+	std::string directory;
+};
+
+// Highest value of a parameter.
+uint16_t parameterMax(const Parameter *param){
+	switch(param->type){
+		case PARAM_POT:
+			return POT_MAX;
+		case PARAM_SWITCH:
+			return 1;
+		case PARAM_SELECTOR:
+			return param->positions - 1;
+		case PARAM_VALUE:
+		default:
+			return 127;
+	}
+}
+
+// Send a parameter as the panel does.
+void sendParameter(const Parameter *param, uint16_t value){
+	switch(param->type){
+		case PARAM_POT:
+			handleControlChange(1, param->cc, value >> 7);
+			handleControlChange(1, param->cc + 32, value & 0x7F);
+			break;
+		case PARAM_SWITCH:
+			handleControlChange(1, param->cc, value ? 127 : 0);
+			break;
+		default:
+			handleControlChange(1, param->cc, value);
+			break;
+	}
+}
+
+// xorshift, seeded per patch so a patch doesn't depend on the order they are rendered.
+uint32_t patchRandom(uint32_t *state){
+	uint32_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return x;
+}
+
+// Values of every parameter for each patch, random or on a grid.
+std::vector<std::vector<uint16_t>> makePatches(const Options &options, const std::vector<bool> &varied){
+	std::vector<std::vector<uint16_t>> patches;
+	std::vector<uint16_t> initial(NUM_PARAMETERS);
+	std::vector<uint8_t> grid;
+	for(uint8_t i = 0; i < NUM_PARAMETERS; ++i){
+		initial[i] = PARAMETERS[i].type == PARAM_SWITCH ? (PARAMETERS[i].initial > 63) : PARAMETERS[i].initial;
+		if(varied[i]) grid.push_back(i);
+	}
+
+	if(options.steps){
+		// Switches and selectors have less values than steps : they only take the ones they have.
+		std::vector<uint16_t> steps(grid.size());
+		uint64_t count = 1;
+		for(uint8_t i = 0; i < grid.size(); ++i){
+			uint16_t max = parameterMax(&PARAMETERS[grid[i]]);
+			steps[i] = (options.steps > max + 1) ? max + 1 : options.steps;
+			count *= steps[i];
+			if(count > 1000000){
+				fprintf(stderr, "grid too large, vary less controls or use less steps\n");
+				exit(1);
+			}
+		}
+		for(uint64_t n = 0; n < count; ++n){
+			std::vector<uint16_t> patch = initial;
+			uint64_t index = n;
+			for(uint8_t i = 0; i < grid.size(); ++i){
+				uint16_t max = parameterMax(&PARAMETERS[grid[i]]);
+				uint16_t step = index % steps[i];
+				index /= steps[i];
+				patch[grid[i]] = (steps[i] > 1) ? (uint32_t)step * max / (steps[i] - 1) : initial[grid[i]];
+			}
+			patches.push_back(patch);
+		}
+	} else {
+		for(uint32_t n = 0; n < options.count; ++n){
+			std::vector<uint16_t> patch = initial;
+			uint32_t state = (options.seed * 2654435761u) ^ (n * 40503u + 1);
+			if(!state) state = 1;
+			for(uint8_t i = 0; i < NUM_PARAMETERS; ++i){
+				uint32_t value = patchRandom(&state);
+				if(varied[i]) patch[i] = value % (parameterMax(&PARAMETERS[i]) + 1);
+			}
+			patches.push_back(patch);
+		}
+	}
+	return patches;
+}
+
+bool writeWav(const std::string &path, const std::vector<int16_t> &samples){
+	FILE *file = fopen(path.c_str(), "wb");
+	if(!file) return false;
+
+	uint32_t rate = AUDIO_SAMPLE_RATE_EXACT + 0.5;
+	uint16_t channels = 2;
+	uint16_t bits = 16;
+	uint32_t dataSize = samples.size() * sizeof(int16_t);
+	uint32_t riffSize = 36 + dataSize;
+	uint32_t byteRate = rate * channels * bits / 8;
+	uint16_t blockAlign = channels * bits / 8;
+	uint32_t formatSize = 16;
+	uint16_t format = 1;
+
+	fwrite("RIFF", 1, 4, file);
+	fwrite(&riffSize, 4, 1, file);
+	fwrite("WAVEfmt ", 1, 8, file);
+	fwrite(&formatSize, 4, 1, file);
+	fwrite(&format, 2, 1, file);
+	fwrite(&channels, 2, 1, file);
+	fwrite(&rate, 4, 1, file);
+	fwrite(&byteRate, 4, 1, file);
+	fwrite(&blockAlign, 2, 1, file);
+	fwrite(&bits, 2, 1, file);
+	fwrite("data", 1, 4, file);
+	fwrite(&dataSize, 4, 1, file);
+	fwrite(samples.data(), sizeof(int16_t), samples.size(), file);
+	fclose(file);
+	return true;
+}
+
+// In place radix 2 FFT.
+void fft(std::vector<float> &re, std::vector<float> &im){
+	uint32_t n = re.size();
+	for(uint32_t i = 1, j = 0; i < n; ++i){
+		uint32_t bit = n >> 1;
+		for(; j & bit; bit >>= 1) j ^= bit;
+		j ^= bit;
+		if(i < j){
+			std::swap(re[i], re[j]);
+			std::swap(im[i], im[j]);
+		}
+	}
+	for(uint32_t length = 2; length <= n; length <<= 1){
+		float angle = -2.0 * M_PI / length;
+		for(uint32_t i = 0; i < n; i += length){
+			for(uint32_t k = 0; k < length / 2; ++k){
+				float wr = cosf(angle * k);
+				float wi = sinf(angle * k);
+				uint32_t a = i + k;
+				uint32_t b = a + length / 2;
+				float tr = re[b] * wr - im[b] * wi;
+				float ti = re[b] * wi + im[b] * wr;
+				re[b] = re[a] - tr;
+				im[b] = im[a] - ti;
+				re[a] += tr;
+				im[a] += ti;
+			}
+		}
+	}
+}
+
+// Level in dB full scale, and spectral shape averaged over frames, weighted by their energy.
+// Statistics are computed on the left channel.
+Stats analyze(const std::vector<int16_t> &samples){
+	Stats stats = {-120.0, -120.0, 0.0, 0.0, 0.0, true};
+	uint32_t length = samples.size() / 2;
+	if(!length) return stats;
+
+	double sum = 0;
+	int32_t peak = 0;
+	for(uint32_t i = 0; i < length; ++i){
+		int32_t value = samples[2 * i];
+		sum += (double)value * value;
+		if(abs(value) > peak) peak = abs(value);
+	}
+	double rms = sqrt(sum / length) / 32768.0;
+	if(rms > 0) stats.rms = 20.0 * log10(rms);
+	if(peak > 0) stats.peak = 20.0 * log10(peak / 32768.0);
+
+	std::vector<float> window(FFT_SIZE);
+	for(uint16_t i = 0; i < FFT_SIZE; ++i){
+		window[i] = 0.5 - 0.5 * cosf(2.0 * M_PI * i / FFT_SIZE);
+	}
+
+	double weight = 0;
+	double centroid = 0;
+	double rolloff = 0;
+	double flatness = 0;
+	std::vector<float> re(FFT_SIZE);
+	std::vector<float> im(FFT_SIZE);
+	for(uint32_t start = 0; start + FFT_SIZE <= length; start += FFT_HOP){
+		for(uint16_t i = 0; i < FFT_SIZE; ++i){
+			re[i] = samples[2 * (start + i)] / 32768.0 * window[i];
+			im[i] = 0;
+		}
+		fft(re, im);
+
+		double energy = 0;
+		double moment = 0;
+		double logSum = 0;
+		std::vector<double> power(FFT_SIZE / 2);
+		for(uint16_t k = 1; k < FFT_SIZE / 2; ++k){
+			power[k] = re[k] * re[k] + im[k] * im[k];
+			energy += power[k];
+			moment += power[k] * k;
+			logSum += log(power[k] + 1e-20);
+		}
+		if(energy < 1e-9) continue;
+
+		double binWidth = AUDIO_SAMPLE_RATE_EXACT / FFT_SIZE;
+		double cumulated = 0;
+		uint16_t rolloffBin = FFT_SIZE / 2 - 1;
+		for(uint16_t k = 1; k < FFT_SIZE / 2; ++k){
+			cumulated += power[k];
+			if(cumulated >= ROLLOFF * energy){
+				rolloffBin = k;
+				break;
+			}
+		}
+		double geometric = exp(logSum / (FFT_SIZE / 2 - 1));
+		double arithmetic = energy / (FFT_SIZE / 2 - 1);
+
+		weight += energy;
+		// The frame centroid is moment / energy, weighted by energy.
+		centroid += moment * binWidth;
+		rolloff += energy * rolloffBin * binWidth;
+		flatness += energy * geometric / arithmetic;
+	}
+	if(weight > 0){
+		stats.centroid = centroid / weight;
+		stats.rolloff = rolloff / weight;
+		stats.flatness = flatness / weight;
+	}
+	return stats;
+}
+
+// Render in the audio library's rhythm : one block at a time.
+void render(float seconds){
+	uint32_t blocks = seconds * AUDIO_SAMPLE_RATE_EXACT / AUDIO_BLOCK_SAMPLES + 0.5;
+	for(uint32_t i = 0; i < blocks; ++i){
+		AudioStream::update_all();
+	}
+}
+
+// Called in a forked process : the synth is as it has just started, whatever was rendered before.
+void renderPatch(const Options &options, uint32_t index, const std::vector<uint16_t> &patch, Stats *stats){
+	for(uint8_t i = 0; i < NUM_PARAMETERS; ++i){
+		sendParameter(&PARAMETERS[i], patch[i]);
+	}
+	render(SETTLE_TIME);
+
+	i2s.capture = true;
+	handleNoteOn(1, options.note, 100);
+	render(options.length);
+	handleNoteOff(1, options.note, 0);
+	render(RELEASE_TIME);
+
+	char name[32];
+	snprintf(name, sizeof(name), "/patch_%05u.wav", index);
+	if(!writeWav(options.directory + name, i2s.samples)){
+		fprintf(stderr, "can't write %s%s\n", options.directory.c_str(), name);
+	}
+	*stats = analyze(i2s.samples);
+}
+
+void usage(){
+	fprintf(stderr, "usage : patch_renderer [-n count] [-g steps] [-p name,name...] [-s seed] [-j jobs] [-k note] [-t seconds] [-o directory] [-l]\n");
+	exit(1);
+}
+
+int main(int argc, char **argv){
+	Options options;
+	options.count = 16;
+	options.steps = 0;
+	options.seed = 1;
+	options.jobs = sysconf(_SC_NPROCESSORS_ONLN);
+	options.note = 48;
+	options.length = 1.0;
+	options.directory = "renders";
+	std::vector<bool> varied(NUM_PARAMETERS, true);
+
+	int opt;
+	while((opt = getopt(argc, argv, "n:g:p:s:j:k:t:o:l")) != -1){
+		switch(opt){
+			case 'n':
+				options.count = atoi(optarg);
+				break;
+			case 'g':
+				options.steps = atoi(optarg);
+				if(options.steps < 2) usage();
+				break;
+			case 'p':{
+				varied.assign(NUM_PARAMETERS, false);
+				char *name = strtok(optarg, ",");
+				for(; name; name = strtok(NULL, ",")){
+					uint8_t i = 0;
+					for(; i < NUM_PARAMETERS; ++i){
+						if(!strcmp(name, PARAMETERS[i].name)) break;
+					}
+					if(i == NUM_PARAMETERS){
+						fprintf(stderr, "unknown control %s, see -l\n", name);
+						exit(1);
+					}
+					varied[i] = true;
+				}
+				break;
+			}
+			case 's':
+				options.seed = strtoul(optarg, NULL, 0);
+				break;
+			case 'j':
+				options.jobs = atoi(optarg);
+				break;
+			case 'k':
+				options.note = atoi(optarg) & 0x7F;
+				break;
+			case 't':
+				options.length = atof(optarg);
+				break;
+			case 'o':
+				options.directory = optarg;
+				break;
+			case 'l':
+				for(uint8_t i = 0; i < NUM_PARAMETERS; ++i){
+					printf("%-16s CC %3d, 0 to %d, default %d\n", PARAMETERS[i].name, PARAMETERS[i].cc,
+							parameterMax(&PARAMETERS[i]), PARAMETERS[i].initial);
+				}
+				return 0;
+			default:
+				usage();
+		}
+	}
+	if(options.jobs < 1) options.jobs = 1;
+
+	std::vector<std::vector<uint16_t>> patches = makePatches(options, varied);
+	uint32_t count = patches.size();
+
+	// The synth starts once. Every patch is then rendered in a copy of this process.
+	setup();
+	handleControlChange(1, CC_CHANNEL_VOL, VOLUME >> 7);
+	handleControlChange(1, CC_CHANNEL_VOL_LSB, VOLUME & 0x7F);
+
+	// Statistics are written by the workers in shared memory, and saved in patch order at the end.
+	Stats *stats = (Stats*)mmap(NULL, count * sizeof(Stats) + 1, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if(stats == MAP_FAILED){
+		perror("mmap");
+		return 1;
+	}
+	memset(stats, 0, count * sizeof(Stats));
+
+	uint32_t next = 0;
+	uint16_t running = 0;
+	uint32_t failed = 0;
+	while((next < count) || running){
+		if((next < count) && (running < options.jobs)){
+			pid_t pid = fork();
+			if(pid < 0){
+				perror("fork");
+				return 1;
+			}
+			if(pid == 0){
+				renderPatch(options, next, patches[next], &stats[next]);
+				_exit(0);
+			}
+			next++;
+			running++;
+			continue;
+		}
+		int status;
+		if(wait(&status) > 0){
+			running--;
+			if(!WIFEXITED(status) || WEXITSTATUS(status)) failed++;
+		}
+	}
+
+	std::string path = options.directory + "/stats.csv";
+	FILE *file = fopen(path.c_str(), "w");
+	if(!file){
+		fprintf(stderr, "can't write %s\n", path.c_str());
+		return 1;
+	}
+	fprintf(file, "patch");
+	for(uint8_t i = 0; i < NUM_PARAMETERS; ++i){
+		fprintf(file, ",%s", PARAMETERS[i].name);
+	}
+	fprintf(file, ",rms_db,peak_db,centroid_hz,rolloff_hz,flatness\n");
+	for(uint32_t n = 0; n < count; ++n){
+		fprintf(file, "%u", n);
+		for(uint8_t i = 0; i < NUM_PARAMETERS; ++i){
+			fprintf(file, ",%u", patches[n][i]);
+		}
+		if(stats[n].done){
+			fprintf(file, ",%.2f,%.2f,%.1f,%.1f,%.4f\n", stats[n].rms, stats[n].peak, stats[n].centroid,
+					stats[n].rolloff, stats[n].flatness);
+		} else {
+			fprintf(file, ",,,,,\n");
+		}
+	}
+	fclose(file);
+
+	printf("%u patches rendered in %s", count - failed, options.directory.c_str());
+	if(failed) printf(", %u failed", failed);
+	printf("\n");
+	return failed ? 1 : 0;
+}
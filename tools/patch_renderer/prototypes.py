@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+# Minimoog - patch renderer
+#
+# This program is part of a minimoog-like synthesizer based on teensy 4.0
+# Copyright (C) 2020  Pierre-Loup Martin
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# Turns the sketch into C++, as the Arduino IDE does : prototypes of every function are added after the last include,
+# so functions can be used before they are defined.
+# Usage : python3 prototypes.py sketch.ino sketch.cpp
+
+import re
+import sys
+
+FUNCTION = re.compile(r'^([A-Za-z_][\w:<>\*&\s]*?[\s\*&]+)(\w+)\(([^;{)]*)\)\s*\{', re.M)
+KEYWORDS = ('if', 'for', 'while', 'switch')
+
+
+def prototypes(source):
+	result = []
+	for match in FUNCTION.finditer(source):
+		ret, name, args = match.group(1).strip(), match.group(2), match.group(3)
+		if ret in ('else', 'return') or name in KEYWORDS:
+			continue
+		# Functions with default arguments are left out, they are defined before being used.
+		if '=' in args:
+			continue
+		result.append('%s %s(%s);' % (ret, name, args))
+	return result
+
+
+def main():
+	source = open(sys.argv[1]).read()
+	last = [match.end() for match in re.finditer(r'^#include.*$', source, re.M)][-1] + 1
+	head, tail = source[:last], source[last:]
+	# Line numbers of errors are the ones of the sketch.
+	with open(sys.argv[2], 'w') as out:
+		out.write('#line 1 "%s"\n' % sys.argv[1])
+		out.write(head)
+		out.write('\n'.join(prototypes(source)) + '\n')
+		out.write('#line %d "%s"\n' % (head.count('\n') + 1, sys.argv[1]))
+		out.write(tail)
+
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,92 @@
+// Minimoog - patch renderer
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Host stand-in for the Arduino core : only what the sketch uses.
+
+#ifndef SHIM_ARDUINO_H
+#define SHIM_ARDUINO_H
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+using std::min; using std::max;
+#define DMAMEM
+#define PROGMEM
+#define FLASHMEM
+#define FASTRUN
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define HIGH 1
+#define LOW 0
+#define constrain(x,a,b) ((x)<(a)?(a):((x)>(b)?(b):(x)))
+inline void pinMode(uint8_t, uint8_t){}
+inline void digitalWrite(uint8_t, uint8_t){}
+inline int digitalRead(uint8_t){return 1;}
+uint32_t millis();
+uint32_t micros();
+// Added to micros(), so the host tests can place an event between two audio updates.
+extern uint32_t shimMicros;
+void delay(uint32_t);
+inline void delayMicroseconds(uint32_t){}
+inline long random(){return rand();}
+inline long random(long m){return rand()%m;}
+inline long random(long a,long b){return a+rand()%(b-a);}
+inline void randomSeed(unsigned long s){srand(s);}
+inline void noInterrupts(){}
+inline void interrupts(){}
+inline void __disable_irq(){}
+inline void __enable_irq(){}
+inline void yield(){}
+struct ShimSerial{
+	void begin(long){}
+	explicit operator bool(){return false;}
+	template<class T> void print(T){}
+	template<class T> void print(T, int){}
+	template<class T> void println(T){}
+	template<class T> void println(T, int){}
+	void println(){}
+	int available(){return 0;}
+	int read(){return -1;}
+};
+extern ShimSerial Serial;
+class IntervalTimer{
+public:
+	template<class F> bool begin(F f, float){_f = f; return true;}
+	void end(){}
+	void priority(uint8_t){}
+	void (*_f)() = nullptr;
+};
+class elapsedMillis{
+public:
+	elapsedMillis(){ms = millis();}
+	operator uint32_t() const {return millis() - ms;}
+	elapsedMillis &operator=(uint32_t v){ms = millis() - v; return *this;}
+	uint32_t ms;
+};
+class elapsedMicros{
+public:
+	elapsedMicros(){us = micros();}
+	operator uint32_t() const {return micros() - us;}
+	elapsedMicros &operator=(uint32_t v){us = micros() - v; return *this;}
+	uint32_t us;
+};
+#endif
@@ -0,0 +1,409 @@
+// Minimoog - patch renderer
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Host models of the audio library objects used by the sketch. They behave like the originals, but are not bit exact.
+// The synth's own nodes (oscillators, envelopes, effect bus) are compiled from the sketch, so they are.
+// The I2S output keeps what it receives, for the renderer to read.
+
+#ifndef SHIM_AUDIO_H
+#define SHIM_AUDIO_H
+#include "Arduino.h"
+#include "AudioStream.h"
+#include <vector>
+
+#define WAVEFORM_SINE              0
+#define WAVEFORM_SAWTOOTH          1
+#define WAVEFORM_SQUARE            2
+#define WAVEFORM_TRIANGLE          3
+#define WAVEFORM_ARBITRARY         4
+#define WAVEFORM_PULSE             5
+#define WAVEFORM_SAWTOOTH_REVERSE  6
+#define WAVEFORM_SAMPLE_HOLD       7
+#define WAVEFORM_TRIANGLE_VARIABLE 8
+
+extern "C" const int16_t AudioWaveformSine[257];
+
+static inline int16_t shimSat16(float v){
+	if(v > 32767.0f) return 32767;
+	if(v < -32768.0f) return -32768;
+	return (int16_t)v;
+}
+
+class AudioSynthWaveformDc : public AudioStream{
+public:
+	AudioSynthWaveformDc() : AudioStream(0, NULL){}
+	void amplitude(float n){_value = _target = constrain(n, -1.0f, 1.0f); _inc = 0;}
+	void amplitude(float n, float ms){
+		n = constrain(n, -1.0f, 1.0f);
+		float samples = ms * AUDIO_SAMPLE_RATE_EXACT / 1000.0f;
+		if(samples < 1.0f){amplitude(n); return;}
+		_target = n;
+		_inc = (n - _value) / samples;
+	}
+	float read(){return _value;}
+	virtual void update(void){
+		audio_block_t *block = allocate();
+		if(!block) return;
+		for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+			if(_inc != 0){
+				_value += _inc;
+				if((_inc > 0 && _value >= _target) || (_inc < 0 && _value <= _target)){
+					_value = _target;
+					_inc = 0;
+				}
+			}
+			block->data[i] = shimSat16(_value * 32767.0f);
+		}
+		transmit(block);
+		release(block);
+	}
+private:
+	float _value = 0, _target = 0, _inc = 0;
+};
+
+class AudioSynthNoiseWhite : public AudioStream{
+public:
+	AudioSynthNoiseWhite() : AudioStream(0, NULL){_seed = 1 + _instance++;}
+	void amplitude(float n){_level = constrain(n, 0.0f, 1.0f);}
+	virtual void update(void){
+		if(_level == 0) return;
+		audio_block_t *block = allocate();
+		if(!block) return;
+		for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+			_seed = _seed * 1103515245u + 12345u;
+			block->data[i] = (int16_t)((int32_t)(_seed >> 16) - 32768) * _level;
+		}
+		transmit(block);
+		release(block);
+	}
+protected:
+	float _level = 0;
+	uint32_t _seed;
+	static inline int _instance = 0;
+};
+
+class AudioSynthNoisePink : public AudioStream{
+public:
+	AudioSynthNoisePink() : AudioStream(0, NULL){}
+	void amplitude(float n){_level = constrain(n, 0.0f, 1.0f);}
+	virtual void update(void){
+		if(_level == 0) return;
+		audio_block_t *block = allocate();
+		if(!block) return;
+		for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+			_seed = _seed * 1103515245u + 12345u;
+			float w = ((int32_t)(_seed >> 16) - 32768) / 32768.0f;
+			b0 = 0.99765f * b0 + w * 0.0990460f;
+			b1 = 0.96300f * b1 + w * 0.2965164f;
+			b2 = 0.57000f * b2 + w * 1.0526913f;
+			float p = (b0 + b1 + b2 + w * 0.1848f) * 0.25f;
+			block->data[i] = shimSat16(p * 32767.0f * _level);
+		}
+		transmit(block);
+		release(block);
+	}
+private:
+	float _level = 0, b0 = 0, b1 = 0, b2 = 0;
+	uint32_t _seed = 0x1234567;
+};
+
+class AudioAmplifier : public AudioStream{
+public:
+	AudioAmplifier() : AudioStream(1, inputQueueArray){}
+	void gain(float n){_gain = n;}
+	virtual void update(void){
+		audio_block_t *block = receiveWritable(0);
+		if(!block) return;
+		if(_gain == 0){release(block); return;}
+		if(_gain != 1.0f){
+			for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i) block->data[i] = shimSat16(block->data[i] * _gain);
+		}
+		transmit(block);
+		release(block);
+	}
+private:
+	float _gain = 1.0f;
+	audio_block_t *inputQueueArray[1];
+};
+
+class AudioMixer4 : public AudioStream{
+public:
+	AudioMixer4() : AudioStream(4, inputQueueArray){for(int i = 0; i < 4; ++i) _gain[i] = 1.0f;}
+	void gain(unsigned int channel, float g){if(channel < 4) _gain[channel] = constrain(g, -32767.0f, 32767.0f);}
+	virtual void update(void){
+		float acc[AUDIO_BLOCK_SAMPLES];
+		bool any = false;
+		for(int c = 0; c < 4; ++c){
+			audio_block_t *in = receiveReadOnly(c);
+			if(!in) continue;
+			if(_gain[c] != 0){
+				if(!any){for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i) acc[i] = 0;}
+				any = true;
+				for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i) acc[i] += in->data[i] * _gain[c];
+			}
+			release(in);
+		}
+		if(!any) return;
+		audio_block_t *out = allocate();
+		if(!out) return;
+		for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i) out->data[i] = shimSat16(acc[i]);
+		transmit(out);
+		release(out);
+	}
+private:
+	float _gain[4];
+	audio_block_t *inputQueueArray[4];
+};
+
+// Fixed point, as the library does : the phases of the block first, with an exp2 approximation for the frequency
+// modulation, then one loop for the waveform. make benchmark compares the oscillator bank with three of them.
+class AudioSynthWaveformModulated : public AudioStream{
+public:
+	AudioSynthWaveformModulated() : AudioStream(2, inputQueueArray){}
+	void frequency(float freq){
+		float inc = freq * (4294967296.0f / AUDIO_SAMPLE_RATE_EXACT);
+		_inc = (inc > 0x7FFE0000u) ? 0x7FFE0000u : inc;
+	}
+	void amplitude(float n){
+		if(n < 0) n = 0;
+		if(n > 1.0f) n = 1.0f;
+		_magnitude = n * 65536.0f;
+	}
+	void offset(float n){_offset = n * 32767.0f;}
+	void begin(short t){_type = t;}
+	void begin(float amp, float freq, short t){amplitude(amp); frequency(freq); _type = t;}
+	void frequencyModulation(float octaves){
+		if(octaves > 12.0f) octaves = 12.0f;
+		if(octaves < 0.1f) octaves = 0.1f;
+		_modulation = octaves * 4096.0f;
+	}
+	void phaseModulation(float){}
+	virtual void update(void){
+		audio_block_t *mod = receiveReadOnly(0);
+		audio_block_t *shape = receiveReadOnly(1);
+		uint32_t phase[AUDIO_BLOCK_SAMPLES];
+		uint32_t ph = _phase;
+		for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+			phase[i] = ph;
+			if(mod){
+				// Octaves, 27 bits fraction.
+				int32_t n = mod->data[i] * _modulation;
+				int32_t whole = n >> 27;
+				n &= 0x7FFFFFF;
+				n = (n + 134217728) << 3;
+				n = multiplyRounded(n, n);
+				n = multiplyRounded(n, 715827883) << 3;
+				n = n + 715827882;
+				uint32_t scale = (uint32_t)n >> (14 - whole);
+				uint64_t step = (uint64_t)_inc * scale;
+				ph += ((step >> 32) < 0x7FFE) ? (uint32_t)(step >> 16) : 0x7FFE0000u;
+			} else {
+				ph += _inc;
+			}
+		}
+		_phase = ph;
+
+		audio_block_t *out = (_magnitude != 0) ? allocate() : NULL;
+		if(out){
+			int16_t *data = out->data;
+			int32_t magnitude15 = _magnitude >> 1;
+			if(magnitude15 > 32767) magnitude15 = 32767;
+			switch(_type){
+				case WAVEFORM_SINE:
+					for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+						uint32_t index = phase[i] >> 24;
+						int32_t scale = (phase[i] >> 8) & 0xFFFF;
+						int32_t value = AudioWaveformSine[index] * (0x10000 - scale) + AudioWaveformSine[index + 1] * scale;
+						data[i] = ((int64_t)value * _magnitude) >> 32;
+					}
+					break;
+				case WAVEFORM_SAWTOOTH:
+					for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+						data[i] = (_magnitude * (int16_t)(phase[i] >> 16)) >> 16;
+					}
+					break;
+				case WAVEFORM_SAWTOOTH_REVERSE:
+					for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+						data[i] = (_magnitude * (int16_t)(0xFFFF - (phase[i] >> 16))) >> 16;
+					}
+					break;
+				case WAVEFORM_SQUARE:
+					for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+						data[i] = (phase[i] & 0x80000000) ? -magnitude15 : magnitude15;
+					}
+					break;
+				case WAVEFORM_TRIANGLE:
+					for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+						uint32_t top = phase[i] >> 30;
+						int32_t value = ((top == 1) || (top == 2)) ? 0xFFFF - (int32_t)(phase[i] >> 15) : (int32_t)phase[i] >> 15;
+						data[i] = (value * _magnitude) >> 16;
+					}
+					break;
+				case WAVEFORM_PULSE:
+					for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+						uint32_t width = shape ? ((shape->data[i] + 0x8000) & 0xFFFF) << 16 : 0x80000000u;
+						data[i] = (phase[i] < width) ? magnitude15 : -magnitude15;
+					}
+					break;
+				default:
+					for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+						data[i] = 0;
+					}
+					break;
+			}
+			if(_offset){
+				for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+					data[i] = shimSat16((float)data[i] + _offset);
+				}
+			}
+			transmit(out);
+			release(out);
+		}
+		release(mod);
+		release(shape);
+	}
+private:
+	static int32_t multiplyRounded(int32_t a, int32_t b){
+		return ((int64_t)a * b + 0x80000000LL) >> 32;
+	}
+
+	uint32_t _inc = 0, _phase = 0;
+	int32_t _magnitude = 0, _modulation = 4096;
+	float _offset = 0;
+	short _type = WAVEFORM_SINE;
+	audio_block_t *inputQueueArray[2];
+};
+
+class AudioFilterStateVariable : public AudioStream{
+public:
+	AudioFilterStateVariable() : AudioStream(2, inputQueueArray){}
+	void frequency(float freq){_freq = freq;}
+	void resonance(float q){_q = constrain(q, 0.7f, 5.0f);}
+	void octaveControl(float n){_octaves = n;}
+	virtual void update(void){
+		audio_block_t *in = receiveReadOnly(0);
+		audio_block_t *ctrl = receiveReadOnly(1);
+		if(!in){release(ctrl); return;}
+		audio_block_t *lp = allocate(), *bp = allocate(), *hp = allocate();
+		if(lp && bp && hp){
+			float damp = 1.0f / _q;
+			for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+				float fc = _freq;
+				if(ctrl) fc *= exp2f(ctrl->data[i] / 32768.0f * _octaves);
+				float f = 2.0f * sinf(M_PI * fc / (2.0f * AUDIO_SAMPLE_RATE_EXACT));
+				if(f > 0.95f) f = 0.95f;
+				float x = in->data[i];
+				for(int k = 0; k < 2; ++k){
+					_low += f * _band;
+					_high = x - _low - damp * _band;
+					_band += f * _high;
+				}
+				lp->data[i] = shimSat16(_low);
+				bp->data[i] = shimSat16(_band);
+				hp->data[i] = shimSat16(_high);
+			}
+			transmit(lp, 0);
+			transmit(bp, 1);
+			transmit(hp, 2);
+		}
+		release(lp); release(bp); release(hp);
+		release(in);
+		release(ctrl);
+	}
+private:
+	float _freq = 1000, _q = 0.707f, _octaves = 1, _low = 0, _band = 0, _high = 0;
+	audio_block_t *inputQueueArray[2];
+};
+
+class AudioEffectBitcrusher : public AudioStream{
+public:
+	AudioEffectBitcrusher() : AudioStream(1, inputQueueArray){}
+	void bits(uint8_t b){_bits = constrain(b, (uint8_t)1, (uint8_t)16);}
+	void sampleRate(float hz){_step = (int)(AUDIO_SAMPLE_RATE_EXACT / hz + 0.5f); if(_step < 1) _step = 1;}
+	virtual void update(void){
+		audio_block_t *block = receiveWritable(0);
+		if(!block) return;
+		if(_bits < 16 || _step > 1){
+			int16_t mask = (int16_t)(0xFFFF << (16 - _bits));
+			for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+				if((_count++ % _step) == 0) _hold = block->data[i] & mask;
+				block->data[i] = _hold;
+			}
+		}
+		transmit(block);
+		release(block);
+	}
+private:
+	uint8_t _bits = 16;
+	int _step = 1;
+	uint32_t _count = 0;
+	int16_t _hold = 0;
+	audio_block_t *inputQueueArray[1];
+};
+
+class AudioAnalyzePeak : public AudioStream{
+public:
+	AudioAnalyzePeak() : AudioStream(1, inputQueueArray){}
+	bool available(){return _new;}
+	float read(){_new = false; float p = _peak / 32767.0f; _peak = 0; return p;}
+	virtual void update(void){
+		audio_block_t *in = receiveReadOnly(0);
+		if(!in) return;
+		for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i) _peak = std::max(_peak, std::abs((int)in->data[i]));
+		_new = true;
+		release(in);
+	}
+private:
+	int _peak = 0;
+	bool _new = false;
+	audio_block_t *inputQueueArray[1];
+};
+
+class AudioAnalyzePrint : public AudioStream{
+public:
+	AudioAnalyzePrint() : AudioStream(1, inputQueueArray){}
+	void length(uint32_t){}
+	void trigger(){}
+	virtual void update(void){release(receiveReadOnly(0));}
+private:
+	audio_block_t *inputQueueArray[1];
+};
+
+// Capture output : the host tools read the interleaved samples from here.
+class AudioOutputI2S : public AudioStream{
+public:
+	AudioOutputI2S() : AudioStream(2, inputQueueArray){}
+	virtual void update(void){
+		audio_block_t *l = receiveReadOnly(0);
+		audio_block_t *r = receiveReadOnly(1);
+		if(capture){
+			for(int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+				samples.push_back(l ? l->data[i] : 0);
+				samples.push_back(r ? r->data[i] : 0);
+			}
+		}
+		release(l);
+		release(r);
+	}
+	bool capture = false;
+	std::vector<int16_t> samples;
+private:
+	audio_block_t *inputQueueArray[2];
+};
+#endif
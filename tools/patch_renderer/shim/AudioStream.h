@@ -0,0 +1,94 @@
+// Minimoog - patch renderer
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Host stand-in for AudioStream : nodes are updated and pass blocks as in the audio library,
+// blocks are taken from the heap.
+
+#ifndef SHIM_AUDIOSTREAM_H
+#define SHIM_AUDIOSTREAM_H
+#include "Arduino.h"
+#ifndef AUDIO_BLOCK_SAMPLES
+#define AUDIO_BLOCK_SAMPLES 128
+#endif
+#ifndef AUDIO_SAMPLE_RATE_EXACT
+#define AUDIO_SAMPLE_RATE_EXACT 44100.0f
+#endif
+#define AUDIO_SAMPLE_RATE AUDIO_SAMPLE_RATE_EXACT
+
+typedef struct audio_block_struct{
+	uint8_t ref_count;
+	uint8_t reserved1;
+	uint16_t memory_pool_index;
+	int16_t data[AUDIO_BLOCK_SAMPLES];
+} audio_block_t;
+
+class AudioStream;
+class AudioConnection{
+public:
+	AudioConnection(AudioStream &source, AudioStream &destination);
+	AudioConnection(AudioStream &source, unsigned char sourceOutput, AudioStream &destination, unsigned char destinationInput);
+	AudioStream &src;
+	AudioStream &dst;
+	unsigned char src_index;
+	unsigned char dest_index;
+	AudioConnection *next_dest;
+};
+
+class AudioStream{
+public:
+	AudioStream(unsigned char ninput, audio_block_t **iqueue);
+	virtual ~AudioStream(){}
+	virtual void update(void) = 0;
+	static void update_all(void);
+	static void initialize_memory(unsigned int num);
+	float processorUsage(void){return cpu_usage;}
+	float processorUsageMax(void){return cpu_usage_max;}
+	void processorUsageMaxReset(void){cpu_usage_max = cpu_usage;}
+	static audio_block_t *allocate(void);
+	static void release(audio_block_t *block);
+	static uint16_t memory_used;
+	static uint16_t memory_used_max;
+	static float cpu_total;
+	static float cpu_total_max;
+	static AudioStream *first_update;
+	AudioStream *next_update;
+	float cpu_usage;
+	float cpu_usage_max;
+protected:
+	bool active;
+	unsigned char num_inputs;
+	void transmit(audio_block_t *block, unsigned char index = 0);
+	audio_block_t *receiveReadOnly(unsigned int index = 0);
+	audio_block_t *receiveWritable(unsigned int index = 0);
+	friend class AudioConnection;
+private:
+	AudioConnection *destination_list;
+	audio_block_t **inputQueue;
+};
+
+void AudioMemory(unsigned int num);
+inline void AudioNoInterrupts(){}
+inline void AudioInterrupts(){}
+inline float AudioProcessorUsage(){return AudioStream::cpu_total;}
+inline float AudioProcessorUsageMax(){return AudioStream::cpu_total_max;}
+inline void AudioProcessorUsageMaxReset(){AudioStream::cpu_total_max = AudioStream::cpu_total;}
+inline uint16_t AudioMemoryUsage(){return AudioStream::memory_used;}
+inline uint16_t AudioMemoryUsageMax(){return AudioStream::memory_used_max;}
+inline void AudioMemoryUsageMaxReset(){AudioStream::memory_used_max = AudioStream::memory_used;}
+#endif
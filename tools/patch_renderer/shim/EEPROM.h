@@ -0,0 +1,36 @@
+// Minimoog - patch renderer
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Host stand-in for the EEPROM : starts blank, as a new Teensy.
+
+#ifndef SHIM_EEPROM_H
+#define SHIM_EEPROM_H
+#include "Arduino.h"
+struct ShimEEPROM{
+	uint8_t mem[1080];
+	ShimEEPROM(){memset(mem, 0xFF, sizeof(mem));}
+	uint8_t read(int a){return mem[a];}
+	void write(int a, uint8_t v){mem[a] = v;}
+	void update(int a, uint8_t v){mem[a] = v;}
+	template<class T> T &get(int a, T &t){memcpy(&t, mem + a, sizeof(T)); return t;}
+	template<class T> const T &put(int a, const T &t){memcpy(mem + a, &t, sizeof(T)); return t;}
+	uint16_t length(){return sizeof(mem);}
+};
+extern ShimEEPROM EEPROM;
+#endif
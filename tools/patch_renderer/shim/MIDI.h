@@ -0,0 +1,117 @@
+// Minimoog - patch renderer
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Host stand-in for the MIDI library and usbMIDI : nothing is read or sent, the renderer calls the handlers itself.
+
+#ifndef SHIM_MIDI_H
+#define SHIM_MIDI_H
+#include "Arduino.h"
+typedef uint8_t byte;
+
+class HardwareSerial{
+public:
+	int available(){return 0;}
+	int read(){return -1;}
+	size_t write(uint8_t){return 1;}
+	void begin(long){}
+};
+extern HardwareSerial Serial1, Serial2, Serial3, Serial4;
+
+namespace midi{
+	struct DefaultSettings{
+		static const bool UseRunningStatus = false;
+		static const bool HandleNullVelocityNoteOnAsNoteOff = true;
+		static const bool Use1ByteParsing = true;
+		static const long BaudRate = 31250;
+		static const unsigned SysExMaxSize = 128;
+	};
+	template<class SerialPort, class Settings = DefaultSettings>
+	class MidiInterface{
+	public:
+		MidiInterface(SerialPort &port) : _port(port){}
+		void begin(int = 1){}
+		void turnThruOff(){}
+		bool read(){return false;}
+		bool read(int){return false;}
+		void sendNoteOn(int, int, int){}
+		void sendNoteOff(int, int, int){}
+		void sendControlChange(int, int, int){}
+		void sendPitchBend(int, int){}
+		void sendSysEx(unsigned, const byte *, bool = false){}
+		void sendRealTime(int){}
+		void setHandleNoteOn(void (*f)(byte, byte, byte)){noteOn = f;}
+		void setHandleNoteOff(void (*f)(byte, byte, byte)){noteOff = f;}
+		void setHandleControlChange(void (*f)(byte, byte, byte)){cc = f;}
+		void setHandlePitchBend(void (*f)(byte, int)){bend = f;}
+		void setHandleSystemExclusive(void (*f)(byte *, unsigned)){sysex = f;}
+		void setHandleClock(void (*f)()){clock = f;}
+		void setHandleStart(void (*f)()){start = f;}
+		void setHandleStop(void (*f)()){stop = f;}
+		void setHandleContinue(void (*f)()){cont = f;}
+		void (*noteOn)(byte, byte, byte) = nullptr;
+		void (*noteOff)(byte, byte, byte) = nullptr;
+		void (*cc)(byte, byte, byte) = nullptr;
+		void (*bend)(byte, int) = nullptr;
+		void (*sysex)(byte *, unsigned) = nullptr;
+		void (*clock)() = nullptr;
+		void (*start)() = nullptr;
+		void (*stop)() = nullptr;
+		void (*cont)() = nullptr;
+	private:
+		SerialPort &_port;
+	};
+}
+
+#define MIDI_CREATE_INSTANCE(Type, SerialPort, Name) midi::MidiInterface<Type> Name((Type&)SerialPort);
+#define MIDI_CREATE_DEFAULT_INSTANCE() MIDI_CREATE_INSTANCE(HardwareSerial, Serial1, MIDI);
+#define MIDI_CREATE_CUSTOM_INSTANCE(Type, SerialPort, Name, Settings) midi::MidiInterface<Type, Settings> Name((Type&)SerialPort);
+
+class usb_midi_class{
+public:
+	void begin(){}
+	bool read(){return false;}
+	bool read(uint8_t){return false;}
+	void sendNoteOn(uint8_t, uint8_t, uint8_t){}
+	void sendNoteOff(uint8_t, uint8_t, uint8_t){}
+	void sendControlChange(uint8_t, uint8_t, uint8_t){}
+	void sendPitchBend(int, uint8_t){}
+	void send_now(){}
+	uint8_t getType(){return 0;}
+	uint8_t getChannel(){return 0;}
+	uint8_t getData1(){return 0;}
+	uint8_t getData2(){return 0;}
+	void setHandleNoteOn(void (*f)(uint8_t, uint8_t, uint8_t)){noteOn = f;}
+	void setHandleNoteOff(void (*f)(uint8_t, uint8_t, uint8_t)){noteOff = f;}
+	void setHandleControlChange(void (*f)(uint8_t, uint8_t, uint8_t)){cc = f;}
+	void setHandlePitchChange(void (*f)(uint8_t, int)){bend = f;}
+	void setHandleClock(void (*f)()){clock = f;}
+	void setHandleStart(void (*f)()){start = f;}
+	void setHandleStop(void (*f)()){stop = f;}
+	void setHandleContinue(void (*f)()){cont = f;}
+	void (*noteOn)(uint8_t, uint8_t, uint8_t) = nullptr;
+	void (*noteOff)(uint8_t, uint8_t, uint8_t) = nullptr;
+	void (*cc)(uint8_t, uint8_t, uint8_t) = nullptr;
+	void (*bend)(uint8_t, int) = nullptr;
+	void (*clock)() = nullptr;
+	void (*start)() = nullptr;
+	void (*stop)() = nullptr;
+	void (*cont)() = nullptr;
+};
+extern usb_midi_class usbMIDI;
+#endif
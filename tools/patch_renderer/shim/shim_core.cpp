@@ -0,0 +1,157 @@
+// Minimoog - patch renderer
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// AudioStream, and the globals of the Arduino core and libraries.
+// Time runs with the audio : millis() and micros() count the samples rendered.
+
+#include "AudioStream.h"
+#include "EEPROM.h"
+#include <chrono>
+#include <vector>
+
+ShimSerial Serial;
+ShimEEPROM EEPROM;
+
+static uint64_t shimSamples = 0;
+uint32_t millis(){return shimSamples * 1000 / (uint64_t)AUDIO_SAMPLE_RATE_EXACT;}
+uint32_t shimMicros = 0;
+uint32_t micros(){return shimSamples * 1000000 / (uint64_t)AUDIO_SAMPLE_RATE_EXACT + shimMicros;}
+void delay(uint32_t){}
+
+AudioStream *AudioStream::first_update = NULL;
+uint16_t AudioStream::memory_used = 0;
+uint16_t AudioStream::memory_used_max = 0;
+float AudioStream::cpu_total = 0;
+float AudioStream::cpu_total_max = 0;
+static unsigned int memory_limit = 0;
+
+AudioStream::AudioStream(unsigned char ninput, audio_block_t **iqueue) :
+		num_inputs(ninput), inputQueue(iqueue){
+	active = false;
+	destination_list = NULL;
+	next_update = NULL;
+	cpu_usage = cpu_usage_max = 0;
+	for(int i = 0; i < num_inputs; i++) inputQueue[i] = NULL;
+	if(first_update == NULL){
+		first_update = this;
+	} else {
+		AudioStream *p = first_update;
+		while(p->next_update) p = p->next_update;
+		p->next_update = this;
+	}
+}
+
+void AudioMemory(unsigned int num){memory_limit = num;}
+
+audio_block_t *AudioStream::allocate(void){
+	if(memory_limit && memory_used >= memory_limit) return NULL;
+	audio_block_t *block = new audio_block_t;
+	block->ref_count = 1;
+	if(++memory_used > memory_used_max) memory_used_max = memory_used;
+	return block;
+}
+
+void AudioStream::release(audio_block_t *block){
+	if(!block) return;
+	if(block->ref_count > 1){
+		block->ref_count--;
+	} else {
+		delete block;
+		memory_used--;
+	}
+}
+
+void AudioStream::transmit(audio_block_t *block, unsigned char index){
+	for(AudioConnection *c = destination_list; c != NULL; c = c->next_dest){
+		if(c->src_index == index){
+			if(c->dst.inputQueue[c->dest_index] == NULL){
+				c->dst.inputQueue[c->dest_index] = block;
+				block->ref_count++;
+			}
+		}
+	}
+}
+
+audio_block_t *AudioStream::receiveReadOnly(unsigned int index){
+	if(index >= num_inputs) return NULL;
+	audio_block_t *in = inputQueue[index];
+	inputQueue[index] = NULL;
+	return in;
+}
+
+audio_block_t *AudioStream::receiveWritable(unsigned int index){
+	if(index >= num_inputs) return NULL;
+	audio_block_t *in = inputQueue[index];
+	inputQueue[index] = NULL;
+	if(in && in->ref_count > 1){
+		audio_block_t *p = allocate();
+		if(p) memcpy(p->data, in->data, sizeof(p->data));
+		in->ref_count--;
+		in = p;
+	}
+	return in;
+}
+
+AudioConnection::AudioConnection(AudioStream &source, AudioStream &destination) :
+		AudioConnection(source, 0, destination, 0){}
+
+AudioConnection::AudioConnection(AudioStream &source, unsigned char sourceOutput,
+		AudioStream &destination, unsigned char destinationInput) :
+		src(source), dst(destination), src_index(sourceOutput), dest_index(destinationInput){
+	next_dest = NULL;
+	if(src.destination_list == NULL){
+		src.destination_list = this;
+	} else {
+		AudioConnection *p = src.destination_list;
+		while(p->next_dest) p = p->next_dest;
+		p->next_dest = this;
+	}
+	src.active = true;
+	dst.active = true;
+}
+
+void AudioStream::update_all(void){
+	const double period = 1e9 * AUDIO_BLOCK_SAMPLES / AUDIO_SAMPLE_RATE_EXACT;
+	double total = 0;
+	for(AudioStream *p = first_update; p; p = p->next_update){
+		if(!p->active) continue;
+		auto t0 = std::chrono::steady_clock::now();
+		p->update();
+		auto t1 = std::chrono::steady_clock::now();
+		double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+		total += ns;
+		p->cpu_usage = 100.0 * ns / period;
+		if(p->cpu_usage > p->cpu_usage_max) p->cpu_usage_max = p->cpu_usage;
+	}
+	cpu_total = 100.0 * total / period;
+	if(cpu_total > cpu_total_max) cpu_total_max = cpu_total;
+	shimSamples += AUDIO_BLOCK_SAMPLES;
+}
+
+#include "Audio.h"
+extern "C" const int16_t AudioWaveformSine[257] = {
+#define S(i) (int16_t)(32767.0 * sin(2.0 * M_PI * (i) / 256.0))
+#define S8(i) S(i), S(i+1), S(i+2), S(i+3), S(i+4), S(i+5), S(i+6), S(i+7)
+#define S64(i) S8(i), S8(i+8), S8(i+16), S8(i+24), S8(i+32), S8(i+40), S8(i+48), S8(i+56)
+	S64(0), S64(64), S64(128), S64(192), 0
+};
+
+#include "MIDI.h"
+HardwareSerial Serial1, Serial2, Serial3, Serial4;
+usb_midi_class usbMIDI;
@@ -0,0 +1,192 @@
+// Minimoog - patch renderer
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Sample accurate level changes of the DC for key tracking.
+ *
+ * Levels are captured block after block, and each change is checked on the sample it's due at :
+ *	- a change at once, with an offset, keeps the former level before the offset and has the new one from it.
+ *	- a ramp with an offset starts moving on the offset sample, and reaches its target in the time given.
+ *	- a change without offset happens at the block start, and a new change replaces the one waiting.
+ *	- in the sketch, a sequencer note moves the pitch and filter key tracks on the sample its envelope starts.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "Audio.h"
+#include "effect_envelope_exp.h"
+#include "synth_dc_timed.h"
+
+// From the sketch.
+extern AudioSynthDcTimed dcKeyTrack;
+extern AudioSynthDcTimed dcFilterKeyTrack;
+extern AudioEffectEnvelopeExp filterEnvelope;
+void setup();
+void handleSequencerNoteOn(uint8_t note, uint8_t velocity, uint16_t offset);
+
+static uint32_t failures = 0;
+
+static void check(bool condition, const char *message){
+	if(condition) return;
+	++failures;
+	printf("FAIL : %s\n", message);
+}
+
+// A DC, and its output. Audio streams are never taken out of the graph : they all live until the end.
+struct Capture{
+	AudioSynthDcTimed dc;
+	AudioOutputI2S out;
+	AudioConnection cord;
+
+	Capture() : cord(dc, 0, out, 0){out.capture = true;}
+	int16_t at(size_t i){return out.samples[2 * i];}
+	size_t length(){return out.samples.size() / 2;}
+	void render(){
+		dc.update();
+		out.update();
+	}
+};
+
+static Capture capture;
+
+static int16_t toSample(float level){
+	return (int16_t)(level * 32767.0f);
+}
+
+// First sample from "start" that differs from the one before it, or -1.
+static int32_t firstChange(size_t start){
+	for(size_t i = start; i < capture.length(); ++i){
+		if(capture.at(i) != capture.at(i - 1)) return i - start;
+	}
+	return -1;
+}
+
+static void stepAt(uint16_t offset){
+	capture.dc.amplitude(0.25);
+	capture.render();
+	size_t start = capture.length();
+	capture.dc.amplitude(-0.5, 0, offset);
+	capture.render();
+
+	bool before = true;
+	bool after = true;
+	for(uint16_t i = 0; i < AUDIO_BLOCK_SAMPLES; ++i){
+		if(i < offset) before = before && (capture.at(start + i) == toSample(0.25));
+		if(i >= offset) after = after && (capture.at(start + i) == toSample(-0.5));
+	}
+	char message[80];
+	snprintf(message, sizeof(message), "step at %u : former level before the offset", offset);
+	check(before, message);
+	snprintf(message, sizeof(message), "step at %u : new level from the offset", offset);
+	check(after, message);
+}
+
+static void rampAt(uint16_t offset){
+	const float ms = 2.0;
+	uint32_t samples = lroundf(ms * AUDIO_SAMPLE_RATE_EXACT / 1000.0);
+	capture.dc.amplitude(0.0);
+	capture.render();
+	size_t start = capture.length();
+	capture.dc.amplitude(0.5, ms, offset);
+	for(uint32_t n = 0; n < samples / AUDIO_BLOCK_SAMPLES + 2; ++n){
+		capture.render();
+	}
+
+	char message[80];
+	snprintf(message, sizeof(message), "ramp at %u : starts on the offset", offset);
+	check(firstChange(start) == offset, message);
+	snprintf(message, sizeof(message), "ramp at %u : target reached in the time given", offset);
+	size_t end = start + offset + samples;
+	check((capture.at(end - 2) < toSample(0.5)) && (capture.at(end) == toSample(0.5)), message);
+}
+
+static void replaced(){
+	capture.dc.amplitude(0.0);
+	capture.render();
+	size_t start = capture.length();
+	capture.dc.amplitude(0.1, 0, AUDIO_BLOCK_SAMPLES / 2);
+	capture.dc.amplitude(0.2);
+	capture.render();
+	check((capture.at(start) == toSample(0.2)) && (capture.at(start + AUDIO_BLOCK_SAMPLES - 1) == toSample(0.2)),
+			"a change without offset happens at the block start and replaces the one waiting");
+}
+
+// The sequencer plays its notes from its update, the first of the graph, with their offset in the block.
+// The key tracks and the filter envelope are captured by "tracks" and "envelope", set after the sketch.
+static AudioOutputI2S *tracks;
+static AudioOutputI2S *envelope;
+
+static void sequencerNote(uint16_t offset){
+	// Settled on a first note : its envelope is on sustain after a second and a half.
+	handleSequencerNoteOn(36, 100, 0);
+	uint32_t blocks = 1.5 * AUDIO_SAMPLE_RATE_EXACT / AUDIO_BLOCK_SAMPLES;
+	for(uint32_t n = 0; n < blocks; ++n){
+		AudioStream::update_all();
+	}
+	size_t start = tracks->samples.size() / 2;
+	handleSequencerNoteOn(60, 100, offset);
+	AudioStream::update_all();
+
+	int32_t pitchChange = -1;
+	int32_t filterChange = -1;
+	int32_t envelopeChange = -1;
+	for(size_t i = start; i < start + AUDIO_BLOCK_SAMPLES; ++i){
+		if((pitchChange < 0) && (tracks->samples[2 * i] != tracks->samples[2 * i - 2])) pitchChange = i - start;
+		if((filterChange < 0) && (tracks->samples[2 * i + 1] != tracks->samples[2 * i - 1])) filterChange = i - start;
+		if((envelopeChange < 0) && (envelope->samples[2 * i] != envelope->samples[2 * i - 2])) envelopeChange = i - start;
+	}
+	char message[80];
+	snprintf(message, sizeof(message), "sequencer note at %u : pitch moves with the envelope", offset);
+	check((pitchChange == offset) && (envelopeChange == offset), message);
+	snprintf(message, sizeof(message), "sequencer note at %u : filter key track moves with the envelope", offset);
+	check(filterChange == offset, message);
+	printf("sequencer note at %3u : pitch from sample %d, filter from %d, envelope from %d\n",
+			offset, pitchChange, filterChange, envelopeChange);
+}
+
+int main(){
+	uint16_t offsets[] = {0, 1, AUDIO_BLOCK_SAMPLES / 2, AUDIO_BLOCK_SAMPLES - 1};
+	for(uint16_t offset : offsets){
+		stepAt(offset);
+		rampAt(offset);
+	}
+	replaced();
+
+	setup();
+	tracks = new AudioOutputI2S();
+	envelope = new AudioOutputI2S();
+	new AudioConnection(dcKeyTrack, 0, *tracks, 0);
+	new AudioConnection(dcFilterKeyTrack, 0, *tracks, 1);
+	new AudioConnection(filterEnvelope, 0, *envelope, 0);
+	tracks->capture = true;
+	envelope->capture = true;
+	for(uint16_t offset : offsets){
+		sequencerNote(offset);
+	}
+
+	if(failures){
+		printf("dc timed : %u failures\n", failures);
+		return 1;
+	}
+	printf("dc timed : ok\n");
+	return 0;
+}
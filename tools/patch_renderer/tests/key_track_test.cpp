@@ -0,0 +1,210 @@
+// Minimoog - patch renderer
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Randomized test of the key track, and of the note priority of the sketch, against a reference model.
+ *
+ * The key track is checked after every key pressed, pressed again or released : keys held, their order,
+ * their velocity, the lower and upper ones. The sketch is then played with random keys, repeated note ons
+ * included, in each priority mode : after every message, the note sounding must be the one with priority.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "Audio.h"
+#include "key_track.h"
+
+// From the sketch. The key modes are the sketch's.
+enum keyMode_t{
+	KEY_LOWER = 0,
+	KEY_FIRST,
+	KEY_LAST,
+	KEY_UPPER,
+};
+extern keyMode_t keyMode;
+extern int8_t nowPlaying;
+void setup();
+void handleNoteOn(uint8_t channel, uint8_t note, uint8_t velocity);
+void handleNoteOff(uint8_t channel, uint8_t note, uint8_t velocity);
+
+const char *MODE_NAMES[] = {"lower", "first", "last", "upper"};
+
+static uint32_t failures = 0;
+
+static void check(bool condition, const char *message){
+	if(condition) return;
+	++failures;
+	if(failures < 20) printf("FAIL : %s\n", message);
+}
+
+// Keys held, in the order they were pressed.
+struct Model{
+	std::vector<uint8_t> order;
+	uint8_t velocity[128];
+
+	bool held(uint8_t note){
+		return std::find(order.begin(), order.end(), note) != order.end();
+	}
+
+	void add(uint8_t note, uint8_t value, bool toEnd){
+		velocity[note] = value;
+		if(held(note)){
+			if(!toEnd) return;
+			remove(note);
+		}
+		order.push_back(note);
+	}
+
+	void remove(uint8_t note){
+		order.erase(std::remove(order.begin(), order.end(), note), order.end());
+	}
+
+	int8_t priority(keyMode_t mode){
+		if(order.empty()) return -1;
+		switch(mode){
+			case KEY_LOWER:
+				return *std::min_element(order.begin(), order.end());
+			case KEY_UPPER:
+				return *std::max_element(order.begin(), order.end());
+			case KEY_FIRST:
+				return order.front();
+			case KEY_LAST:
+			default:
+				return order.back();
+		}
+	}
+};
+
+// Random presses and releases, on a few keys so they are often pressed again, or on the whole range.
+static uint8_t randomKey(uint8_t range){
+	return (range < 128) ? 60 + rand() % range : rand() % 128;
+}
+
+static void keyTrackRandom(uint32_t seed, uint32_t steps, uint8_t range){
+	KeyTrack keys;
+	Model model;
+	srand(seed);
+
+	for(uint32_t n = 0; n < steps; ++n){
+		uint8_t note = randomKey(range);
+		uint32_t action = rand() % 100;
+		if(action < 50){
+			uint8_t velocity = 1 + rand() % 127;
+			bool toEnd = rand() & 1;
+			keys.add(note, velocity, toEnd);
+			model.add(note, velocity, toEnd);
+		} else if(action < 99){
+			bool wasHeld = keys.remove(note);
+			check(wasHeld == model.held(note), "remove tells if the key was held");
+			model.remove(note);
+		} else {
+			keys.clear();
+			model.order.clear();
+		}
+
+		check(keys.count() == model.order.size(), "count");
+		check(keys.lower() == model.priority(KEY_LOWER), "lower");
+		check(keys.upper() == model.priority(KEY_UPPER), "upper");
+		check(keys.first() == model.priority(KEY_FIRST), "first");
+		check(keys.last() == model.priority(KEY_LAST), "last");
+		check(keys.isHeld(note) == model.held(note), "held");
+		if(model.held(note)) check(keys.velocity(note) == model.velocity[note], "velocity");
+	}
+
+	// The whole order, walked from the first by removing it.
+	while(keys.count()){
+		check(keys.first() == model.order.front(), "order");
+		keys.remove(model.order.front());
+		model.order.erase(model.order.begin());
+	}
+	printf("key track, seed %u, %u steps on %u keys\n", seed, steps, range);
+}
+
+// Play the sketch : the note sounding must always be the one with priority among the keys held.
+static void priorityRandom(keyMode_t mode, uint32_t seed, uint32_t steps, uint8_t range){
+	Model model;
+	srand(seed);
+	keyMode = mode;
+
+	for(uint32_t n = 0; n < steps; ++n){
+		uint8_t note = randomKey(range);
+		if((rand() % 100) < 55){
+			uint8_t velocity = 1 + rand() % 127;
+			handleNoteOn(1, note, velocity);
+			model.add(note, velocity, mode != KEY_FIRST);
+		} else {
+			handleNoteOff(1, note, 0);
+			model.remove(note);
+		}
+		check(nowPlaying == model.priority(mode), "the note sounding has priority");
+	}
+
+	for(uint8_t note : std::vector<uint8_t>(model.order)){
+		handleNoteOff(1, note, 0);
+		model.remove(note);
+	}
+	check(nowPlaying == -1, "no note sounds when every key is released");
+	printf("note priority %s, seed %u, %u steps on %u keys\n", MODE_NAMES[mode], seed, steps, range);
+}
+
+// First note priority : hold 60, press 64, press 60 again, release 60. Only 64 is held, it must sound.
+static void repeatedNoteOn(){
+	keyMode = KEY_FIRST;
+	handleNoteOn(1, 60, 100);
+	handleNoteOn(1, 64, 100);
+	handleNoteOn(1, 60, 100);
+	check(nowPlaying == 60, "first note pressed again keeps sounding");
+	handleNoteOff(1, 60, 0);
+	check(nowPlaying == 64, "releasing the first note plays the one left");
+	handleNoteOff(1, 64, 0);
+	check(nowPlaying == -1, "releasing every key stops the note");
+
+	// Last note priority : pressing a held key again makes it the last.
+	keyMode = KEY_LAST;
+	handleNoteOn(1, 60, 100);
+	handleNoteOn(1, 64, 100);
+	handleNoteOn(1, 60, 100);
+	check(nowPlaying == 60, "last note : a key pressed again sounds");
+	handleNoteOff(1, 60, 0);
+	check(nowPlaying == 64, "last note : releasing it plays the one left");
+	handleNoteOff(1, 64, 0);
+	printf("repeated note on\n");
+}
+
+int main(){
+	keyTrackRandom(1, 200000, 8);
+	keyTrackRandom(2, 200000, 128);
+
+	setup();
+	repeatedNoteOn();
+	for(uint8_t mode = KEY_LOWER; mode <= KEY_UPPER; ++mode){
+		priorityRandom((keyMode_t)mode, mode + 1, 50000, 6);
+		priorityRandom((keyMode_t)mode, mode + 11, 50000, 128);
+	}
+
+	if(failures){
+		printf("key track : %u failures\n", failures);
+		return 1;
+	}
+	printf("key track : ok\n");
+	return 0;
+}
@@ -0,0 +1,284 @@
+// Minimoog - patch renderer
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Flood test of the MIDI receive queue.
+ *
+ * MIDI is pushed as the timer interrupt does, and dispatched as the main loop does, with random delays
+ * between dispatches. Events are checked against a reference model :
+ *	- notes, pitch bend and ordered control changes all come out, once, in the order they came in.
+ *	- each control change ends with the last value sent.
+ *	- the control changes sent before an ordered one are applied before it, with their value at that time.
+ *	- nothing is lost, even when 128 control changes are waiting when an ordered one comes.
+ *	- a 14 bits control sent while the controls are dispatched never has its new LSB applied with its former MSB.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "midi_queue.h"
+
+struct Event{
+	uint8_t type;
+	uint8_t data1;
+	int16_t data2;
+};
+
+static std::vector<Event> received;
+static uint32_t failures = 0;
+
+static void check(bool condition, const char *message){
+	if(condition) return;
+	++failures;
+	printf("FAIL : %s\n", message);
+}
+
+static void onNoteOn(uint8_t channel, uint8_t note, uint8_t velocity){
+	received.push_back({MIDI_EVENT_NOTE_ON, note, velocity});
+}
+
+static void onNoteOff(uint8_t channel, uint8_t note, uint8_t velocity){
+	received.push_back({MIDI_EVENT_NOTE_OFF, note, velocity});
+}
+
+static void onPitchBend(uint8_t channel, int16_t bend){
+	received.push_back({MIDI_EVENT_PITCH_BEND, 0, bend});
+}
+
+static void onControlChange(uint8_t channel, uint8_t command, uint8_t value){
+	received.push_back({MIDI_EVENT_CONTROL_CHANGE, command, value});
+}
+
+static void setHandles(MidiQueue *queue){
+	queue->setHandleNoteOn(onNoteOn);
+	queue->setHandleNoteOff(onNoteOff);
+	queue->setHandlePitchBend(onPitchBend);
+	queue->setHandleControlChange(onControlChange);
+}
+
+static void dispatch(MidiQueue *queue){
+	queue->dispatchEvents();
+	queue->dispatchControls();
+}
+
+// Ordered control changes are told from the others by their number.
+static bool isOrdered(uint8_t command){
+	return command >= 120;
+}
+
+// Random traffic : a keyboard, a pitch bend wheel, knobs turned fast, and a few actions.
+// The main loop is sometimes late, for up to "stall" messages. Each message takes at most one place in the ring,
+// so up to MIDI_QUEUE_SIZE - 1 - MIDI_QUEUE_RESERVE messages, every waiting control fits before an action.
+static void randomFlood(uint32_t seed, uint32_t messages, uint32_t stall){
+	MidiQueue *queue = new MidiQueue();
+	setHandles(queue);
+	received.clear();
+	srand(seed);
+
+	std::vector<Event> ordered;
+	int16_t lastValue[128];
+	// Value of each control when each ordered control change was sent.
+	std::vector<std::vector<int16_t>> before;
+	for(uint8_t i = 0; i < 128; ++i){
+		lastValue[i] = -1;
+	}
+
+	uint32_t nextDispatch = rand() % stall;
+	for(uint32_t n = 0; n < messages; ++n){
+		uint32_t kind = rand() % 100;
+		if(kind < 30){
+			uint8_t note = rand() % 128;
+			if(rand() & 1){
+				queue->noteOn(1, note, 1 + rand() % 127);
+				ordered.push_back({MIDI_EVENT_NOTE_ON, note, 0});
+			} else {
+				queue->noteOff(1, note, 0);
+				ordered.push_back({MIDI_EVENT_NOTE_OFF, note, 0});
+			}
+		} else if(kind < 35){
+			int16_t bend = rand() % 16384 - 8192;
+			queue->pitchBend(1, bend);
+			ordered.push_back({MIDI_EVENT_PITCH_BEND, 0, bend});
+		} else if(kind < 38){
+			uint8_t command = 120 + rand() % 8;
+			uint8_t value = rand() % 128;
+			queue->controlChange(1, command, value, 1);
+			ordered.push_back({MIDI_EVENT_CONTROL_CHANGE, command, value});
+			before.push_back(std::vector<int16_t>(lastValue, lastValue + 128));
+		} else {
+			uint8_t command = rand() % 120;
+			uint8_t value = rand() % 128;
+			queue->controlChange(1, command, value);
+			lastValue[command] = value;
+		}
+
+		if(n == nextDispatch){
+			dispatch(queue);
+			nextDispatch = n + 1 + rand() % stall;
+		}
+	}
+	dispatch(queue);
+
+	// Ordered events, in order.
+	std::vector<Event> out;
+	for(const Event &event : received){
+		if((event.type != MIDI_EVENT_CONTROL_CHANGE) || isOrdered(event.data1)) out.push_back(event);
+	}
+	bool same = out.size() == ordered.size();
+	for(uint32_t i = 0; same && (i < out.size()); ++i){
+		same = (out[i].type == ordered[i].type) && (out[i].data1 == ordered[i].data1);
+		if(ordered[i].type != MIDI_EVENT_NOTE_ON) same = same && (out[i].data2 == ordered[i].data2);
+	}
+	check(same, "ordered events come out once, in order");
+
+	// Controls applied before each ordered one.
+	int16_t applied[128];
+	for(uint8_t i = 0; i < 128; ++i){
+		applied[i] = -1;
+	}
+	uint32_t action = 0;
+	bool inOrder = true;
+	for(const Event &event : received){
+		if(event.type != MIDI_EVENT_CONTROL_CHANGE) continue;
+		if(!isOrdered(event.data1)){
+			applied[event.data1] = event.data2;
+			continue;
+		}
+		for(uint8_t i = 0; (i < 120) && (action < before.size()); ++i){
+			if(applied[i] != before[action][i]) inOrder = false;
+		}
+		++action;
+	}
+	check(inOrder, "controls sent before an action are applied before it");
+
+	bool last = true;
+	for(uint8_t i = 0; i < 120; ++i){
+		if(applied[i] != lastValue[i]) last = false;
+	}
+	check(last, "each control ends with its last value");
+	check(queue->overflows() == 0, "no event lost");
+
+	printf("random flood, seed %u, dispatch every %u messages at most : %zu events in, %zu out, %u lost\n",
+			seed, stall, ordered.size(), received.size(), queue->overflows());
+	delete queue;
+}
+
+// Worst case : every control is waiting when an action comes, twice, and the main loop is stalled.
+static void fullFlood(){
+	MidiQueue *queue = new MidiQueue();
+	setHandles(queue);
+	received.clear();
+
+	for(uint8_t i = 0; i < 120; ++i){
+		queue->controlChange(1, i, 1);
+	}
+	queue->controlChange(1, 120, 1, 1);
+	for(uint8_t i = 0; i < 120; ++i){
+		queue->controlChange(1, i, 2);
+	}
+	queue->controlChange(1, 121, 1, 1);
+	uint16_t notes = MIDI_QUEUE_SIZE - 1 - 120 - 2;
+	for(uint16_t i = 0; i < notes; ++i){
+		if(i & 1){
+			queue->noteOff(1, i & 0x7F, 0);
+		} else {
+			queue->noteOn(1, i & 0x7F, 100);
+		}
+	}
+	dispatch(queue);
+
+	uint16_t noteEvents = 0;
+	int16_t applied[120];
+	for(const Event &event : received){
+		if(event.type == MIDI_EVENT_NOTE_ON || event.type == MIDI_EVENT_NOTE_OFF) ++noteEvents;
+		if((event.type == MIDI_EVENT_CONTROL_CHANGE) && (event.data1 < 120)) applied[event.data1] = event.data2;
+	}
+	bool last = true;
+	for(uint8_t i = 0; i < 120; ++i){
+		if(applied[i] != 2) last = false;
+	}
+	check(noteEvents == notes, "every note is kept behind a full flush");
+	check(last, "controls that don't fit are applied after");
+	check(queue->overflows() == 0, "no event lost in the worst case");
+
+	printf("full flood : %u notes in, %u out, %u lost\n", notes, noteEvents, queue->overflows());
+	delete queue;
+}
+
+// 14 bits controls, applied on their LSB with the last MSB received, as handleControlChange does.
+// The timer interrupt is modeled by a control sent from the handler, when a control below 32 is applied.
+static MidiQueue *interrupted;
+static uint8_t msb[32];
+static std::vector<uint16_t> applied14;
+static bool interruptDue;
+
+static void onControlChange14(uint8_t channel, uint8_t command, uint8_t value){
+	if(command < 32){
+		msb[command] = value;
+		if(interruptDue){
+			interruptDue = false;
+			interrupted->controlChange(1, 7, 20);
+			interrupted->controlChange(1, 7 + 32, 6);
+		}
+	} else if(command < 64){
+		applied14.push_back(((uint16_t)msb[command - 32] << 7) | value);
+	}
+}
+
+// Control 7 is at 10:5, control 1 is turned, and control 7 is sent again at 20:6 while control 1 is applied.
+static void interruptedDispatch(){
+	interrupted = new MidiQueue();
+	interrupted->setHandleControlChange(onControlChange14);
+	applied14.clear();
+
+	interrupted->controlChange(1, 7, 10);
+	interrupted->controlChange(1, 7 + 32, 5);
+	interrupted->dispatchControls();
+	interrupted->controlChange(1, 1, 64);
+	interruptDue = true;
+	interrupted->dispatchControls();
+	interrupted->dispatchControls();
+
+	bool stale = false;
+	for(uint16_t value : applied14){
+		if(value == ((10 << 7) | 6)) stale = true;
+	}
+	check(!stale, "a 14 bits control sent during a dispatch is never applied with its former MSB");
+	check(!applied14.empty() && (applied14.back() == ((20 << 7) | 6)), "a 14 bits control sent during a dispatch ends with its last value");
+
+	printf("interrupted dispatch : %zu values applied, last %u:%u\n", applied14.size(),
+			applied14.empty() ? 0 : applied14.back() >> 7, applied14.empty() ? 0 : applied14.back() & 0x7F);
+	delete interrupted;
+}
+
+int main(){
+	randomFlood(1, 100000, 4);
+	randomFlood(2, 100000, 64);
+	randomFlood(3, 100000, 150);
+	fullFlood();
+	interruptedDispatch();
+
+	if(failures){
+		printf("midi queue : %u failures\n", failures);
+		return 1;
+	}
+	printf("midi queue : ok\n");
+	return 0;
+}
@@ -0,0 +1,248 @@
+// Minimoog - patch renderer
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Discontinuity energy of the oscillator range and waveform switches.
+ *
+ * A click is a jump of the waveform, or of its slope : it shows as a peak of the second difference of the output.
+ * The discontinuity energy of a switch is the energy of the second difference that goes over what the steady
+ * waveforms have, around the switch. Each switch is compared with the same switch done at once :
+ *	- range, on a sine : range() waits for a turn of the waveform, frequency() changes at once.
+ *	- waveform and wavetable : the switch is crossfaded, the one at once is spliced from two oscillators that
+ *	  play each waveform, in phase with the one tested.
+ *	- two or three waveform changes within one crossfade, when the audio blocks are shorter than it : each
+ *	  goes on from the mix playing.
+ * Switches happen at block starts, on random phases. The crossfaded switches must have less than 1% of the energy
+ * of the switches done at once.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "Audio.h"
+#include "synth_oscillator.h"
+
+// An oscillator bank, and the output of its first oscillator.
+struct Capture{
+	AudioSynthOscillatorBank bank;
+	AudioOutputI2S out;
+	AudioConnection cord;
+
+	Capture() : cord(bank, 0, out, 0){out.capture = true;}
+	int32_t at(size_t i){return out.samples[2 * i];}
+	size_t length(){return out.samples.size() / 2;}
+};
+
+// The oscillator tested, and two references.
+static Capture tested, referenceA, referenceB;
+static uint32_t failures = 0;
+
+// Quantization of the output : the second difference of a steady waveform can go this much over its peak.
+static const double QUANTIZATION = 2.0;
+static const float AMPLITUDE = 0.8;
+
+static void check(bool condition, const char *message){
+	if(condition) return;
+	++failures;
+	printf("FAIL : %s\n", message);
+}
+
+static void render(uint32_t samples){
+	uint32_t blocks = (samples + AUDIO_BLOCK_SAMPLES - 1) / AUDIO_BLOCK_SAMPLES;
+	for(uint32_t i = 0; i < blocks; ++i){
+		Capture *captures[] = {&tested, &referenceA, &referenceB};
+		for(Capture *capture : captures){
+			capture->bank.update();
+			capture->out.update();
+		}
+	}
+}
+
+static double secondDifference(const std::vector<int32_t> &signal, size_t i){
+	return signal[i] - 2.0 * signal[i - 1] + signal[i - 2];
+}
+
+static std::vector<int32_t> samples(Capture &capture){
+	std::vector<int32_t> signal(capture.length());
+	for(size_t i = 0; i < signal.size(); ++i){
+		signal[i] = capture.at(i);
+	}
+	return signal;
+}
+
+// Energy of the second difference over the bound, from "first" to "last" (excluded).
+static double excessEnergy(const std::vector<int32_t> &signal, const std::vector<double> &bound, size_t first, size_t last){
+	double energy = 0;
+	for(size_t i = first; i < last; ++i){
+		double excess = fabs(secondDifference(signal, i)) - bound[i];
+		if(excess > 0) energy += excess * excess;
+	}
+	return energy;
+}
+
+// Largest second difference of a steady waveform, from "first" to "last" (excluded).
+static double steadyPeak(const std::vector<int32_t> &signal, size_t first, size_t last){
+	double peak = 0;
+	for(size_t i = first; i < last; ++i){
+		peak = std::max(peak, fabs(secondDifference(signal, i)));
+	}
+	return peak;
+}
+
+struct Result{
+	double faded;
+	double atOnce;
+	uint16_t events;
+};
+
+static void report(const char *name, Result result){
+	double faded = sqrt(result.faded / result.events);
+	double atOnce = sqrt(result.atOnce / result.events);
+	printf("%-44s : energy per switch %12.0f, at once %12.0f, %+6.1fdB\n", name, result.faded / result.events,
+			result.atOnce / result.events, 20.0 * log10(std::max(faded, 1.0) / std::max(atOnce, 1.0)));
+	char message[100];
+	snprintf(message, sizeof(message), "%s : under 1%% of the energy of a switch at once", name);
+	check(result.faded < 0.01 * result.atOnce, message);
+}
+
+// Range switches on a sine, between two ranges.
+static Result rangeSwitches(uint16_t events){
+	const uint32_t steady = 2048;
+	const uint32_t window = OSC_RANGE_TIMEOUT + 2 * AUDIO_BLOCK_SAMPLES;
+	Result result = {0, 0, events};
+
+	tested.bank.rangeBase(440.0);
+	tested.bank.range(0, 2);
+	tested.bank.begin(0, AMPLITUDE, 110.0, WAVEFORM_SINE);
+	referenceA.bank.begin(0, AMPLITUDE, 110.0, WAVEFORM_SINE);
+	for(uint16_t e = 0; e < events; ++e){
+		render(steady + (rand() % 8) * AUDIO_BLOCK_SAMPLES);
+		size_t start = tested.length();
+		uint8_t range = (e & 1) ? 2 : 3;
+		tested.bank.range(0, range);
+		referenceA.bank.frequency(0, 440.0 / (1 << range));
+		render(window + steady);
+
+		Capture *captures[] = {&tested, &referenceA};
+		double energy[2];
+		for(uint8_t c = 0; c < 2; ++c){
+			std::vector<int32_t> signal = samples(*captures[c]);
+			size_t end = start + window;
+			double peak = std::max(steadyPeak(signal, start - steady, start), steadyPeak(signal, end, end + steady));
+			std::vector<double> bound(signal.size(), peak + QUANTIZATION);
+			energy[c] = excessEnergy(signal, bound, start, end);
+		}
+		result.faded += energy[0];
+		result.atOnce += energy[1];
+	}
+	return result;
+}
+
+struct Waveform{
+	short shape;
+	uint8_t table;
+};
+
+static void setWaveform(Capture &capture, Waveform waveform){
+	capture.bank.wavetable(0, waveform.table);
+	capture.bank.begin(0, waveform.shape);
+}
+
+// Waveform switches between two waveforms, both ways. With more than one switch, they go back and forth,
+// a block apart.
+static Result waveformSwitches(Waveform a, Waveform b, uint8_t switches, uint16_t events){
+	const uint32_t gap = AUDIO_BLOCK_SAMPLES;
+	const uint32_t window = (switches - 1) * gap + OSC_CROSSFADE_SAMPLES + 8;
+	Result result = {0, 0, events};
+	Waveform waveforms[2] = {a, b};
+	Capture *references[2] = {&referenceA, &referenceB};
+
+	// Same frequency, and updated together since they were built : the three are in phase.
+	Capture *captures[] = {&tested, &referenceA, &referenceB};
+	for(Capture *capture : captures){
+		capture->bank.begin(0, AMPLITUDE, 97.0, a.shape);
+	}
+	setWaveform(referenceA, a);
+	setWaveform(referenceB, b);
+
+	for(uint16_t e = 0; e < events; ++e){
+		uint8_t first = e & 1;
+		setWaveform(tested, waveforms[first]);
+		render(2 * OSC_CROSSFADE_SAMPLES + AUDIO_BLOCK_SAMPLES * (rand() % 8));
+
+		size_t start = tested.length();
+		for(uint8_t i = 0; i < switches; ++i){
+			if(i) render(gap);
+			setWaveform(tested, waveforms[first ^ ((i & 1) ? 0 : 1)]);
+		}
+		render(2 * OSC_CROSSFADE_SAMPLES);
+
+		std::vector<int32_t> signal = samples(tested);
+		std::vector<int32_t> signals[2] = {samples(referenceA), samples(referenceB)};
+		// The outputs are one sample late : each waveform starts on the sample after the block start.
+		std::vector<int32_t> atOnce = signals[first];
+		for(size_t i = start + 1; i < atOnce.size(); ++i){
+			size_t segment = std::min((i - start - 1) / gap, (size_t)switches - 1);
+			atOnce[i] = signals[first ^ ((segment & 1) ? 0 : 1)][i];
+		}
+		std::vector<double> bound(signal.size());
+		for(size_t i = start; i < start + window; ++i){
+			bound[i] = std::max(fabs(secondDifference(signals[0], i)), fabs(secondDifference(signals[1], i))) + QUANTIZATION;
+		}
+		result.faded += excessEnergy(signal, bound, start, start + window);
+		result.atOnce += excessEnergy(atOnce, bound, start, start + window);
+	}
+	return result;
+}
+
+int main(){
+	srand(1);
+
+	const Waveform sine = {WAVEFORM_SINE, 0};
+	const Waveform triangle = {WAVEFORM_TRIANGLE, 0};
+	report("waveform, sine to triangle", waveformSwitches(sine, triangle, 1, 40));
+	report("waveform, sine to wavetable", waveformSwitches(sine, {WAVEFORM_WAVETABLE, 3}, 1, 40));
+	report("wavetable, table 0 to table 5", waveformSwitches({WAVEFORM_WAVETABLE, 0}, {WAVEFORM_WAVETABLE, 5}, 1, 40));
+
+	// More changes can only come within a crossfade when the blocks are shorter than it.
+	if(AUDIO_BLOCK_SAMPLES < OSC_CROSSFADE_SAMPLES){
+		char name[60];
+		for(uint8_t switches = 2; switches <= 3; ++switches){
+			snprintf(name, sizeof(name), "waveform, sine to triangle, %d switches", switches);
+			report(name, waveformSwitches(sine, triangle, switches, 40));
+			snprintf(name, sizeof(name), "wavetable, table 0 to 5, %d switches", switches);
+			report(name, waveformSwitches({WAVEFORM_WAVETABLE, 0}, {WAVEFORM_WAVETABLE, 5}, switches, 40));
+		}
+	} else {
+		printf("waveform changes within a crossfade : not possible with %d samples blocks\n", AUDIO_BLOCK_SAMPLES);
+	}
+
+	// Last : the range changes put the oscillators out of phase.
+	report("range, sine", rangeSwitches(40));
+
+	if(failures){
+		printf("oscillator : %u failures\n", failures);
+		return 1;
+	}
+	printf("oscillator : ok\n");
+	return 0;
+}
@@ -0,0 +1,205 @@
+// Minimoog - patch renderer
+/*
+ * This program is part of a minimoog-like synthesizer based on teensy 4.0
+ * Copyright (C) 2020  Pierre-Loup Martin
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Note onset jitter of the sequencer.
+ *
+ * The sequencer is updated block after block, as the audio library does, with micros() following the blocks.
+ * Between two updates, MIDI clock ticks are sent to clock() at the time they come, on a steady grid moved by
+ * a random jitter, as USB frames and MIDI polling do. The onset of each step, that is the block it's played in
+ * and its offset, is compared to the ideal grid :
+ *	- on the internal clock, each onset is within a sample of the grid.
+ *	- on MIDI clock, once locked, the onsets spread less than the ticks they come from, and never by more than
+ *	  the largest tick jitter.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "synth_sequencer.h"
+
+static AudioSynthSequencer sequencer;
+static std::vector<double> onsets;
+static double blockStart = 0;
+static uint32_t failures = 0;
+
+static void check(bool condition, const char *message){
+	if(condition) return;
+	++failures;
+	printf("FAIL : %s\n", message);
+}
+
+static void onNoteOn(uint8_t note, uint8_t velocity, uint16_t offset){
+	onsets.push_back(blockStart + offset);
+}
+
+static void onNoteOff(uint16_t offset){
+}
+
+static uint32_t toMicros(double samples){
+	return lround(samples * 1000000.0 / AUDIO_SAMPLE_RATE_EXACT);
+}
+
+static double toMs(double samples){
+	return samples * 1000.0 / AUDIO_SAMPLE_RATE_EXACT;
+}
+
+// Uniform, from -1 to 1.
+static double randomUnit(){
+	return 2.0 * rand() / RAND_MAX - 1.0;
+}
+
+// The sequencer plays one key held, from its next update.
+static void reset(bool external){
+	onsets.clear();
+	sequencer.mode(SEQUENCER_ARP_UP);
+	sequencer.division(4);
+	sequencer.gate(0.5);
+	sequencer.externalClock(external);
+	sequencer.allNotesOff();
+	sequencer.noteOn(60, 100);
+}
+
+// Runs the sequencer until the time given, in samples. Ticks due before the next update are sent first.
+static void run(double end, const std::vector<double> &ticks){
+	size_t tick = 0;
+	while(blockStart < end){
+		shimMicros = toMicros(blockStart);
+		sequencer.update();
+		double next = blockStart + AUDIO_BLOCK_SAMPLES;
+		while((tick < ticks.size()) && (ticks[tick] < next)){
+			shimMicros = toMicros(ticks[tick++]);
+			sequencer.clock();
+		}
+		blockStart = next;
+	}
+}
+
+// Mean, standard deviation and largest distance to the mean of the onset errors, from "first" on.
+struct Spread{
+	double mean;
+	double sd;
+	double max;
+};
+
+static Spread spread(const std::vector<double> &errors, size_t first){
+	Spread result = {0, 0, 0};
+	size_t count = errors.size() - first;
+	for(size_t i = first; i < errors.size(); ++i){
+		result.mean += errors[i];
+	}
+	result.mean /= count;
+	for(size_t i = first; i < errors.size(); ++i){
+		double distance = errors[i] - result.mean;
+		result.sd += distance * distance;
+		if(fabs(distance) > result.max) result.max = fabs(distance);
+	}
+	result.sd = sqrt(result.sd / count);
+	return result;
+}
+
+static void internalClock(float bpm){
+	reset(false);
+	sequencer.tempo(bpm);
+	double step = AUDIO_SAMPLE_RATE_EXACT * 60.0 / (bpm * 4);
+	double origin = blockStart;
+	run(origin + 400 * step, std::vector<double>());
+
+	double worst = 0;
+	for(size_t i = 0; i < onsets.size(); ++i){
+		double error = fabs(onsets[i] - (origin + i * step));
+		if(error > worst) worst = error;
+	}
+	// Offsets are whole samples, the time of the step cut down : an onset is up to one sample early.
+	char message[80];
+	snprintf(message, sizeof(message), "internal clock at %.0f bpm : onsets on the grid", bpm);
+	check((onsets.size() >= 400) && (worst < 1.001), message);
+	printf("internal clock, %3.0f bpm : %zu steps, largest error %.2f samples\n", bpm, onsets.size(), worst);
+}
+
+// Ticks at "bpm", each moved by up to "jitter" milliseconds either way.
+static void midiClock(float bpm, double jitter, uint32_t seed){
+	srand(seed);
+	reset(true);
+	sequencer.start();
+
+	const uint16_t steps = 400;
+	const uint8_t ticksPerStep = SEQUENCER_CLOCK_PPQN / 4;
+	double period = AUDIO_SAMPLE_RATE_EXACT * 60.0 / (bpm * SEQUENCER_CLOCK_PPQN);
+	double jitterSamples = jitter * AUDIO_SAMPLE_RATE_EXACT / 1000.0;
+	// The first tick is anywhere in a block.
+	double origin = blockStart + AUDIO_BLOCK_SAMPLES * (1.5 + 0.5 * randomUnit());
+	std::vector<double> ticks;
+	for(uint32_t i = 0; i < (uint32_t)steps * ticksPerStep; ++i){
+		ticks.push_back(origin + i * period + jitterSamples * randomUnit());
+	}
+	run(ticks.back() + period, ticks);
+
+	// Onset error against the ideal grid, and the jitter the ticks of the steps had.
+	std::vector<double> errors;
+	std::vector<double> tickErrors;
+	for(size_t i = 0; (i < onsets.size()) && (i < steps); ++i){
+		errors.push_back(onsets[i] - (origin + i * ticksPerStep * period));
+		tickErrors.push_back(ticks[i * ticksPerStep] - (origin + i * ticksPerStep * period));
+	}
+	// Four beats to lock.
+	const size_t settle = 16;
+	check(errors.size() > settle, "midi clock : steps are played");
+	if(errors.size() <= settle) return;
+	Spread onset = spread(errors, settle);
+	Spread tick = spread(tickErrors, settle);
+
+	char message[80];
+	snprintf(message, sizeof(message), "midi clock at %.0f bpm, jitter %.1fms : steps on every step tick", bpm, jitter);
+	check(onsets.size() >= steps, message);
+	if(jitter > 0){
+		snprintf(message, sizeof(message), "midi clock at %.0f bpm, jitter %.1fms : onsets spread less than ticks", bpm, jitter);
+		check(onset.sd < 0.5 * tick.sd, message);
+	}
+	snprintf(message, sizeof(message), "midi clock at %.0f bpm, jitter %.1fms : onsets within the jitter", bpm, jitter);
+	check(onset.max < jitterSamples + 1.0, message);
+	snprintf(message, sizeof(message), "midi clock at %.0f bpm, jitter %.1fms : onsets not late", bpm, jitter);
+	check(fabs(onset.mean) < 0.5 * AUDIO_BLOCK_SAMPLES, message);
+
+	printf("midi clock, %3.0f bpm, jitter +/-%.1fms : ticks sd %.3fms, onsets mean %+.3fms, sd %.3fms, largest %.3fms\n",
+			bpm, jitter, toMs(tick.sd), toMs(onset.mean), toMs(onset.sd), toMs(onset.max));
+}
+
+int main(){
+	sequencer.setHandleNoteOn(onNoteOn);
+	sequencer.setHandleNoteOff(onNoteOff);
+
+	internalClock(120);
+	internalClock(97);
+	midiClock(120, 0.0, 1);
+	midiClock(120, 0.5, 2);
+	midiClock(120, 1.0, 3);
+	midiClock(120, 2.0, 4);
+	midiClock(200, 1.0, 5);
+	midiClock(60, 1.0, 6);
+
+	if(failures){
+		printf("sequencer : %u failures\n", failures);
+		return 1;
+	}
+	printf("sequencer : ok\n");
+	return 0;
+}